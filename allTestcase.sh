@@ -6,6 +6,7 @@ mkdir testcase_result/hw5_after_demo/
 mkdir testcase_result/KHLtest/
 mkdir testcase_result/codeGen2/
 mkdir testcase_result/hw6_codeGenTA/
+mkdir testcase_result/optimize/
 
 # folder hw5_codeGenTA
 ./parser testcase/hw5_codeGenTA/assign.c
@@ -107,3 +108,112 @@ mv output.s testcase_result/hw6_codeGenTA/implicit.s
 ./parser testcase/hw6_codeGenTA/short.c
 rm -f short.s
 mv output.s testcase_result/hw6_codeGenTA/short.s
+
+# folder optimize
+./parser testcase/optimize/constPool.c
+rm -f constPool.s
+mv output.s testcase_result/optimize/constPool.s
+
+./parser testcase/optimize/constString.c
+rm -f constString.s
+mv output.s testcase_result/optimize/constString.s
+
+./parser testcase/optimize/writeMerge.c
+rm -f writeMerge.s
+mv output.s testcase_result/optimize/writeMerge.s
+
+./parser testcase/optimize/bufferedIO.c
+rm -f bufferedIO.s
+mv output.s testcase_result/optimize/bufferedIO.s
+
+./parser testcase/optimize/deadStore.c
+rm -f deadStore.s
+mv output.s testcase_result/optimize/deadStore.s
+
+./parser testcase/optimize/globalCache.c
+rm -f globalCache.s
+mv output.s testcase_result/optimize/globalCache.s
+
+./parser testcase/optimize/valueNumbering.c
+rm -f valueNumbering.s
+mv output.s testcase_result/optimize/valueNumbering.s
+
+./parser testcase/optimize/arrayAlias.c
+rm -f arrayAlias.s
+mv output.s testcase_result/optimize/arrayAlias.s
+
+./parser testcase/optimize/unroll.c
+rm -f unroll.s
+mv output.s testcase_result/optimize/unroll.s
+
+./parser testcase/optimize/loopNest.c
+rm -f loopNest.s
+mv output.s testcase_result/optimize/loopNest.s
+
+./parser testcase/optimize/idiom.c
+rm -f idiom.s
+mv output.s testcase_result/optimize/idiom.s
+
+./parser testcase/optimize/fusion.c
+rm -f fusion.s
+mv output.s testcase_result/optimize/fusion.s
+
+./parser testcase/optimize/unswitch.c
+rm -f unswitch.s
+mv output.s testcase_result/optimize/unswitch.s
+
+./parser testcase/optimize/strength.c
+rm -f strength.s
+mv output.s testcase_result/optimize/strength.s
+
+./parser testcase/optimize/immediate.c
+rm -f immediate.s
+mv output.s testcase_result/optimize/immediate.s
+
+./parser testcase/optimize/fcompare.c
+rm -f fcompare.s
+mv output.s testcase_result/optimize/fcompare.s
+
+./parser testcase/optimize/regneed.c
+rm -f regneed.s
+mv output.s testcase_result/optimize/regneed.s
+
+./parser testcase/optimize/logicvalue.c
+rm -f logicvalue.s
+mv output.s testcase_result/optimize/logicvalue.s
+
+./parser testcase/optimize/select.c
+rm -f select.s
+mv output.s testcase_result/optimize/select.s
+
+./parser testcase/optimize/dispatch.c
+rm -f dispatch.s
+mv output.s testcase_result/optimize/dispatch.s
+
+./parser testcase/optimize/range.c
+rm -f range.s
+mv output.s testcase_result/optimize/range.s
+
+./parser testcase/optimize/reassoc.c
+rm -f reassoc.s
+mv output.s testcase_result/optimize/reassoc.s
+
+./parser -ffast-math testcase/optimize/reassoc.c
+rm -f reassoc.s
+mv output.s testcase_result/optimize/reassoc_fastmath.s
+
+./parser testcase/optimize/dag.c
+rm -f dag.s
+mv output.s testcase_result/optimize/dag.s
+
+./parser testcase/optimize/tile.c
+rm -f tile.s
+mv output.s testcase_result/optimize/tile.s
+
+./parser testcase/optimize/schedule.c
+rm -f schedule.s
+mv output.s testcase_result/optimize/schedule.s
+
+./parser -fdelay-slots testcase/optimize/schedule.c
+rm -f schedule.s
+mv output.s testcase_result/optimize/schedule_delay.s
@@ -14,5 +14,7 @@ AST_NODE *Allocate(AST_TYPE type){
     // Notice that leftmostSibling is not initialized as NULL
     temp->leftmostSibling = temp;
     temp->linenumber = linenumber;
+    temp->symbolEntry = NULL;
+    temp->isDeadStore = 0;
     return temp;
 }
@@ -1,4 +1,6 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "codeGen.h"
 #include "header.h"
@@ -10,16 +12,50 @@
 GlobalResource GR;
 
 /* inner function prototype */
-void _normalEval(FILE* targetFile, AST_NODE* childNode, int jumpLabel, int jumpCond);
+void _normalEval(FILE* targetFile, STT* symbolTable, AST_NODE* childNode, int jumpLabel, int jumpCond);
 /* jumpCond = TRUE_JUMP or FALSE_JUMP */
 #define TRUE_JUMP 1
 #define FALSE_JUMP 0
 void _genParaList(FILE* targetFile, STT* symbolTable, AST_NODE* paraNode, ParameterNode* thisParameter);
 int isAllConstIndex(AST_NODE* headNode);
+void _collectLoopConsts(AST_NODE* node, HoistedConst* candidates, int* numOfCandidates, int* hasFuncCall);
+void _genInitVarReg(FILE* targetFile, SymbolTableEntry* entry, CON_Type* initValue);
+int _loadExprNodeReg(FILE* targetFile, AST_NODE* exprNode);
+void _genCachedVarAccess(FILE* targetFile, CachedGlobal* cached, int isStore);
+int _genUnrolledLoop(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode, CountedLoop* loop,
+  SymbolTableNode* bodyScope, char* funcName);
+void _genTiledLoop(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode, TiledLoop* tile, char* funcName);
+void _genTileIndexInit(FILE* targetFile, STT* symbolTable, AST_NODE* assignNode, TiledLoop* tile);
+void _genTileTest(FILE* targetFile, STT* symbolTable, AST_NODE* condNode, TiledLoop* tile, int exitLabel);
+void _genScalarAccess(FILE* targetFile, SymbolTableEntry* entry, int regNum, int isStore);
+int _genEnterReduction(FILE* targetFile, CountedLoop* loop, int* accRegNums, ExpValPlace* sumPlace);
+void _genExitReduction(FILE* targetFile, CountedLoop* loop, int* accRegNums, int numOfAcc, ExpValPlace* sumPlace);
+int _genElementAddress(FILE* targetFile, STT* symbolTable, AST_NODE* idNode);
+void _genLoopIdiom(FILE* targetFile, STT* symbolTable, LoopIdiom* idiom);
+void _skipScopes(STT* symbolTable, AST_NODE* node);
+void _genUnswitchedLoop(FILE* targetFile, STT* symbolTable, UnswitchedLoop* unswitched, char* funcName);
+AST_NODE* _getConstMulDivOperand(STT* symbolTable, AST_NODE* exprNode, int* value);
+int _genShiftAddSequence(FILE* targetFile, int destRegNum, int srcRegNum, unsigned int value);
+AST_NODE* _getImmOperand(STT* symbolTable, AST_NODE* exprNode, BINARY_OPERATOR* op, int* value, TileKind kind);
+int _isBranchTileCond(STT* symbolTable, AST_NODE* condNode);
+void _genBranchTile(FILE* targetFile, STT* symbolTable, AST_NODE* condNode, int jumpLabel, int jumpCond);
+int _getRegNeed(AST_NODE* exprNode);
+void _spillTemps(FILE* targetFile, RegisterManager* regManager);
+void _genLogicalValue(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode);
+void _computeDivMagic(unsigned int divisor, int* magic, int* shift);
+int _genRvalueReg(FILE* targetFile, STT* symbolTable, AST_NODE* rvalueNode, DATA_TYPE lvalueType);
+void _genStoreAssignment(FILE* targetFile, AST_NODE* assignmentNode, DATA_TYPE lvalueType, int rvalueRegNum);
+void _genSelectIf(FILE* targetFile, STT* symbolTable, AST_NODE* ifStmtNode,
+  AST_NODE* thenAssignNode, AST_NODE* elseAssignNode);
+void _genSwitchChain(FILE* targetFile, STT* symbolTable, SwitchChain* chain, char* funcName);
+void _genJumpTable(FILE* targetFile, int regNum, int* values, int* labels, int numOfCase, int defaultLabel);
+void _genSearchTree(FILE* targetFile, int regNum, int* values, int* labels, int low, int high, int defaultLabel);
 
 /* function definition */
 void codeGen(FILE* targetFile, AST_NODE* prog, STT* symbolTable){
     AST_NODE* child = prog->child;
+    analyzeArrayAliases(GR.aliasAnalysis, prog);
+    analyzeParamRanges(GR.rangeAnalysis, prog);
     while(child){
         if(child->nodeType == VARIABLE_DECL_LIST_NODE)
             genVariableDeclList(targetFile, symbolTable, child);
@@ -91,29 +127,40 @@ void genVariableDecl(FILE* targetFile, STT* symbolTable, AST_NODE* declarationNo
                 if( variableNode->child ) // need to initialize
                     constValue = variableNode->child->semantic_value.const1->const_u.fval;
 
-                fprintf(targetFile, "%s: .float %f\n", entry->name, constValue);
+                fprintf(targetFile, "%s: .word 0x%08x\n", entry->name, floatToBits(constValue));
             }
         }
-        else if(kind == LOCAL){
+        else if(kind == LOCAL && entry->place.kind == REG_TYPE){
+            /* promoted to variable register, no stack space */
+            if( variableNode->semantic_value.identifierSemanticValue.kind == WITH_INIT_ID && !variableNode->isDeadStore )
+                _genInitVarReg(targetFile, entry, variableNode->child->semantic_value.const1);
+        }
+        else if(kind == LOCAL && !isUnusedLocalVar(GR.localVars, entry)){
             GR.stackTop += varSize;
             setPlaceOfSymTableToStack(entry, GR.stackTop);
 
             // check if initialization required
-            if( variableNode->semantic_value.identifierSemanticValue.kind == WITH_INIT_ID ){ // need to initialize
+            if( variableNode->semantic_value.identifierSemanticValue.kind == WITH_INIT_ID && !variableNode->isDeadStore ){ // need to initialize
                 
                 if( type->primitiveType == INT_TYPE ){
                     
-                    int intRegNum = getReg(GR.regManager, targetFile);
                     int constValue = variableNode->child->semantic_value.const1->const_u.intval;
-                    fprintf(targetFile, "li $%d, %d\n", intRegNum, constValue);
+                    int intRegNum = findHoistedConst(GR.constPool, INT_TYPE, (unsigned int)constValue);
+                    if(intRegNum == -1){
+                        intRegNum = getReg(GR.regManager, targetFile);
+                        genLoadIntConstInstr(targetFile, intRegNum, constValue);
+                    }
                     fprintf(targetFile, "sw $%d, %d($fp)\n", intRegNum, -1*GR.stackTop); // initialize to stack.
                     releaseReg(GR.regManager, intRegNum);
                 }
                 else if( type->primitiveType == FLOAT_TYPE ){
                     
-                    int floatRegNum = getReg(GR.FPRegManager, targetFile);
                     float constValue = variableNode->child->semantic_value.const1->const_u.fval;
-                    fprintf(targetFile, "li.s $f%d, %f\n", floatRegNum, constValue);
+                    int floatRegNum = findHoistedConst(GR.constPool, FLOAT_TYPE, floatToBits(constValue));
+                    if(floatRegNum == -1){
+                        floatRegNum = getReg(GR.FPRegManager, targetFile);
+                        genLoadFloatConstInstr(targetFile, floatRegNum, constValue);
+                    }
                     fprintf(targetFile, "s.s $f%d, %d($fp)\n", floatRegNum, -1*GR.stackTop); // initialize to stack.
                     releaseReg(GR.FPRegManager, floatRegNum);
                 }
@@ -123,6 +170,27 @@ void genVariableDecl(FILE* targetFile, STT* symbolTable, AST_NODE* declarationNo
     }
 }
 
+void _genInitVarReg(FILE* targetFile, SymbolTableEntry* entry, CON_Type* initValue){
+    /* load initial value of local variable into its register */
+    int varRegNum = entry->place.place.regNum;
+    if(entry->type->primitiveType == INT_TYPE){
+        int constValue = initValue->const_u.intval;
+        int intRegNum = findHoistedConst(GR.constPool, INT_TYPE, (unsigned int)constValue);
+        if(intRegNum == -1)
+            genLoadIntConstInstr(targetFile, varRegNum, constValue);
+        else
+            fprintf(targetFile, "move $%d, $%d\n", varRegNum, intRegNum);
+    }
+    else if(entry->type->primitiveType == FLOAT_TYPE){
+        float constValue = initValue->const_u.fval;
+        int floatRegNum = findHoistedConst(GR.constPool, FLOAT_TYPE, floatToBits(constValue));
+        if(floatRegNum == -1)
+            genLoadFloatConstInstr(targetFile, varRegNum, constValue);
+        else
+            fprintf(targetFile, "mov.s $f%d, $f%d\n", varRegNum, floatRegNum);
+    }
+}
+
 /*** function implementation ***/
 void genFuncDecl(FILE* targetFile, STT* symbolTable, AST_NODE* declarationNode){
     /* codegen for function definition */
@@ -145,7 +213,12 @@ void genFuncDecl(FILE* targetFile, STT* symbolTable, AST_NODE* declarationNode){
      * stackOffset = -8, -12 ... etc
      */
     setParaListStackOffset(symbolTable, paraListNode);
+    setAliasFunc(GR.aliasAnalysis, funcName);
+    setRangeFunc(GR.rangeAnalysis, funcName, symbolTable);
+    analyzeLocalVars(GR.localVars, symbolTable, declarationNode);
     genPrologue(targetFile, funcName);
+    genVarRegPrologue(targetFile, funcName);
+    clearValueTable(GR.valueTable);
 
     AST_NODE* blockChild = blockNode->child;
 
@@ -157,6 +230,7 @@ void genFuncDecl(FILE* targetFile, STT* symbolTable, AST_NODE* declarationNode){
         blockChild = blockChild->rightSibling;
     }
 
+    clearValueTable(GR.valueTable);
     genEpilogue(targetFile, funcName, GR.stackTop);
     GR.stackTop = 36;
     closeScope(symbolTable);
@@ -214,6 +288,9 @@ void genPrologue(FILE* targetFile, char* funcName){
 void genEpilogue(FILE* targetFile, char* funcName, int frameSize){
     fprintf(targetFile, "# epilogue\n"               );
     fprintf(targetFile, "_end_%s:\n"                 , funcName);
+    if(strcmp(funcName, "main") == 0)
+        fprintf(targetFile, "    jal _write_flush\n"    ); /* buffered output of runtime */
+    genVarRegEpilogue(targetFile, funcName);
     fprintf(targetFile, "    # Load Saved register\n");
     fprintf(targetFile, "    lw  $s0, -36($fp)\n"     );
     fprintf(targetFile, "    lw  $s1, -32($fp)\n"     );
@@ -233,19 +310,148 @@ void genEpilogue(FILE* targetFile, char* funcName, int frameSize){
     fprintf(targetFile, "    _framesize_%s: .word %d\n", funcName, frameSize);
 }
 
+void genVarRegPrologue(FILE* targetFile, char* funcName){
+    /* save variable registers used by this function, load promoted parameters */
+    LocalVarSet* localVars = GR.localVars;
+    int i;
+    if(strcmp(funcName, "main") != 0){
+        localVars->saveOffset = GR.stackTop + 4;
+        for(i = 0; i < localVars->numOfVarReg; i++){
+            GR.stackTop += 4;
+            fprintf(targetFile, "    sw  $%d, %d($fp)\n", FIRST_VAR_REG_NUM + i, -1*GR.stackTop);
+        }
+        for(i = 0; i < localVars->numOfVarFPReg; i++){
+            GR.stackTop += 4;
+            fprintf(targetFile, "    s.s $f%d, %d($fp)\n", FIRST_VAR_FP_REG_NUM + i, -1*GR.stackTop);
+        }
+    }
+
+    for(i = 0; i < localVars->numOfVar; i++){
+        LocalVar* var = &(localVars->vars[i]);
+        if(!var->paraOffset || !var->isLiveAtEntry || var->entry->place.kind != REG_TYPE)
+            continue;
+        if(var->entry->type->primitiveType == INT_TYPE)
+            fprintf(targetFile, "    lw  $%d, %d($fp)\n", var->entry->place.place.regNum, -1*var->paraOffset);
+        else
+            fprintf(targetFile, "    l.s $f%d, %d($fp)\n", var->entry->place.place.regNum, -1*var->paraOffset);
+    }
+}
+
+void genVarRegEpilogue(FILE* targetFile, char* funcName){
+    /* restore variable registers of caller */
+    LocalVarSet* localVars = GR.localVars;
+    if(strcmp(funcName, "main") == 0)
+        return;
+
+    int i, stackOffset = localVars->saveOffset;
+    for(i = 0; i < localVars->numOfVarReg; i++, stackOffset += 4)
+        fprintf(targetFile, "    lw  $%d, %d($fp)\n", FIRST_VAR_REG_NUM + i, -1*stackOffset);
+    for(i = 0; i < localVars->numOfVarFPReg; i++, stackOffset += 4)
+        fprintf(targetFile, "    l.s $f%d, %d($fp)\n", FIRST_VAR_FP_REG_NUM + i, -1*stackOffset);
+}
+
+void _genCachedVarAccess(FILE* targetFile, CachedGlobal* cached, int isStore){
+    /* load cached variable into its register, or write it back */
+    SymbolTableEntry* entry = cached->entry;
+    char* instr = entry->type->primitiveType == INT_TYPE ? (isStore ? "sw" : "lw") : (isStore ? "s.s" : "l.s");
+    char* regPrefix = entry->type->primitiveType == INT_TYPE ? "" : "f";
+    if(entry->type->dimension == 0)
+        fprintf(targetFile, "%s $%s%d, %s\n", instr, regPrefix, cached->regNum, entry->name);
+    else if(entry->place.kind == GLOBAL_TYPE)
+        fprintf(targetFile, "%s $%s%d, %s+%d\n", instr, regPrefix, cached->regNum, entry->name, cached->offset);
+    else if(entry->place.kind == STACK_TYPE)
+        fprintf(targetFile, "%s $%s%d, %d($fp)\n", instr, regPrefix, cached->regNum,
+          -1*(entry->place.place.stackOffset - cached->offset));
+    else{
+        /* array parameter */
+        int tempRegNum = getReg(GR.regManager, targetFile);
+        fprintf(targetFile, "lw $%d, %d($fp)\n", tempRegNum, entry->place.place.inAddr.offset1);
+        fprintf(targetFile, "%s $%s%d, %d($%d)\n", instr, regPrefix, cached->regNum, cached->offset, tempRegNum);
+        releaseReg(GR.regManager, tempRegNum);
+    }
+}
+
+void genEnterCacheRegion(FILE* targetFile, AST_NODE* regionNode){
+    /* load globals and elements cached in loop, they are read from register from now on */
+    LocalVarSet* localVars = GR.localVars;
+    int i;
+    for(i = 0; i < localVars->numOfCached; i++){
+        CachedGlobal* cached = &(localVars->cached[i]);
+        if(cached->regionNode != regionNode)
+            continue;
+        _genCachedVarAccess(targetFile, cached, 0);
+        if(cached->entry->type->dimension == 0)
+            setPlaceOfSymTableToReg(cached->entry, cached->regNum);
+        localVars->activeRegion = regionNode;
+    }
+}
+
+void genFlushCachedGlobals(FILE* targetFile, char* calleeName){
+    /* write back cached globals that are written in loop, and the callee may read,
+     * no callee in loop touches a cached element */
+    LocalVarSet* localVars = GR.localVars;
+    int i;
+    if(!localVars->activeRegion)
+        return;
+    for(i = 0; i < localVars->numOfCached; i++){
+        CachedGlobal* cached = &(localVars->cached[i]);
+        if(cached->regionNode != localVars->activeRegion || !cached->isWritten)
+            continue;
+        if(calleeName && (cached->entry->type->dimension > 0 || !mayRefGlobal(GR.callGraph, calleeName, cached->entry)))
+            continue;
+        _genCachedVarAccess(targetFile, cached, 1);
+    }
+}
+
+void genExitCacheRegion(FILE* targetFile, AST_NODE* regionNode){
+    LocalVarSet* localVars = GR.localVars;
+    int i;
+    if(localVars->activeRegion != regionNode)
+        return;
+    genFlushCachedGlobals(targetFile, NULL);
+    for(i = 0; i < localVars->numOfCached; i++){
+        CachedGlobal* cached = &(localVars->cached[i]);
+        if(cached->regionNode == regionNode && cached->entry->type->dimension == 0)
+            setPlaceOfSymTableToGlobalData(cached->entry, cached->entry->name, 0);
+    }
+    localVars->activeRegion = NULL;
+}
+
+int findCachedElement(LocalVarSet* pThis, SymbolTableEntry* entry, int offset){
+    int i;
+    for(i = 0; pThis->activeRegion && i < pThis->numOfCached; i++){
+        CachedGlobal* cached = &(pThis->cached[i]);
+        if(cached->regionNode == pThis->activeRegion && cached->entry == entry && cached->offset == offset &&
+          entry->type->dimension > 0)
+            return cached->regNum;
+    }
+    return -1;
+}
+
 /*** statement generation ***/
 void genStmtList(FILE* targetFile, STT* symbolTable, AST_NODE* stmtListNode, char* funcName){
     
     AST_NODE* child = stmtListNode->child;
 
     while( child ){
+        if( isWriteStmt(child) && child->rightSibling && isWriteStmt(child->rightSibling) ){
+            child = genWriteSequence(targetFile, symbolTable, child);
+            continue;
+        }
         genStmt(targetFile, symbolTable, child, funcName);
         child = child -> rightSibling;
     }
 }
 
+void genLabel(FILE* targetFile, int labelNum){
+    /* control flow joins at label, values of previous basic block are unknown */
+    killAllValues(GR.valueTable);
+    fprintf(targetFile, "L%d:\n", labelNum);
+}
+
 void genStmt(FILE* targetFile, STT* symbolTable, AST_NODE* stmtNode, char* funcName){
     
+    beginValueStmt(GR.valueTable);
     if( stmtNode->nodeType == BLOCK_NODE )
         genBlock(targetFile, symbolTable, stmtNode, funcName);
     else if( stmtNode->nodeType == STMT_NODE ){
@@ -255,7 +461,12 @@ void genStmt(FILE* targetFile, STT* symbolTable, AST_NODE* stmtNode, char* funcN
             case WHILE_STMT: genWhileStmt(targetFile, symbolTable, stmtNode, funcName); break;
             case FOR_STMT: genForStmt(targetFile, symbolTable, stmtNode, funcName); break;
             case IF_STMT: genIfStmt(targetFile, symbolTable, stmtNode, funcName); break;
-            case ASSIGN_STMT: genAssignmentStmt(targetFile, symbolTable, stmtNode); break;
+            case ASSIGN_STMT: 
+                if(isDeadAssignment(stmtNode))
+                    break;
+                genAssignmentStmt(targetFile, symbolTable, stmtNode);
+                releaseExprNodeReg(stmtNode); /* value of assignment is unused */
+                break;
             case FUNCTION_CALL_STMT: genFuncCallStmt(targetFile, symbolTable, stmtNode, funcName); break;
             case RETURN_STMT: genReturnStmt(targetFile, symbolTable, stmtNode, funcName); break;
         }
@@ -278,6 +489,42 @@ void genBlock(FILE* targetFile, STT* symbolTable, AST_NODE* blockNode, char* fun
 }
 
 void genIfStmt(FILE* targetFile, STT* symbolTable, AST_NODE* ifStmtNode, char* funcName){
+
+    // condition tested before the loop selects the branch of this copy
+    AST_NODE* thenNode = ifStmtNode->child->rightSibling;
+    AST_NODE* elseNode = thenNode->rightSibling;
+    int outcome = findUnswitchedOutcome(GR.localVars, ifStmtNode);
+    // or value ranges decide it
+    int knownOutcome;
+    if(outcome == -1 && getKnownCondition(ifStmtNode->child, &knownOutcome))
+        outcome = knownOutcome;
+    if(outcome == 1){
+        genStmt(targetFile, symbolTable, thenNode, funcName);
+        _skipScopes(symbolTable, elseNode);
+        return;
+    }
+    if(outcome == 0){
+        _skipScopes(symbolTable, thenNode);
+        if(elseNode->nodeType != NUL_NODE)
+            genStmt(targetFile, symbolTable, elseNode, funcName);
+        return;
+    }
+
+    // chain of tests on one value dispatches once
+    SwitchChain chain;
+    if(analyzeSwitchChain(GR.localVars, ifStmtNode, &chain)){
+        _genSwitchChain(targetFile, symbolTable, &chain, funcName);
+        return;
+    }
+
+    // branches assigning one scalar become a conditional move
+    AST_NODE *thenAssignNode, *elseAssignNode;
+    if(isSelectIf(ifStmtNode, &thenAssignNode, &elseAssignNode)){
+        _genSelectIf(targetFile, symbolTable, ifStmtNode, thenAssignNode, elseAssignNode);
+        _skipScopes(symbolTable, thenNode);
+        _skipScopes(symbolTable, elseNode);
+        return;
+    }
     
     int thenLabel = GR.labelCounter++;
     int elseLabel = GR.labelCounter++;
@@ -285,63 +532,230 @@ void genIfStmt(FILE* targetFile, STT* symbolTable, AST_NODE* ifStmtNode, char* f
     // condition
     int isShortEval = genShortRelExpr(targetFile, symbolTable, ifStmtNode->child, thenLabel, elseLabel);
     
-    if(!isShortEval){
-        // jump to else if condition not match
-        int regNum = getExprNodeReg(targetFile, ifStmtNode->child);
-        fprintf(targetFile, "beqz $%d L%d\n", regNum, elseLabel);
-        if(ifStmtNode->child->valPlace.dataType == INT_TYPE)
-            releaseReg(GR.regManager, regNum);
-        else if(ifStmtNode->child->valPlace.dataType == FLOAT_TYPE)
-            releaseReg(GR.FPRegManager, regNum);
-    }
+    if(!isShortEval) // jump to else if condition not match
+        _normalEval(targetFile, symbolTable, ifStmtNode->child, elseLabel, FALSE_JUMP);
     
     // then block
-    fprintf(targetFile, "L%d:\n", thenLabel);
+    genLabel(targetFile, thenLabel);
     genStmt(targetFile, symbolTable, ifStmtNode->child->rightSibling, funcName);
     
     // jump over else
     fprintf(targetFile, "j L%d\n", exitLabel);
 
     // else block
-    fprintf(targetFile, "L%d:\n", elseLabel);
+    genLabel(targetFile, elseLabel);
     if( ifStmtNode->child->rightSibling->rightSibling->nodeType != NUL_NODE )
         genStmt(targetFile, symbolTable, ifStmtNode->child->rightSibling->rightSibling, funcName);
 
     // exit
-    fprintf(targetFile, "L%d:\n", exitLabel);
+    genLabel(targetFile, exitLabel);
+}
+
+void _genSwitchChain(FILE* targetFile, STT* symbolTable, SwitchChain* chain, char* funcName){
+    /* dispatch jumps to then statement of the test which is true, or to last else */
+    int caseLabels[MAX_SWITCH_CASES], sortedValues[MAX_SWITCH_CASES], sortedLabels[MAX_SWITCH_CASES];
+    int defaultLabel = GR.labelCounter++;
+    int exitLabel = GR.labelCounter++;
+    int i, j;
+    for(i = 0; i < chain->numOfCase; i++){
+        caseLabels[i] = GR.labelCounter++;
+        /* insertion sort for search */
+        for(j = i; j > 0 && sortedValues[j-1] > chain->values[i]; j--){
+            sortedValues[j] = sortedValues[j-1];
+            sortedLabels[j] = sortedLabels[j-1];
+        }
+        sortedValues[j] = chain->values[i];
+        sortedLabels[j] = caseLabels[i];
+    }
+
+    genExpr(targetFile, symbolTable, chain->exprNode);
+    int regNum = getExprNodeReg(targetFile, chain->exprNode);
+    unsigned int range = (unsigned int)sortedValues[chain->numOfCase-1] - (unsigned int)sortedValues[0];
+    if(range < MAX_JUMP_TABLE && range < (unsigned int)(MAX_TABLE_SPREAD * chain->numOfCase))
+        _genJumpTable(targetFile, regNum, sortedValues, sortedLabels, chain->numOfCase, defaultLabel);
+    else
+        _genSearchTree(targetFile, regNum, sortedValues, sortedLabels, 0, chain->numOfCase-1, defaultLabel);
+    releaseReg(GR.regManager, regNum);
+
+    for(i = 0; i < chain->numOfCase; i++){
+        genLabel(targetFile, caseLabels[i]);
+        genStmt(targetFile, symbolTable, chain->caseNodes[i], funcName);
+        fprintf(targetFile, "j L%d\n", exitLabel);
+    }
+    genLabel(targetFile, defaultLabel);
+    if(chain->defaultNode->nodeType != NUL_NODE)
+        genStmt(targetFile, symbolTable, chain->defaultNode, funcName);
+    genLabel(targetFile, exitLabel);
+}
+
+void _genJumpTable(FILE* targetFile, int regNum, int* values, int* labels, int numOfCase, int defaultLabel){
+    /* word of table is address of case label, values outside table go to default:
+     *     index = value - min
+     *     j default if index >= entries (unsigned)
+     *     jr table[index] */
+    int tableLabel = GR.labelCounter++;
+    int numOfEntry = values[numOfCase-1] - values[0] + 1;
+    int isHeld = holdReg(GR.regManager, regNum);
+    int indexRegNum = getReg(GR.regManager, targetFile);
+    unholdReg(GR.regManager, regNum, isHeld);
+
+    if(isImm16(-values[0]))
+        fprintf(targetFile, "addiu $%d, $%d, %d\n", indexRegNum, regNum, -values[0]);
+    else{
+        genLoadIntConstInstr(targetFile, SCRATCH_REG_NUM, values[0]);
+        fprintf(targetFile, "subu $%d, $%d, $%d\n", indexRegNum, regNum, SCRATCH_REG_NUM);
+    }
+    fprintf(targetFile, "sltiu $%d, $%d, %d\n", SCRATCH_REG_NUM, indexRegNum, numOfEntry);
+    fprintf(targetFile, "beqz $%d, L%d\n", SCRATCH_REG_NUM, defaultLabel);
+    fprintf(targetFile, "sll $%d, $%d, 2\n", indexRegNum, indexRegNum);
+    fprintf(targetFile, "lw $%d, _jumptable_%d($%d)\n", indexRegNum, tableLabel, indexRegNum);
+    fprintf(targetFile, "jr $%d\n", indexRegNum);
+    releaseReg(GR.regManager, indexRegNum);
+
+    int i, caseIndex = 0;
+    fprintf(targetFile, ".data\n");
+    fprintf(targetFile, "_jumptable_%d: .word", tableLabel);
+    for(i = 0; i < numOfEntry; i++){
+        int isCase = values[caseIndex] - values[0] == i;
+        fprintf(targetFile, "%s L%d", i == 0 ? "" : ",", isCase ? labels[caseIndex] : defaultLabel);
+        caseIndex += isCase;
+    }
+    fprintf(targetFile, "\n.text\n");
+}
+
+void _genSearchTree(FILE* targetFile, int regNum, int* values, int* labels, int low, int high, int defaultLabel){
+    /* binary search of sorted values, a few values are compared in turn */
+    int i;
+    if(high - low + 1 <= MAX_LINEAR_CASES){
+        for(i = low; i <= high; i++){
+            genLoadIntConstInstr(targetFile, SCRATCH_REG_NUM, values[i]);
+            fprintf(targetFile, "beq $%d, $%d, L%d\n", regNum, SCRATCH_REG_NUM, labels[i]);
+        }
+        fprintf(targetFile, "j L%d\n", defaultLabel);
+        return;
+    }
+
+    int mid = (low + high) / 2;
+    int lowLabel = GR.labelCounter++;
+    genLoadIntConstInstr(targetFile, SCRATCH_REG_NUM, values[mid]);
+    fprintf(targetFile, "beq $%d, $%d, L%d\n", regNum, SCRATCH_REG_NUM, labels[mid]);
+    fprintf(targetFile, "slt $%d, $%d, $%d\n", SCRATCH_REG_NUM, regNum, SCRATCH_REG_NUM);
+    fprintf(targetFile, "bne $%d, $0, L%d\n", SCRATCH_REG_NUM, lowLabel);
+    _genSearchTree(targetFile, regNum, values, labels, mid + 1, high, defaultLabel);
+    /* label with one predecessor, values in registers are still known */
+    fprintf(targetFile, "L%d:\n", lowLabel);
+    _genSearchTree(targetFile, regNum, values, labels, low, mid - 1, defaultLabel);
+}
+
+void _genSelectIf(FILE* targetFile, STT* symbolTable, AST_NODE* ifStmtNode,
+  AST_NODE* thenAssignNode, AST_NODE* elseAssignNode){
+    /* values of both branches are computed, then condition picks one:
+     *     movn dest, then, cond    if dest holds else value
+     *     movz dest, else, cond    if dest holds then value */
+    AST_NODE* condNode = ifStmtNode->child;
+    AST_NODE* lvalueNode = thenAssignNode->child;
+    DATA_TYPE type = lvalueNode->symbolEntry->type->primitiveType;
+    RegisterManager* regManager = type == FLOAT_TYPE ? GR.FPRegManager : GR.regManager;
+    char* regPrefix = type == FLOAT_TYPE ? "$f" : "$";
+    char* opSuffix = type == FLOAT_TYPE ? ".s" : "";
+
+    genExpr(targetFile, symbolTable, lvalueNode);
+    int thenRegNum = _genRvalueReg(targetFile, symbolTable, lvalueNode->rightSibling, type);
+    int isThenHeld = holdReg(regManager, thenRegNum);
+    int elseRegNum;
+    if(elseAssignNode)
+        elseRegNum = _genRvalueReg(targetFile, symbolTable, elseAssignNode->child->rightSibling, type);
+    else{
+        /* no else branch keeps old value, lvalue place is kept for the store */
+        ExpValPlace lvaluePlace = lvalueNode->valPlace;
+        elseRegNum = getExprNodeReg(targetFile, lvalueNode);
+        lvalueNode->valPlace = lvaluePlace;
+    }
+    int isElseHeld = holdReg(regManager, elseRegNum);
+
+    genExpr(targetFile, symbolTable, condNode);
+    int condRegNum = getExprNodeReg(targetFile, condNode);
+    if(condNode->valPlace.dataType == FLOAT_TYPE){
+        /* nonzero bits except sign */
+        int intRegNum = getReg(GR.regManager, targetFile);
+        fprintf(targetFile, "mfc1 $%d, $f%d\n", intRegNum, condRegNum);
+        fprintf(targetFile, "sll $%d, $%d, 1\n", intRegNum, intRegNum);
+        releaseReg(GR.FPRegManager, condRegNum);
+        condRegNum = intRegNum;
+        useReg(GR.regManager, condRegNum, condNode);
+    }
+    int isCondHeld = holdReg(GR.regManager, condRegNum);
+
+    /* a register shared with a variable or a kept value isn't held, it isn't overwritten */
+    int destRegNum, srcRegNum, isMoveIfZero = 0;
+    if(isElseHeld || (!elseAssignNode && lvalueNode->valPlace.kind == REG_TYPE)){
+        destRegNum = elseRegNum;
+        srcRegNum = thenRegNum;
+    }
+    else if(isThenHeld){
+        destRegNum = thenRegNum;
+        srcRegNum = elseRegNum;
+        isMoveIfZero = 1;
+    }
+    else{
+        destRegNum = getReg(regManager, targetFile);
+        fprintf(targetFile, "%s %s%d, %s%d\n", type == FLOAT_TYPE ? "mov.s" : "move",
+          regPrefix, destRegNum, regPrefix, elseRegNum);
+        srcRegNum = thenRegNum;
+    }
+    fprintf(targetFile, "%s%s %s%d, %s%d, $%d\n", isMoveIfZero ? "movz" : "movn", opSuffix,
+      regPrefix, destRegNum, regPrefix, srcRegNum, condRegNum);
+
+    unholdReg(regManager, thenRegNum, isThenHeld);
+    unholdReg(regManager, elseRegNum, isElseHeld);
+    unholdReg(GR.regManager, condRegNum, isCondHeld);
+    releaseReg(GR.regManager, condRegNum);
+    if(thenRegNum != destRegNum)
+        releaseReg(regManager, thenRegNum);
+    if(elseRegNum != destRegNum)
+        releaseReg(regManager, elseRegNum);
+
+    _genStoreAssignment(targetFile, thenAssignNode, type, destRegNum);
+    releaseExprNodeReg(thenAssignNode); /* value of assignment is unused */
 }
 
 void genWhileStmt(FILE* targetFile, STT* symbolTable, AST_NODE* whileStmtNode, char* funcName){
+
+    // invariant test in body selects one of two copies of loop
+    UnswitchedLoop* unswitched = findUnswitchedLoop(GR.localVars, whileStmtNode);
+    if(unswitched && unswitched->outcome == -1){
+        _genUnswitchedLoop(targetFile, symbolTable, unswitched, funcName);
+        return;
+    }
     
     int testLabel = GR.labelCounter++;
     int whileStmtLabel = GR.labelCounter++;
     int exitLabel = GR.labelCounter++;
 
+    // keep globals in registers, and load loop constants once, before entering the loop
+    genEnterCacheRegion(targetFile, whileStmtNode);
+    int numOfHoisted = genHoistLoopConsts(targetFile, whileStmtNode);
+
     // Test Label
-    fprintf(targetFile, "L%d:\n", testLabel);
+    genLabel(targetFile, testLabel);
     
     // condition
     int isShortEval = genShortRelExpr(targetFile, symbolTable, whileStmtNode->child, whileStmtLabel, exitLabel);
     
-    if(!isShortEval){
-        // check condition
-        int regNum = getExprNodeReg(targetFile, whileStmtNode->child);
-        fprintf(targetFile, "beqz $%d L%d\n", regNum, exitLabel);
-        if(whileStmtNode->child->valPlace.dataType == INT_TYPE)
-            releaseReg(GR.regManager, regNum);
-        else if(whileStmtNode->child->valPlace.dataType == FLOAT_TYPE)
-            releaseReg(GR.FPRegManager, regNum);
-    }
+    if(!isShortEval) // check condition
+        _normalEval(targetFile, symbolTable, whileStmtNode->child, exitLabel, FALSE_JUMP);
     
     // Stmt
-    fprintf(targetFile, "L%d:\n", whileStmtLabel);
+    genLabel(targetFile, whileStmtLabel);
     genStmt(targetFile, symbolTable, whileStmtNode->child->rightSibling, funcName);
 
     // loop back
     fprintf(targetFile, "j L%d\n", testLabel);
 
     // exit
-    fprintf(targetFile, "L%d:\n", exitLabel);
+    genLabel(targetFile, exitLabel);
+    releaseHoistedConsts(numOfHoisted);
+    genExitCacheRegion(targetFile, whileStmtNode);
 }
 
 void genForStmt(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode, char* funcName){
@@ -352,56 +766,483 @@ void genForStmt(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode, char*
     AST_NODE* incNode    = forStmtNode->child->rightSibling->rightSibling->child;
     AST_NODE* blockNode  = forStmtNode->child->rightSibling->rightSibling->rightSibling;
 
+    // invariant test in body selects one of two copies of loop
+    UnswitchedLoop* unswitched = findUnswitchedLoop(GR.localVars, forStmtNode);
+    if(unswitched && unswitched->outcome == -1){
+        _genUnswitchedLoop(targetFile, symbolTable, unswitched, funcName);
+        return;
+    }
+
+    // tiled nest runs the outer loop once for each tile of the inner range
+    TiledLoop* tile = findTiledLoop(GR.localVars, forStmtNode);
+    if(tile && tile->outerNode == forStmtNode && !tile->isActive){
+        _genTiledLoop(targetFile, symbolTable, forStmtNode, tile, funcName);
+        return;
+    }
+    int isTiledInner = tile && tile->innerNode == forStmtNode;
+
     // Label initialization
     int testLabel = GR.labelCounter++;
     int incLabel  = GR.labelCounter++;
     int bodyLabel = GR.labelCounter++;
     int exitLabel = GR.labelCounter++;
 
+    // initialization may assign cached globals
+    genEnterCacheRegion(targetFile, forStmtNode);
+
     // assign stmt
+    if(isTiledInner){
+        _genTileIndexInit(targetFile, symbolTable, assignNode, tile);
+        assignNode = NULL;
+    }
     while(assignNode){ // handle multiple assign stmt
+        if(isDeadAssignment(assignNode)){
+            assignNode = assignNode->rightSibling;
+            continue;
+        }
 
         genAssignExpr(targetFile, symbolTable, assignNode);
+        releaseExprNodeReg(assignNode);
         assignNode = assignNode->rightSibling;
     }
 
+    // loop which only fills or copies consecutive elements calls a block routine
+    LoopIdiom idiom;
+    if(!tile && analyzeLoopIdiom(GR.localVars, forStmtNode, &idiom) != IDIOM_NONE){
+        _genLoopIdiom(targetFile, symbolTable, &idiom);
+        _skipScopes(symbolTable, blockNode);
+        genExitCacheRegion(targetFile, forStmtNode);
+        return;
+    }
+
+    // load loop constants once, before entering the loop
+    int numOfHoisted = genHoistLoopConsts(targetFile, forStmtNode);
+
+    // counted loop runs copies of body between tests, and may leave the rest to the loop below
+    SymbolTableNode* bodyScope = symbolTable->lastChildScope;
+    CountedLoop loop;
+    if(!isTiledInner && analyzeCountedLoop(GR.localVars, forStmtNode, &loop) > 1 &&
+      _genUnrolledLoop(targetFile, symbolTable, forStmtNode, &loop, bodyScope, funcName)){
+        releaseHoistedConsts(numOfHoisted);
+        genExitCacheRegion(targetFile, forStmtNode);
+        return;
+    }
+
     // condition
     // UNFINISH: genShortRelExpr
-    fprintf(targetFile, "L%d:\n", testLabel);
+    genLabel(targetFile, testLabel);
     
         // handle multiple condition expr, except for last one
-    if(condNode){
+    if(isTiledInner){
+        _genTileTest(targetFile, symbolTable, condNode, tile, exitLabel);
+        fprintf(targetFile, "j L%d\n", bodyLabel);
+    }
+    else if(condNode){
         while(condNode->rightSibling){
             
             genAssignExpr(targetFile, symbolTable, condNode);
+            releaseExprNodeReg(condNode);
             condNode = condNode->rightSibling;
         }
             // last condition expr
         int isShortEval = genShortRelExpr(targetFile, symbolTable, condNode, bodyLabel, exitLabel);
         if(!isShortEval){
-            fprintf(targetFile, "beqz $%d L%d\n", condNode->valPlace.place.regNum, exitLabel);
+            _normalEval(targetFile, symbolTable, condNode, exitLabel, FALSE_JUMP);
             fprintf(targetFile, "j L%d\n", bodyLabel);
         }
     }
 
     // increment stmt
-    fprintf(targetFile, "L%d:\n", incLabel);
+    genLabel(targetFile, incLabel);
 
     while(incNode){ // handle multiple assign stmt
+        if(isDeadAssignment(incNode)){
+            incNode = incNode->rightSibling;
+            continue;
+        }
 
         genAssignExpr(targetFile, symbolTable, incNode);
+        releaseExprNodeReg(incNode);
         incNode = incNode->rightSibling;
     }
 
     fprintf(targetFile, "j L%d\n", testLabel);
 
     // body
-    fprintf(targetFile, "L%d:\n", bodyLabel);
+    genLabel(targetFile, bodyLabel);
+    symbolTable->lastChildScope = bodyScope;
     genStmt(targetFile, symbolTable, blockNode, funcName);
     fprintf(targetFile, "j L%d\n", incLabel);
 
     // exit
-    fprintf(targetFile, "L%d:\n", exitLabel);
+    genLabel(targetFile, exitLabel);
+    releaseHoistedConsts(numOfHoisted);
+    genExitCacheRegion(targetFile, forStmtNode);
+}
+
+void _genUnswitchedLoop(FILE* targetFile, STT* symbolTable, UnswitchedLoop* unswitched, char* funcName){
+    /* test condition of if statement once, then run the copy of loop which takes its branch */
+    AST_NODE* condNode = unswitched->ifNode->child;
+    SymbolTableNode* bodyScope = symbolTable->lastChildScope;
+    int trueLabel = GR.labelCounter++;
+    int falseLabel = GR.labelCounter++;
+    int exitLabel = GR.labelCounter++;
+
+    int isShortEval = genShortRelExpr(targetFile, symbolTable, condNode, trueLabel, falseLabel);
+    if(!isShortEval)
+        _normalEval(targetFile, symbolTable, condNode, falseLabel, FALSE_JUMP);
+
+    genLabel(targetFile, trueLabel);
+    unswitched->outcome = 1;
+    genStmt(targetFile, symbolTable, unswitched->loopNode, funcName);
+    fprintf(targetFile, "j L%d\n", exitLabel);
+
+    genLabel(targetFile, falseLabel);
+    symbolTable->lastChildScope = bodyScope;
+    unswitched->outcome = 0;
+    genStmt(targetFile, symbolTable, unswitched->loopNode, funcName);
+
+    genLabel(targetFile, exitLabel);
+    unswitched->outcome = -1;
+}
+
+void _genTiledLoop(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode, TiledLoop* tile, char* funcName){
+    /* for(T = first; T < last; T = L) { L = min(T + TILE_SIZE, last); outer loop with inner index in [T, L) } */
+    int tileLabel = GR.labelCounter++;
+    int limitLabel = GR.labelCounter++;
+    genLoadIntConstInstr(targetFile, tile->tileRegNum, tile->first);
+    genLabel(targetFile, tileLabel);
+    fprintf(targetFile, "addiu $%d, $%d, %d\n", tile->limitRegNum, tile->tileRegNum, TILE_SIZE);
+    int regNum = getReg(GR.regManager, targetFile);
+    genLoadIntConstInstr(targetFile, regNum, tile->last);
+    genLTExpr(targetFile, regNum, regNum, tile->limitRegNum);
+    fprintf(targetFile, "beqz $%d L%d\n", regNum, limitLabel);
+    genLoadIntConstInstr(targetFile, tile->limitRegNum, tile->last);
+    releaseReg(GR.regManager, regNum);
+    genLabel(targetFile, limitLabel);
+
+    tile->isActive = 1;
+    genForStmt(targetFile, symbolTable, forStmtNode, funcName);
+    tile->isActive = 0;
+
+    fprintf(targetFile, "move $%d, $%d\n", tile->tileRegNum, tile->limitRegNum);
+    regNum = getReg(GR.regManager, targetFile);
+    genLoadIntConstInstr(targetFile, regNum, tile->last);
+    genLTExpr(targetFile, regNum, tile->tileRegNum, regNum);
+    fprintf(targetFile, "bnez $%d L%d\n", regNum, tileLabel);
+    releaseReg(GR.regManager, regNum);
+}
+
+void _genTileIndexInit(FILE* targetFile, STT* symbolTable, AST_NODE* assignNode, TiledLoop* tile){
+    /* inner index starts from the current tile, it is a local int scalar */
+    AST_NODE* indexNode = assignNode->child;
+    genExpr(targetFile, symbolTable, indexNode);
+    if(indexNode->valPlace.kind == REG_TYPE)
+        fprintf(targetFile, "move $%d, $%d\n", indexNode->valPlace.place.regNum, tile->tileRegNum);
+    else
+        fprintf(targetFile, "sw $%d, %d($fp)\n", tile->tileRegNum, -1*indexNode->valPlace.place.stackOffset);
+}
+
+void _genTileTest(FILE* targetFile, STT* symbolTable, AST_NODE* condNode, TiledLoop* tile, int exitLabel){
+    /* inner index < end of the current tile */
+    AST_NODE* indexNode = condNode->child;
+    genExpr(targetFile, symbolTable, indexNode);
+    int indexRegNum = getExprNodeReg(targetFile, indexNode);
+    int regNum = getReg(GR.regManager, targetFile);
+    genLTExpr(targetFile, regNum, indexRegNum, tile->limitRegNum);
+    fprintf(targetFile, "beqz $%d L%d\n", regNum, exitLabel);
+    releaseReg(GR.regManager, regNum);
+    releaseReg(GR.regManager, indexRegNum);
+}
+
+void _genUnrolledCopy(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode,
+  SymbolTableNode* bodyScope, char* funcName){
+    /* one iteration of body and increment, body enters the same scopes again */
+    AST_NODE* incNode   = forStmtNode->child->rightSibling->rightSibling->child;
+    AST_NODE* blockNode = forStmtNode->child->rightSibling->rightSibling->rightSibling;
+
+    symbolTable->lastChildScope = bodyScope;
+    genStmt(targetFile, symbolTable, blockNode, funcName);
+    beginValueStmt(GR.valueTable);
+    genAssignExpr(targetFile, symbolTable, incNode);
+    releaseExprNodeReg(incNode);
+}
+
+void _genUnrollGuard(FILE* targetFile, STT* symbolTable, CountedLoop* loop, int restLabel){
+    /* jump to restLabel unless a whole group of iterations is left,
+     * bound - i is compared unsigned, it can't overflow once i < bound */
+    beginValueStmt(GR.valueTable);
+    genExpr(targetFile, symbolTable, loop->indexNode);
+    int indexRegNum = getExprNodeReg(targetFile, loop->indexNode);
+    genExpr(targetFile, symbolTable, loop->boundNode);
+    int boundRegNum = getExprNodeReg(targetFile, loop->boundNode);
+    int regNum = getReg(GR.regManager, targetFile);
+
+    if(loop->isInclusive){
+        genLTExpr(targetFile, regNum, boundRegNum, indexRegNum);
+        fprintf(targetFile, "bnez $%d L%d\n", regNum, restLabel);
+    }
+    else{
+        genLTExpr(targetFile, regNum, indexRegNum, boundRegNum);
+        fprintf(targetFile, "beqz $%d L%d\n", regNum, restLabel);
+    }
+    fprintf(targetFile, "subu $%d, $%d, $%d\n", regNum, boundRegNum, indexRegNum);
+    fprintf(targetFile, "sltiu $%d, $%d, %d\n", regNum, regNum, (loop->factor - 1) * loop->step + !loop->isInclusive);
+    fprintf(targetFile, "bnez $%d L%d\n", regNum, restLabel);
+
+    releaseReg(GR.regManager, regNum);
+    releaseReg(GR.regManager, boundRegNum);
+    releaseReg(GR.regManager, indexRegNum);
+}
+
+int _genUnrolledLoop(FILE* targetFile, STT* symbolTable, AST_NODE* forStmtNode, CountedLoop* loop,
+  SymbolTableNode* bodyScope, char* funcName){
+    /* return 1 if every iteration is done, 0 if the original loop runs the rest */
+    int i, accRegNums[MAX_ACCUMULATOR], numOfAcc;
+    ExpValPlace sumPlace;
+    if(loop->tripCount != -1){
+        int numOfGroup = loop->tripCount / loop->factor;
+        if(numOfGroup > 1){
+            /* at least one group runs, test at the bottom */
+            int groupLabel = GR.labelCounter++;
+            numOfAcc = _genEnterReduction(targetFile, loop, accRegNums, &sumPlace);
+            genLabel(targetFile, groupLabel);
+            for(i = 0; i < loop->factor; i++){
+                if(numOfAcc > 1)
+                    setPlaceOfSymTableToReg(loop->reductionNode->symbolEntry, accRegNums[i % numOfAcc]);
+                _genUnrolledCopy(targetFile, symbolTable, forStmtNode, bodyScope, funcName);
+            }
+
+            beginValueStmt(GR.valueTable);
+            genExpr(targetFile, symbolTable, loop->indexNode);
+            int indexRegNum = getExprNodeReg(targetFile, loop->indexNode);
+            int regNum = getReg(GR.regManager, targetFile);
+            genLoadIntConstInstr(targetFile, regNum, loop->first + numOfGroup * loop->factor * loop->step);
+            genLTExpr(targetFile, regNum, indexRegNum, regNum);
+            fprintf(targetFile, "bnez $%d L%d\n", regNum, groupLabel);
+            releaseReg(GR.regManager, regNum);
+            releaseReg(GR.regManager, indexRegNum);
+            _genExitReduction(targetFile, loop, accRegNums, numOfAcc, &sumPlace);
+        }
+        else
+            for(i = 0; i < loop->factor; i++)
+                _genUnrolledCopy(targetFile, symbolTable, forStmtNode, bodyScope, funcName);
+
+        /* remainder */
+        for(i = 0; i < loop->tripCount % loop->factor; i++)
+            _genUnrolledCopy(targetFile, symbolTable, forStmtNode, bodyScope, funcName);
+        return 1;
+    }
+
+    int groupLabel = GR.labelCounter++;
+    int restLabel = GR.labelCounter++;
+    numOfAcc = _genEnterReduction(targetFile, loop, accRegNums, &sumPlace);
+    genLabel(targetFile, groupLabel);
+    _genUnrollGuard(targetFile, symbolTable, loop, restLabel);
+    for(i = 0; i < loop->factor; i++){
+        if(numOfAcc > 1)
+            setPlaceOfSymTableToReg(loop->reductionNode->symbolEntry, accRegNums[i % numOfAcc]);
+        _genUnrolledCopy(targetFile, symbolTable, forStmtNode, bodyScope, funcName);
+    }
+    fprintf(targetFile, "j L%d\n", groupLabel);
+    genLabel(targetFile, restLabel);
+    _genExitReduction(targetFile, loop, accRegNums, numOfAcc, &sumPlace);
+    return 0;
+}
+
+void _genScalarAccess(FILE* targetFile, SymbolTableEntry* entry, int regNum, int isStore){
+    /* load int scalar from its place into register, or store register to it */
+    ExpValPlace* place = &(entry->place);
+    if(place->kind == REG_TYPE)
+        fprintf(targetFile, "move $%d, $%d\n", isStore ? place->place.regNum : regNum,
+          isStore ? regNum : place->place.regNum);
+    else if(place->kind == STACK_TYPE)
+        fprintf(targetFile, "%s $%d, %d($fp)\n", isStore ? "sw" : "lw", regNum, -1*place->place.stackOffset);
+    else
+        fprintf(targetFile, "%s $%d, %s+%d\n", isStore ? "sw" : "lw", regNum,
+          place->place.data.label, place->place.data.offset);
+}
+
+int _genEnterReduction(FILE* targetFile, CountedLoop* loop, int* accRegNums, ExpValPlace* sumPlace){
+    /* copies of body add into their own register in turn, which breaks the chain of additions.
+     * return number of accumulators, 1 if the sum stays in its place */
+    RegisterManager* regManager = GR.regManager;
+    int i, numOfPinned = 0;
+    int numOfAcc = loop->factor < MAX_ACCUMULATOR ? loop->factor : MAX_ACCUMULATOR;
+    if(!loop->reductionNode)
+        return 1;
+    clearValueTable(GR.valueTable);
+    for(i = 0; i < regManager->numOfReg; i++)
+        numOfPinned += regManager->regPinned[i];
+    while(numOfAcc > 1 && numOfPinned + numOfAcc > regManager->numOfReg - MIN_FREE_REG_NUM)
+        numOfAcc--;
+    if(numOfAcc <= 1)
+        return 1;
+
+    SymbolTableEntry* entry = loop->reductionNode->symbolEntry;
+    *sumPlace = entry->place;
+    for(i = 0; i < numOfAcc; i++){
+        accRegNums[i] = getReg(regManager, targetFile);
+        pinReg(regManager, accRegNums[i]);
+        if(i == 0)
+            _genScalarAccess(targetFile, entry, accRegNums[i], 0);
+        else
+            genLoadIntConstInstr(targetFile, accRegNums[i], 0);
+    }
+    return numOfAcc;
+}
+
+void _genExitReduction(FILE* targetFile, CountedLoop* loop, int* accRegNums, int numOfAcc, ExpValPlace* sumPlace){
+    /* add up accumulators into the sum, signed overflow is undefined as in C */
+    int i;
+    if(numOfAcc <= 1)
+        return;
+    SymbolTableEntry* entry = loop->reductionNode->symbolEntry;
+    entry->place = *sumPlace;
+    for(i = 1; i < numOfAcc; i++){
+        fprintf(targetFile, "addu $%d, $%d, $%d\n", accRegNums[0], accRegNums[0], accRegNums[i]);
+        unpinReg(GR.regManager, accRegNums[i]);
+    }
+    _genScalarAccess(targetFile, entry, accRegNums[0], 1);
+    unpinReg(GR.regManager, accRegNums[0]);
+}
+
+int _genElementAddress(FILE* targetFile, STT* symbolTable, AST_NODE* idNode){
+    /* return register holding address of array element */
+    char* name = idNode->semantic_value.identifierSemanticValue.identifierName;
+    int level;
+    SymbolTableEntry* entry = lookupSymbolWithLevel(symbolTable, name, &level);
+    int arrayOffset = 0;
+    ArrayIndexKind arrIdxKind = computeArrayOffset(targetFile, symbolTable, entry, idNode, &arrayOffset);
+    int regNum = getReg(GR.regManager, targetFile);
+    if(level == 0)
+        fprintf(targetFile, "la $%d, %s+%d\n", regNum, name, arrayOffset);
+    else if(entry->place.kind == INDIRECT_ADDRESS){
+        fprintf(targetFile, "lw $%d, %d($fp)\n", regNum, entry->place.place.inAddr.offset1);
+        fprintf(targetFile, "addiu $%d, $%d, %d\n", regNum, regNum, arrayOffset);
+    }
+    else
+        fprintf(targetFile, "addiu $%d, $fp, %d\n", regNum, arrayOffset - entry->place.place.stackOffset);
+    if(arrIdxKind == DYNAMIC_INDEX){
+        int offsetRegNum = getExprNodeReg(targetFile, idNode->child);
+        fprintf(targetFile, "addu $%d, $%d, $%d\n", regNum, regNum, offsetRegNum);
+        releaseReg(GR.regManager, offsetRegNum);
+    }
+    return regNum;
+}
+
+void _skipScopes(STT* symbolTable, AST_NODE* node){
+    /* pass over scopes of blocks whose code isn't generated */
+    AST_NODE* child;
+    if(node->nodeType == BLOCK_NODE)
+        openScope(symbolTable, USE, NULL);
+    for(child = node->child; child; child = child->rightSibling)
+        _skipScopes(symbolTable, child);
+    if(node->nodeType == BLOCK_NODE)
+        closeScope(symbolTable);
+}
+
+void _genLoopIdiom(FILE* targetFile, STT* symbolTable, LoopIdiom* idiom){
+    /* elements from the lvalue at the initial indices are filled or copied by the runtime,
+     * then indices get the values the loop leaves */
+    CountedLoop* loop = &(idiom->loop);
+    RegisterManager* regManager = GR.regManager;
+    int skipLabel = GR.labelCounter++;
+
+    /* count = bound - i */
+    int countRegNum = getReg(regManager, targetFile);
+    int regNum = getReg(regManager, targetFile);
+    if(loop->boundNode->nodeType == CONST_VALUE_NODE)
+        genLoadIntConstInstr(targetFile, countRegNum, loop->boundNode->semantic_value.const1->const_u.intval);
+    else
+        _genScalarAccess(targetFile, loop->boundNode->symbolEntry, countRegNum, 0);
+    _genScalarAccess(targetFile, loop->indexNode->symbolEntry, regNum, 0);
+    fprintf(targetFile, "subu $%d, $%d, $%d\n", countRegNum, countRegNum, regNum);
+    if(loop->isInclusive)
+        fprintf(targetFile, "addiu $%d, $%d, 1\n", countRegNum, countRegNum);
+    fprintf(targetFile, "blez $%d L%d\n", countRegNum, skipLabel);
+    pinReg(regManager, countRegNum);
+    releaseReg(regManager, regNum);
+
+    /* arguments, a nest starts at j = 0 */
+    if(idiom->rowLoopNode){
+        AST_NODE* assignNode = idiom->rowLoopNode->child->child;
+        genAssignExpr(targetFile, symbolTable, assignNode);
+        releaseExprNodeReg(assignNode);
+    }
+    beginValueStmt(GR.valueTable);
+    int destRegNum = _genElementAddress(targetFile, symbolTable, idiom->destNode);
+    pinReg(regManager, destRegNum);
+    if(idiom->kind == IDIOM_FILL){
+        AST_NODE* srcNode = idiom->srcNode;
+        DATA_TYPE destType = idiom->destNode->symbolEntry->type->primitiveType;
+        genExpr(targetFile, symbolTable, srcNode);
+        int srcRegNum = getExprNodeReg(targetFile, srcNode);
+        if(getTypeOfExpr(symbolTable, srcNode) == INT_TYPE && destType == FLOAT_TYPE){
+            int floatRegNum = getReg(GR.FPRegManager, targetFile);
+            genIntToFloat(targetFile, floatRegNum, srcRegNum);
+            releaseReg(regManager, srcRegNum);
+            fprintf(targetFile, "mfc1 $a2, $f%d\n", floatRegNum);
+            releaseReg(GR.FPRegManager, floatRegNum);
+        }
+        else if(getTypeOfExpr(symbolTable, srcNode) == FLOAT_TYPE && destType == INT_TYPE){
+            int intRegNum = getReg(regManager, targetFile);
+            genFloatToInt(targetFile, intRegNum, srcRegNum);
+            releaseReg(GR.FPRegManager, srcRegNum);
+            fprintf(targetFile, "move $a2, $%d\n", intRegNum);
+            releaseReg(regManager, intRegNum);
+        }
+        else if(destType == FLOAT_TYPE){
+            fprintf(targetFile, "mfc1 $a2, $f%d\n", srcRegNum);
+            releaseReg(GR.FPRegManager, srcRegNum);
+        }
+        else{
+            fprintf(targetFile, "move $a2, $%d\n", srcRegNum);
+            releaseReg(regManager, srcRegNum);
+        }
+    }
+    else{
+        int srcRegNum = _genElementAddress(targetFile, symbolTable, idiom->srcNode);
+        fprintf(targetFile, "move $a1, $%d\n", srcRegNum);
+        releaseReg(regManager, srcRegNum);
+    }
+    fprintf(targetFile, "move $a0, $%d\n", destRegNum);
+    unpinReg(regManager, destRegNum);
+
+    /* number of elements, whole rows of a nest */
+    char* countArg = idiom->kind == IDIOM_FILL ? "$a1" : "$a2";
+    if(idiom->rowLoopNode){
+        regNum = getReg(regManager, targetFile);
+        if(!genMulConstInstr(targetFile, regNum, countRegNum, idiom->rowLength)){
+            genLoadIntConstInstr(targetFile, regNum, idiom->rowLength);
+            genMulOpInstr(targetFile, regNum, countRegNum, regNum);
+        }
+        fprintf(targetFile, "move %s, $%d\n", countArg, regNum);
+        releaseReg(regManager, regNum);
+    }
+    else
+        fprintf(targetFile, "move %s, $%d\n", countArg, countRegNum);
+    if(idiom->kind == IDIOM_FILL){
+        fprintf(targetFile, "jal _array_fill\n");
+        GR.runtimeUsed |= RUNTIME_FILL;
+    }
+    else{
+        fprintf(targetFile, "jal _array_copy\n");
+        GR.runtimeUsed |= RUNTIME_COPY;
+    }
+
+    /* i += count, and j ends at the row length */
+    regNum = getReg(regManager, targetFile);
+    _genScalarAccess(targetFile, loop->indexNode->symbolEntry, regNum, 0);
+    fprintf(targetFile, "addu $%d, $%d, $%d\n", regNum, regNum, countRegNum);
+    _genScalarAccess(targetFile, loop->indexNode->symbolEntry, regNum, 1);
+    if(idiom->rowLoopNode){
+        genLoadIntConstInstr(targetFile, regNum, idiom->rowLength);
+        _genScalarAccess(targetFile, idiom->rowIndexNode->symbolEntry, regNum, 1);
+    }
+    releaseReg(regManager, regNum);
+    unpinReg(regManager, countRegNum);
+    genLabel(targetFile, skipLabel);
 }
 
 void genFuncCallStmt(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode, char* funcName){
@@ -452,6 +1293,7 @@ void genReturnStmt(FILE* targetFile, STT* symbolTable, AST_NODE* returnNode, cha
         releaseReg(GR.FPRegManager, retRegNum);
     }
 
+    genFlushCachedGlobals(targetFile, NULL);
     fprintf(targetFile, "j _end_%s\n", funcName);
 }
 
@@ -470,8 +1312,13 @@ void genAssignmentStmt(FILE* targetFile, STT* symbolTable, AST_NODE* assignmentN
 
     DATA_TYPE lvalueType = lvalueEntry->type->primitiveType;
     /* rvalue */
-    AST_NODE* rvalueNode = assignmentNode->child->rightSibling;
-    genExpr(targetFile, symbolTable, rvalueNode); // 0 means not function parameter
+    int rvalueRegNum = _genRvalueReg(targetFile, symbolTable, assignmentNode->child->rightSibling, lvalueType);
+    _genStoreAssignment(targetFile, assignmentNode, lvalueType, rvalueRegNum);
+}
+
+int _genRvalueReg(FILE* targetFile, STT* symbolTable, AST_NODE* rvalueNode, DATA_TYPE lvalueType){
+    /* register of rvalue converted to type of lvalue */
+    genExpr(targetFile, symbolTable, rvalueNode);
     DATA_TYPE rvalueType = getTypeOfExpr(symbolTable, rvalueNode);
     int rvalueRegNum = getExprNodeReg(targetFile, rvalueNode);
     /* type conversion */
@@ -493,29 +1340,40 @@ void genAssignmentStmt(FILE* targetFile, STT* symbolTable, AST_NODE* assignmentN
         setPlaceOfASTNodeToReg(rvalueNode, FLOAT_TYPE, floatRegNum);
         useReg(GR.FPRegManager, floatRegNum, rvalueNode);
     }
+    return rvalueRegNum;
+}
 
-    /* assignment */
+void _genStoreAssignment(FILE* targetFile, AST_NODE* assignmentNode, DATA_TYPE lvalueType, int rvalueRegNum){
+    /* store rvalue register to lvalue evaluated by genExpr */
+    AST_NODE* lvalueNode = assignmentNode->child;
     ExpValPlace* lvaluePlace = &(lvalueNode->valPlace);
     if(lvalueType == INT_TYPE){
         /* lvalue = rvalue */
-        if(lvaluePlace->kind == STACK_TYPE && lvaluePlace->arrIdxKind == STATIC_INDEX)
+        if(assignmentNode->isDeadStore){
+            /* value is never read */
+        }
+        else if(lvaluePlace->kind == REG_TYPE){
+            if(lvaluePlace->place.regNum != rvalueRegNum)
+                fprintf(targetFile, "move $%d, $%d\n", lvaluePlace->place.regNum, rvalueRegNum);
+        }
+        else if(lvaluePlace->kind == STACK_TYPE && lvaluePlace->arrIdxKind == STATIC_INDEX)
             fprintf(targetFile, "sw $%d, %d($fp)\n", rvalueRegNum, -1*lvaluePlace->place.stackOffset);
         else if(lvaluePlace->kind == STACK_TYPE && lvaluePlace->arrIdxKind == DYNAMIC_INDEX){
             int tempRegNum = getExprNodeReg(targetFile, lvalueNode->child);
-            fprintf(targetFile, "add $%d, $%d, $fp\n", tempRegNum, tempRegNum);
+            int addrRegNum = getAddrReg(targetFile, tempRegNum);
+            fprintf(targetFile, "add $%d, $%d, $fp\n", addrRegNum, tempRegNum);
             fprintf(targetFile, "sw $%d, %d($%d)\n", rvalueRegNum, 
-              -1*lvaluePlace->place.stackOffset, tempRegNum);
+              -1*lvaluePlace->place.stackOffset, addrRegNum);
+            releaseReg(GR.regManager, addrRegNum);
             releaseReg(GR.regManager, tempRegNum);
-        
         }
         else if(lvaluePlace->kind == GLOBAL_TYPE && lvaluePlace->arrIdxKind == STATIC_INDEX)
             fprintf(targetFile, "sw $%d, %s+%d\n", rvalueRegNum, 
               lvaluePlace->place.data.label, lvaluePlace->place.data.offset);
         else if(lvaluePlace->kind == GLOBAL_TYPE && lvaluePlace->arrIdxKind == DYNAMIC_INDEX){
             int tempRegNum = getExprNodeReg(targetFile, lvalueNode->child);
-            fprintf(targetFile, "addi $%d, $%d, %s\n", tempRegNum, tempRegNum,
-              lvalueNode->valPlace.place.data.label);
-            fprintf(targetFile, "sw $%d, 0($%d)\n", rvalueRegNum, tempRegNum);
+            fprintf(targetFile, "sw $%d, %s($%d)\n", rvalueRegNum,
+              lvalueNode->valPlace.place.data.label, tempRegNum);
             releaseReg(GR.regManager, tempRegNum); 
         }
         else if(lvaluePlace->kind == INDIRECT_ADDRESS && lvaluePlace->arrIdxKind == STATIC_INDEX){
@@ -530,11 +1388,11 @@ void genAssignmentStmt(FILE* targetFile, STT* symbolTable, AST_NODE* assignmentN
             fprintf(targetFile, "lw $%d, %d($fp)\n", tempRegNum, lvaluePlace->place.inAddr.offset1);
 
             int tempRegNum2 = getExprNodeReg(targetFile, lvalueNode->child);
-            genAddOpInstr(targetFile, tempRegNum2, tempRegNum2, tempRegNum);
-            releaseReg(GR.regManager, tempRegNum);
-
-            fprintf(targetFile, "sw $%d, 0($%d)\n", rvalueRegNum, tempRegNum2);
+            genAddOpInstr(targetFile, tempRegNum, tempRegNum, tempRegNum2);
             releaseReg(GR.regManager, tempRegNum2);
+
+            fprintf(targetFile, "sw $%d, 0($%d)\n", rvalueRegNum, tempRegNum);
+            releaseReg(GR.regManager, tempRegNum);
         }
         // no release, let ExprNode(=) use this register
         // releaseReg(GR.regManager, rvalueRegNum);
@@ -544,23 +1402,31 @@ void genAssignmentStmt(FILE* targetFile, STT* symbolTable, AST_NODE* assignmentN
     }
     if(lvalueType == FLOAT_TYPE){
         /* lvalue = rvalue */
-        if(lvaluePlace->kind == STACK_TYPE && lvaluePlace->arrIdxKind == STATIC_INDEX)
+        if(assignmentNode->isDeadStore){
+            /* value is never read */
+        }
+        else if(lvaluePlace->kind == REG_TYPE){
+            if(lvaluePlace->place.regNum != rvalueRegNum)
+                fprintf(targetFile, "mov.s $f%d, $f%d\n", lvaluePlace->place.regNum, rvalueRegNum);
+        }
+        else if(lvaluePlace->kind == STACK_TYPE && lvaluePlace->arrIdxKind == STATIC_INDEX)
             fprintf(targetFile, "s.s $f%d, %d($fp)\n", rvalueRegNum, -1*lvaluePlace->place.stackOffset);
         else if(lvaluePlace->kind == STACK_TYPE && lvaluePlace->arrIdxKind == DYNAMIC_INDEX){
             int tempRegNum = getExprNodeReg(targetFile, lvalueNode->child);
-            fprintf(targetFile, "add $%d, $%d, $fp\n", tempRegNum, tempRegNum);
+            int addrRegNum = getAddrReg(targetFile, tempRegNum);
+            fprintf(targetFile, "add $%d, $%d, $fp\n", addrRegNum, tempRegNum);
             fprintf(targetFile, "s.s $f%d, %d($%d)\n", rvalueRegNum, 
-              -1*lvaluePlace->place.stackOffset, tempRegNum);
+              -1*lvaluePlace->place.stackOffset, addrRegNum);
+            releaseReg(GR.regManager, addrRegNum);
             releaseReg(GR.regManager, tempRegNum);
-        
         }
         else if(lvaluePlace->kind == GLOBAL_TYPE && lvaluePlace->arrIdxKind == STATIC_INDEX)
             fprintf(targetFile, "s.s $f%d, %s+%d\n", rvalueRegNum,
               lvaluePlace->place.data.label, lvaluePlace->place.data.offset);
         else if(lvaluePlace->kind == GLOBAL_TYPE && lvaluePlace->arrIdxKind == DYNAMIC_INDEX){
             int tempRegNum = getExprNodeReg(targetFile, lvalueNode->child);
-            fprintf(targetFile, "addi $%d, $%d, %s\n", tempRegNum, tempRegNum, lvalueNode->valPlace.place.data.label);
-            fprintf(targetFile, "s.s $f%d, 0($%d)\n", rvalueRegNum, tempRegNum);
+            fprintf(targetFile, "s.s $f%d, %s($%d)\n", rvalueRegNum,
+              lvalueNode->valPlace.place.data.label, tempRegNum);
             releaseReg(GR.regManager, tempRegNum); 
         }
         else if(lvaluePlace->kind == INDIRECT_ADDRESS && lvaluePlace->arrIdxKind == STATIC_INDEX){
@@ -575,8 +1441,8 @@ void genAssignmentStmt(FILE* targetFile, STT* symbolTable, AST_NODE* assignmentN
             fprintf(targetFile, "lw $%d, %d($fp)\n", tempRegNum, lvaluePlace->place.inAddr.offset1);
 
             int tempRegNum2 = getExprNodeReg(targetFile, lvalueNode->child);
-            genAddOpInstr(targetFile, tempRegNum2, tempRegNum2, tempRegNum);
-            releaseReg(GR.regManager, tempRegNum);
+            genAddOpInstr(targetFile, tempRegNum, tempRegNum, tempRegNum2);
+            releaseReg(GR.regManager, tempRegNum2);
 
             fprintf(targetFile, "s.s $f%d, 0($%d)\n", rvalueRegNum, tempRegNum);
             releaseReg(GR.regManager, tempRegNum);
@@ -588,31 +1454,65 @@ void genAssignmentStmt(FILE* targetFile, STT* symbolTable, AST_NODE* assignmentN
         setPlaceOfASTNodeToReg(assignmentNode, FLOAT_TYPE, rvalueRegNum);
         useReg(GR.FPRegManager, rvalueRegNum, assignmentNode);
     }
+
+    /* lvalue now holds the value of rvalue register */
+    assignValue(GR.valueTable, lvalueNode, rvalueRegNum,
+      !assignmentNode->isDeadStore && lvaluePlace->kind != REG_TYPE);
 }
 
 void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
     /* code generation for expression */
+    AST_NODE* operandNode;
+    BINARY_OPERATOR op;
+    int constValue, minValue, maxValue;
+    Value key;
+    int valueRegNum;
     if( exprNode->nodeType == CONST_VALUE_NODE ){
         /* store const value in register.
          * set register number in AST_NODE's place.
          */
         if( exprNode->semantic_value.const1->const_type == INTEGERC){
             int value = exprNode->semantic_value.const1->const_u.intval;
-            int intRegNum = getReg(GR.regManager, targetFile);
-            fprintf(targetFile, "li $%d, %d\n", intRegNum, value);
+            int intRegNum = findHoistedConst(GR.constPool, INT_TYPE, (unsigned int)value);
+            if(intRegNum != -1){
+                /* hoisted out of loop, pinned register */
+                setPlaceOfASTNodeToReg(exprNode, INT_TYPE, intRegNum);
+                return;
+            }
+            intRegNum = getReg(GR.regManager, targetFile);
+            genLoadIntConstInstr(targetFile, intRegNum, value);
 
             setPlaceOfASTNodeToReg(exprNode, INT_TYPE, intRegNum);
             useReg(GR.regManager, intRegNum, exprNode);
         }
         else if ( exprNode->semantic_value.const1->const_type == FLOATC ){
             float value = exprNode->semantic_value.const1->const_u.fval;
-            int floatRegNum = getReg(GR.FPRegManager, targetFile);
-            fprintf(targetFile, "li.s $f%d, %f\n", floatRegNum, value);
+            int floatRegNum = findHoistedConst(GR.constPool, FLOAT_TYPE, floatToBits(value));
+            if(floatRegNum != -1){
+                /* hoisted out of loop, pinned register */
+                setPlaceOfASTNodeToReg(exprNode, FLOAT_TYPE, floatRegNum);
+                return;
+            }
+            floatRegNum = getReg(GR.FPRegManager, targetFile);
+            genLoadFloatConstInstr(targetFile, floatRegNum, value);
 
             setPlaceOfASTNodeToReg(exprNode, FLOAT_TYPE, floatRegNum);
             useReg(GR.FPRegManager, floatRegNum, exprNode);
         }    
     }
+    else if( exprNode->nodeType == EXPR_NODE && getIntConstValue(exprNode, &constValue) ){
+        /* value ranges narrow int expression to one value */
+        int intRegNum = getReg(GR.regManager, targetFile);
+        genLoadIntConstInstr(targetFile, intRegNum, constValue);
+
+        setPlaceOfASTNodeToReg(exprNode, INT_TYPE, intRegNum);
+        useReg(GR.regManager, intRegNum, exprNode);
+    }
+    else if( exprNode->nodeType == EXPR_NODE && getExprValueKey(exprNode, &key) &&
+      (valueRegNum = findValue(GR.valueTable, &key)) != -1 ){
+        /* same expression computed earlier in basic block */
+        setPlaceOfASTNodeToReg(exprNode, key.type, valueRegNum);
+    }
     else if( exprNode->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT ){
         char* callingFuncName = exprNode->child->semantic_value.identifierSemanticValue.identifierName;
         if(strncmp(callingFuncName, "read", 4) == 0){
@@ -647,7 +1547,11 @@ void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
         ArrayIndexKind arrIdxKind = computeArrayOffset(targetFile, symbolTable, entry, exprNode, &arrayOffset);
 
         if(scope == LOCAL){
-            if(entry->place.kind == INDIRECT_ADDRESS){
+            if(entry->place.kind == REG_TYPE){
+                /* scalar promoted to variable register */
+                setPlaceOfASTNodeToReg(exprNode, type, entry->place.place.regNum);
+            }
+            else if(entry->place.kind == INDIRECT_ADDRESS){
                 int stackOffset = entry->place.place.inAddr.offset1;
                 if(type == INT_TYPE && arrIdxKind == STATIC_INDEX)
                     setPlaceOfASTNodeToIndirectAddr(exprNode, INT_TYPE, stackOffset, arrayOffset, STATIC_INDEX);
@@ -674,8 +1578,12 @@ void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
         }
 
         if(scope == GLOBAL){
+            if(entry->place.kind == REG_TYPE){
+                /* cached in variable register within loop */
+                setPlaceOfASTNodeToReg(exprNode, type, entry->place.place.regNum);
+            }
             /* GLOBAL_TYPE */
-            if(type == INT_TYPE && arrIdxKind == STATIC_INDEX)
+            else if(type == INT_TYPE && arrIdxKind == STATIC_INDEX)
                 setPlaceOfASTNodeToGlobalData(exprNode, INT_TYPE, entry->name, arrayOffset, STATIC_INDEX);
             else if(type == INT_TYPE && arrIdxKind == DYNAMIC_INDEX)
                 setPlaceOfASTNodeToGlobalData(exprNode, INT_TYPE, entry->name, 0, DYNAMIC_INDEX);
@@ -684,6 +1592,24 @@ void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
             else if(type == FLOAT_TYPE && arrIdxKind == DYNAMIC_INDEX)
                 setPlaceOfASTNodeToGlobalData(exprNode, FLOAT_TYPE, entry->name, 0, DYNAMIC_INDEX);
         }
+
+        /* array element cached in variable register within loop */
+        int cachedRegNum;
+        if(arrIdxKind == STATIC_INDEX && isArrayElement(exprNode) &&
+          (cachedRegNum = findCachedElement(GR.localVars, entry, arrayOffset)) != -1){
+            setPlaceOfASTNodeToReg(exprNode, type, cachedRegNum);
+            return;
+        }
+
+        /* value loaded earlier in basic block, lvalue keeps its memory place */
+        AST_NODE* parent = exprNode->parent;
+        int isLvalue = parent->nodeType == STMT_NODE &&
+          parent->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT && parent->child == exprNode;
+        if(!isLvalue && getValueKey(exprNode, &key) && (valueRegNum = findValue(GR.valueTable, &key)) != -1){
+            if(arrIdxKind == DYNAMIC_INDEX)
+                releaseExprNodeReg(exprNode->child);
+            setPlaceOfASTNodeToReg(exprNode, type, valueRegNum);
+        }
     }
     else if( exprNode->nodeType == EXPR_NODE ){
         if( exprNode->semantic_value.exprSemanticValue.kind == UNARY_OPERATION ){
@@ -693,29 +1619,73 @@ void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
             int childRegNum = getExprNodeReg(targetFile, exprNode->child);
 
             UNARY_OPERATOR op = exprNode->semantic_value.exprSemanticValue.op.unaryOp;
+            /* operand register is released first, result may take it */
             if(type == INT_TYPE){
+                releaseReg(GR.regManager, childRegNum);
                 int regNum = getReg(GR.regManager, targetFile);
 
                 genIntUnaryOpInstr(targetFile, op, regNum, childRegNum);
 
                 setPlaceOfASTNodeToReg(exprNode, INT_TYPE, regNum);
                 useReg(GR.regManager, regNum, exprNode);
-                releaseReg(GR.regManager, childRegNum);
             }
             else if(type == FLOAT_TYPE){
+                releaseReg(GR.FPRegManager, childRegNum);
                 int regNum = getReg(GR.FPRegManager, targetFile);
 
                 genFloatUnaryOpInstr(targetFile, op, regNum, childRegNum);
 
                 setPlaceOfASTNodeToReg(exprNode, FLOAT_TYPE, regNum);
                 useReg(GR.FPRegManager, regNum, exprNode);
-                releaseReg(GR.FPRegManager, childRegNum);
             }
         }
+        else if( exprNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+          (exprNode->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_AND ||
+          exprNode->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_OR) ){
+            _genLogicalValue(targetFile, symbolTable, exprNode);
+        }
+        else if( exprNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+          (operandNode = _getConstMulDivOperand(symbolTable, exprNode, &constValue)) ){
+            /* int multiplication or division by constant, lowered without mult/div */
+            genExpr(targetFile, symbolTable, operandNode);
+            int operandRegNum = getExprNodeReg(targetFile, operandNode);
+            releaseReg(GR.regManager, operandRegNum);
+            int regNum = getReg(GR.regManager, targetFile);
+
+            if(exprNode->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_MUL)
+                genMulConstInstr(targetFile, regNum, operandRegNum, constValue);
+            else
+                genDivConstInstr(targetFile, regNum, operandRegNum, constValue,
+                  getExprRange(operandNode, &minValue, &maxValue) && minValue >= 0);
+
+            setPlaceOfASTNodeToReg(exprNode, INT_TYPE, regNum);
+            useReg(GR.regManager, regNum, exprNode);
+        }
+        else if( exprNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+          (operandNode = _getImmOperand(symbolTable, exprNode, &op, &constValue, VALUE_TILE)) ){
+            /* int operation with 16-bit constant operand, constant isn't loaded to register */
+            genExpr(targetFile, symbolTable, operandNode);
+            int operandRegNum = getExprNodeReg(targetFile, operandNode);
+            releaseReg(GR.regManager, operandRegNum);
+            int regNum = getReg(GR.regManager, targetFile);
+
+            genIntImmOpInstr(targetFile, op, regNum, operandRegNum, constValue);
+
+            setPlaceOfASTNodeToReg(exprNode, INT_TYPE, regNum);
+            useReg(GR.regManager, regNum, exprNode);
+        }
         else if( exprNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION ){
-            /* exprNode = binary operator */
-            genExpr(targetFile, symbolTable, exprNode->child);
-            genExpr(targetFile, symbolTable, exprNode->child->rightSibling);
+            /* exprNode = binary operator.
+             * operand needing more registers goes first, unless order is observable by call */
+            AST_NODE* firstNode = exprNode->child;
+            AST_NODE* secondNode = exprNode->child->rightSibling;
+            if(_getRegNeed(secondNode) > _getRegNeed(firstNode) &&
+              !hasFuncCall(firstNode) && !hasFuncCall(secondNode)){
+                firstNode = secondNode;
+                secondNode = exprNode->child;
+            }
+            genExpr(targetFile, symbolTable, firstNode);
+            genExpr(targetFile, symbolTable, secondNode);
 
             /* implicit type conversion */
             DATA_TYPE type1 = getTypeOfExpr(symbolTable, exprNode->child);
@@ -739,29 +1709,36 @@ void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
                     int child2OriRegNum = getExprNodeReg(targetFile, exprNode->child->rightSibling);
                     child2RegNum = getReg(GR.FPRegManager, targetFile);
                     genIntToFloat(targetFile, child2RegNum, child2OriRegNum);
-                    releaseReg(GR.FPRegManager, child2OriRegNum);
+                    releaseReg(GR.regManager, child2OriRegNum);
 
                     child1RegNum = getExprNodeReg(targetFile, exprNode->child);
                 }
             }
             else{
+                /* loading second operand mustn't spill the first one */
+                RegisterManager* regManager = type == INT_TYPE ? GR.regManager : GR.FPRegManager;
                 child1RegNum = getExprNodeReg(targetFile, exprNode->child);
+                int isHeld = holdReg(regManager, child1RegNum);
                 child2RegNum = getExprNodeReg(targetFile, exprNode->child->rightSibling);
+                unholdReg(regManager, child1RegNum, isHeld);
             }
 
+            /* operand registers are released first, result may take one of them */
             BINARY_OPERATOR op = exprNode->semantic_value.exprSemanticValue.op.binaryOp;
             if(type == INT_TYPE){
+                releaseReg(GR.regManager, child1RegNum);
+                releaseReg(GR.regManager, child2RegNum);
                 int regNum = getReg(GR.regManager, targetFile);
 
                 genIntBinaryOpInstr(targetFile, op, regNum, child1RegNum, child2RegNum);
 
                 setPlaceOfASTNodeToReg(exprNode, INT_TYPE, regNum);
                 useReg(GR.regManager, regNum, exprNode);
-                releaseReg(GR.regManager, child1RegNum);
-                releaseReg(GR.regManager, child2RegNum);
             }
             else if(type == FLOAT_TYPE){
                 int regNum;
+                releaseReg(GR.FPRegManager, child1RegNum);
+                releaseReg(GR.FPRegManager, child2RegNum);
 
                 switch(op){
                     case BINARY_OP_ADD: case BINARY_OP_SUB: case BINARY_OP_MUL:
@@ -779,17 +1756,20 @@ void genExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
                         regNum = getReg(GR.regManager, targetFile);
                         genFloatBinaryRelaOpInstr(targetFile, op, regNum, child1RegNum, child2RegNum);
                         setPlaceOfASTNodeToReg(exprNode, INT_TYPE, regNum);
-                        useReg(GR.FPRegManager, regNum, exprNode);
+                        useReg(GR.regManager, regNum, exprNode);
                         break;
 
                     case BINARY_OP_AND: case BINARY_OP_OR: 
 
                         assert(0);
                 }
-                releaseReg(GR.FPRegManager, child1RegNum);
-                releaseReg(GR.FPRegManager, child2RegNum);
             }
         }
+
+        /* kept for later occurrences of the same expression */
+        if(exprNode->valPlace.kind == REG_TYPE && getExprValueKey(exprNode, &key) &&
+          (key.numOfUse = countLaterUses(exprNode)) > 0)
+            addValue(GR.valueTable, &key, exprNode->valPlace.place.regNum);
     }
 }
 
@@ -829,7 +1809,13 @@ int genShortRelExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode, int
     int isRelOp = 0;
     EXPR_KIND opKind;
     BINARY_OPERATOR binaryOp;
-    if(exprNode->nodeType == EXPR_NODE){
+    int outcome;
+    if(getKnownCondition(exprNode, &outcome)){
+        /* value ranges decide condition */
+        fprintf(targetFile, "j L%d\n", outcome ? trueLabel : falseLabel);
+        return 1;
+    }
+    if(exprNode->nodeType == EXPR_NODE){
         opKind = exprNode->semantic_value.exprSemanticValue.kind;
 
         if(opKind == BINARY_OPERATION){
@@ -841,7 +1827,9 @@ int genShortRelExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode, int
     }
 
     if(isRelOp == 0){
-        genAssignExpr(targetFile, symbolTable, exprNode);
+        /* relation tested by compare-branch tile is left to _normalEval */
+        if(!_isBranchTileCond(symbolTable, exprNode))
+            genAssignExpr(targetFile, symbolTable, exprNode);
         return 0;
     }
     else if(isRelOp == 1){
@@ -852,15 +1840,15 @@ int genShortRelExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode, int
               exprNode->child, child1TrueLabel, falseLabel);
 
             if(!isShortEval) /* j false if not exp1 */
-                _normalEval(targetFile, exprNode->child, falseLabel, FALSE_JUMP);
+                _normalEval(targetFile, symbolTable, exprNode->child, falseLabel, FALSE_JUMP);
 
-            fprintf(targetFile, "L%d:\n", child1TrueLabel);
+            genLabel(targetFile, child1TrueLabel);
 
             isShortEval = genShortRelExpr(targetFile, symbolTable, 
               exprNode->child->rightSibling, trueLabel, falseLabel);
 
             if(!isShortEval) /* j false if not exp2 */
-                _normalEval(targetFile, exprNode->child->rightSibling, falseLabel, FALSE_JUMP);
+                _normalEval(targetFile, symbolTable, exprNode->child->rightSibling, falseLabel, FALSE_JUMP);
 
             fprintf(targetFile, "j L%d\n", trueLabel);
         }
@@ -871,28 +1859,40 @@ int genShortRelExpr(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode, int
               exprNode->child, trueLabel, child1FalseLabel);
 
             if(!isShortEval) /* j true if exp1 */
-                _normalEval(targetFile, exprNode->child, trueLabel, TRUE_JUMP);
+                _normalEval(targetFile, symbolTable, exprNode->child, trueLabel, TRUE_JUMP);
 
-            fprintf(targetFile, "L%d:\n", child1FalseLabel);
+            genLabel(targetFile, child1FalseLabel);
 
             isShortEval = genShortRelExpr(targetFile, symbolTable, 
               exprNode->child->rightSibling, trueLabel, falseLabel);
 
             if(!isShortEval) /* j true if exp2 */
-                _normalEval(targetFile, exprNode->child->rightSibling, trueLabel, TRUE_JUMP);
+                _normalEval(targetFile, symbolTable, exprNode->child->rightSibling, trueLabel, TRUE_JUMP);
 
             fprintf(targetFile, "j L%d\n", falseLabel);
         }
     }
 }
 
-void _normalEval(FILE* targetFile, AST_NODE* childNode, int jumpLabel, int jumpCond){
+void _normalEval(FILE* targetFile, STT* symbolTable, AST_NODE* childNode, int jumpLabel, int jumpCond){
+    if(_isBranchTileCond(symbolTable, childNode)){
+        _genBranchTile(targetFile, symbolTable, childNode, jumpLabel, jumpCond);
+        return;
+    }
+
     int regNum = getExprNodeReg(targetFile, childNode);
+    int testRegNum = regNum;
+    if(childNode->valPlace.dataType == FLOAT_TYPE){
+        /* float is zero if its bits except sign are, -0.0 included */
+        fprintf(targetFile, "mfc1 $%d, $f%d\n", SCRATCH_REG_NUM, regNum);
+        fprintf(targetFile, "sll $%d, $%d, 1\n", SCRATCH_REG_NUM, SCRATCH_REG_NUM);
+        testRegNum = SCRATCH_REG_NUM;
+    }
 
     if(jumpCond == TRUE_JUMP)
-        fprintf(targetFile, "bne $%d, $0, L%d\n", regNum, jumpLabel); /* j jumpLabel if exp1 */
+        fprintf(targetFile, "bne $%d, $0, L%d\n", testRegNum, jumpLabel); /* j jumpLabel if exp1 */
     else if(jumpCond == FALSE_JUMP)
-        fprintf(targetFile, "beqz $%d, L%d\n", regNum, jumpLabel); /* j jumpLabel if not exp1 */
+        fprintf(targetFile, "beqz $%d, L%d\n", testRegNum, jumpLabel); /* j jumpLabel if not exp1 */
 
     if(childNode->valPlace.dataType == INT_TYPE)
         releaseReg(GR.regManager, regNum);
@@ -900,6 +1900,101 @@ void _normalEval(FILE* targetFile, AST_NODE* childNode, int jumpLabel, int jumpC
         releaseReg(GR.FPRegManager, regNum);
 }
 
+int _isBranchTileCond(STT* symbolTable, AST_NODE* condNode){
+    /* relation of same type operands or int logical negation, its value isn't materialized */
+    if(condNode->nodeType != EXPR_NODE)
+        return 0;
+    if(condNode->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return condNode->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_LOGICAL_NEGATION &&
+          getTypeOfExpr(symbolTable, condNode->child) == INT_TYPE;
+
+    switch(condNode->semantic_value.exprSemanticValue.op.binaryOp){
+        case BINARY_OP_EQ: case BINARY_OP_NE: case BINARY_OP_LT:
+        case BINARY_OP_GT: case BINARY_OP_LE: case BINARY_OP_GE:
+            return getTypeOfExpr(symbolTable, condNode->child) ==
+              getTypeOfExpr(symbolTable, condNode->child->rightSibling);
+        default:
+            return 0;
+    }
+}
+
+void _genBranchTile(FILE* targetFile, STT* symbolTable, AST_NODE* condNode, int jumpLabel, int jumpCond){
+    /* jump to jumpLabel if condNode is jumpCond, compare and branch by one tile */
+    TileKind kind = jumpCond == TRUE_JUMP ? TRUE_BRANCH_TILE : FALSE_BRANCH_TILE;
+    BINARY_OPERATOR op;
+    AST_NODE* operandNode;
+    int value, regNum;
+    if(condNode->semantic_value.exprSemanticValue.kind == UNARY_OPERATION){
+        genExpr(targetFile, symbolTable, condNode->child);
+        regNum = getExprNodeReg(targetFile, condNode->child);
+        genTile(targetFile, selectTile(INT_TYPE, UNARY_OP_LOGICAL_NEGATION, UNARY_TILE, 0, kind),
+          0, regNum, 0, 0, jumpLabel);
+        releaseReg(GR.regManager, regNum);
+        return;
+    }
+    if((operandNode = _getImmOperand(symbolTable, condNode, &op, &value, kind))){
+        genExpr(targetFile, symbolTable, operandNode);
+        regNum = getExprNodeReg(targetFile, operandNode);
+        genTile(targetFile, selectTile(INT_TYPE, op, REG_IMM_TILE, value, kind), 0, regNum, 0, value, jumpLabel);
+        releaseReg(GR.regManager, regNum);
+        return;
+    }
+
+    /* operand needing more registers goes first, unless order is observable by call */
+    AST_NODE* firstNode = condNode->child;
+    AST_NODE* secondNode = condNode->child->rightSibling;
+    if(_getRegNeed(secondNode) > _getRegNeed(firstNode) &&
+      !hasFuncCall(firstNode) && !hasFuncCall(secondNode)){
+        firstNode = secondNode;
+        secondNode = condNode->child;
+    }
+    genExpr(targetFile, symbolTable, firstNode);
+    genExpr(targetFile, symbolTable, secondNode);
+
+    DATA_TYPE type = getTypeOfExpr(symbolTable, condNode->child);
+    RegisterManager* regManager = type == INT_TYPE ? GR.regManager : GR.FPRegManager;
+    int child1RegNum = getExprNodeReg(targetFile, condNode->child);
+    int isHeld = holdReg(regManager, child1RegNum);
+    int child2RegNum = getExprNodeReg(targetFile, condNode->child->rightSibling);
+    unholdReg(regManager, child1RegNum, isHeld);
+
+    op = condNode->semantic_value.exprSemanticValue.op.binaryOp;
+    genTile(targetFile, selectTile(type, op, REG_REG_TILE, 0, kind), 0, child1RegNum, child2RegNum, 0, jumpLabel);
+    releaseReg(regManager, child1RegNum);
+    releaseReg(regManager, child2RegNum);
+}
+
+void _spillTemps(FILE* targetFile, RegisterManager* regManager){
+    /* temporaries which live across a call or a branch, registers kept by value numbering stay */
+    int i;
+    for(i=0; i<regManager->numOfReg; i++){
+        if(regManager->regUser[i] && !regManager->regPinned[i])
+            spillReg(regManager, i, targetFile);
+    }
+}
+
+void _genLogicalValue(FILE* targetFile, STT* symbolTable, AST_NODE* exprNode){
+    /* 0/1 value of && or ||, right operand isn't evaluated when left one decides.
+     * registers of enclosing expression mustn't be spilled on one path only,
+     * so they are spilled once ahead of both paths */
+    int trueLabel = GR.labelCounter++;
+    int falseLabel = GR.labelCounter++;
+
+    int regNum = getReg(GR.regManager, targetFile);
+    _spillTemps(targetFile, GR.regManager);
+    _spillTemps(targetFile, GR.FPRegManager);
+
+    /* false path skips setting it */
+    genLoadIntConstInstr(targetFile, regNum, 0);
+    genShortRelExpr(targetFile, symbolTable, exprNode, trueLabel, falseLabel);
+    genLabel(targetFile, trueLabel);
+    genLoadIntConstInstr(targetFile, regNum, 1);
+    genLabel(targetFile, falseLabel);
+
+    setPlaceOfASTNodeToReg(exprNode, INT_TYPE, regNum);
+    useReg(GR.regManager, regNum, exprNode);
+}
+
 void genFuncCall(FILE* targetFile, STT* symbolTable, AST_NODE* funcCallNode){
     /* codegen for jumping to the function(label)
      * HW6 Extension: with Parameter function call */
@@ -914,8 +2009,13 @@ void genFuncCall(FILE* targetFile, STT* symbolTable, AST_NODE* funcCallNode){
         numOfPara = genParaList(targetFile, symbolTable, paraNode);
     }
     
+    /* callee doesn't save FP registers */
+    _spillTemps(targetFile, GR.FPRegManager);
+
     char *funcName = funcCallNode->child->semantic_value.identifierSemanticValue.identifierName;
+    genFlushCachedGlobals(targetFile, funcName);
     fprintf(targetFile, "jal %s\n",funcName);
+    killValuesAtCall(GR.valueTable, funcCallNode);
 
     /* pop out all the parameter if exist */
     fprintf(targetFile, "addi $sp, $sp, %d\n", 4 * numOfPara);
@@ -946,7 +2046,7 @@ void _genParaList(FILE* targetFile, STT* symbolTable, AST_NODE* paraNode,
         char* varName = paraNode->semantic_value.identifierSemanticValue.identifierName;
         SymbolTableEntry* entry = lookupSymbol(symbolTable, varName);
         TypeDescriptor* type = entry->type;
-        dimension = type->dimension;
+        dimension = type->dimension - countRightSibling(paraNode->child); /* element is passed by value */
     }
 
     if( dimension != 0 ){
@@ -1004,13 +2104,13 @@ void _genParaList(FILE* targetFile, STT* symbolTable, AST_NODE* paraNode,
                 /* pass indirect address array address in stack(for indirect address) */
                 if(arrIdxKind == STATIC_INDEX){
                     int stackOffset = entry->place.place.inAddr.offset1;
-                    fprintf(targetFile, "lw $%d, %d($fp)\n", regNum, -1*stackOffset);
+                    fprintf(targetFile, "lw $%d, %d($fp)\n", regNum, stackOffset);
                     fprintf(targetFile, "addi $%d, $%d, %d\n", regNum, regNum, arrayOffset);
                     fprintf(targetFile, "sw $%d, 0($sp)\n", regNum);
                 }
                 else if(arrIdxKind == DYNAMIC_INDEX){
                     int stackOffset = entry->place.place.inAddr.offset1;
-                    fprintf(targetFile, "lw $%d, %d($fp)\n", regNum, -1*stackOffset);
+                    fprintf(targetFile, "lw $%d, %d($fp)\n", regNum, stackOffset);
                     int offsetRegNum = getExprNodeReg(targetFile, paraNode->child);
                     fprintf(targetFile, "add $%d, $%d, $%d\n", regNum, regNum, offsetRegNum);
                     fprintf(targetFile, "sw $%d, 0($sp)\n", regNum);
@@ -1088,7 +2188,27 @@ void genProcessFloatReturnValue(FILE* targetFile, AST_NODE* exprNode){
 int getExprNodeReg(FILE* targetFile, AST_NODE* exprNode){
     /* return register or FP register of expression value(from exprNode->valPlace).
      * return -1 if AST_NODE doesn't have place.
-     * For value in memory, load it to register */
+     * For value in memory, load it to register, the loaded variable is kept for reuse */
+    if(exprNode->valPlace.kind == REG_TYPE)
+        return exprNode->valPlace.place.regNum;
+
+    Value key;
+    int isValue = getValueKey(exprNode, &key);
+    int regNum;
+    if(isValue && (regNum = findValue(GR.valueTable, &key)) != -1){
+        /* loaded by an operand before this one */
+        if(exprNode->valPlace.arrIdxKind == DYNAMIC_INDEX)
+            releaseExprNodeReg(exprNode->child);
+        setPlaceOfASTNodeToReg(exprNode, key.type, regNum);
+        return regNum;
+    }
+    regNum = _loadExprNodeReg(targetFile, exprNode);
+    if(isValue && regNum != -1)
+        addValue(GR.valueTable, &key, regNum);
+    return regNum;
+}
+
+int _loadExprNodeReg(FILE* targetFile, AST_NODE* exprNode){
     if(exprNode->valPlace.kind == REG_TYPE){
         return exprNode->valPlace.place.regNum;
     }
@@ -1101,8 +2221,8 @@ int getExprNodeReg(FILE* targetFile, AST_NODE* exprNode){
                 fprintf(targetFile, "lw $%d, %d($fp)\n", regNum, -1*stackOffset);
             else if(exprNode->valPlace.arrIdxKind == DYNAMIC_INDEX){
                 int dyIndexRegNum = getExprNodeReg(targetFile, exprNode->child);
-                fprintf(targetFile, "add $%d, $%d, $fp\n", dyIndexRegNum, dyIndexRegNum);
-                fprintf(targetFile, "lw $%d, %d($%d)\n", regNum, -1*stackOffset, dyIndexRegNum);
+                fprintf(targetFile, "add $%d, $%d, $fp\n", regNum, dyIndexRegNum);
+                fprintf(targetFile, "lw $%d, %d($%d)\n", regNum, -1*stackOffset, regNum);
                 releaseReg(GR.regManager, dyIndexRegNum);
             }
 
@@ -1117,8 +2237,10 @@ int getExprNodeReg(FILE* targetFile, AST_NODE* exprNode){
                 fprintf(targetFile, "l.s $f%d, %d($fp)\n", regNum, -1*stackOffset);
             else if(exprNode->valPlace.arrIdxKind == DYNAMIC_INDEX){
                 int dyIndexRegNum = getExprNodeReg(targetFile, exprNode->child);
-                fprintf(targetFile, "add $%d, $%d, $fp\n", dyIndexRegNum, dyIndexRegNum);
-                fprintf(targetFile, "l.s $f%d, %d($%d)\n", regNum, -1*stackOffset, dyIndexRegNum);
+                int addrRegNum = getAddrReg(targetFile, dyIndexRegNum);
+                fprintf(targetFile, "add $%d, $%d, $fp\n", addrRegNum, dyIndexRegNum);
+                fprintf(targetFile, "l.s $f%d, %d($%d)\n", regNum, -1*stackOffset, addrRegNum);
+                releaseReg(GR.regManager, addrRegNum);
                 releaseReg(GR.regManager, dyIndexRegNum);
             }
 
@@ -1136,8 +2258,7 @@ int getExprNodeReg(FILE* targetFile, AST_NODE* exprNode){
                 fprintf(targetFile, "lw $%d, %s+%d\n", regNum, place->place.data.label, place->place.data.offset);
             else if(exprNode->valPlace.arrIdxKind == DYNAMIC_INDEX){
                 int dyIndexRegNum = getExprNodeReg(targetFile, exprNode->child); 
-                fprintf(targetFile, "addi $%d, $%d, %s\n", dyIndexRegNum, dyIndexRegNum, place->place.data.label);
-                fprintf(targetFile, "lw $%d, 0($%d)\n", regNum, dyIndexRegNum);
+                fprintf(targetFile, "lw $%d, %s($%d)\n", regNum, place->place.data.label, dyIndexRegNum);
                 releaseReg(GR.regManager, dyIndexRegNum);
             }
 
@@ -1152,8 +2273,7 @@ int getExprNodeReg(FILE* targetFile, AST_NODE* exprNode){
                 fprintf(targetFile, "l.s $f%d, %s+%d\n", regNum, place->place.data.label, place->place.data.offset);
             else if(exprNode->valPlace.arrIdxKind == DYNAMIC_INDEX){
                 int dyIndexRegNum = getExprNodeReg(targetFile, exprNode->child); 
-                fprintf(targetFile, "addi $%d, $%d, %s\n", dyIndexRegNum, dyIndexRegNum, place->place.data.label);
-                fprintf(targetFile, "l.s $f%d, 0($%d)\n", regNum, dyIndexRegNum);
+                fprintf(targetFile, "l.s $f%d, %s($%d)\n", regNum, place->place.data.label, dyIndexRegNum);
                 releaseReg(GR.regManager, dyIndexRegNum);
             }
 
@@ -1245,6 +2365,13 @@ ArrayIndexKind computeArrayOffset(FILE* targetFile, STT* symbolTable, SymbolTabl
     else{
         /* dynamic array index, store in register attach on array first child(index)'s place. */ 
         int regNum = 0; 
+        Value key = {OFFSET_VALUE, symbolEntry, 0, FirstChild, INT_TYPE, 0, 0, 0, NULL, 0};
+        int isValue = isPureIndex(FirstChild);
+        if(isValue && (regNum = findValue(GR.valueTable, &key)) != -1){
+            /* same index computed earlier in basic block */
+            setPlaceOfASTNodeToReg(FirstChild, INT_TYPE, regNum);
+            return DYNAMIC_INDEX;
+        }
         for(i = 0; i < dimension; i++){
         // regNum(arrayOffset) = sum( value of dimenChild * offsetOfEachDimension[i] for i in (0, dimension));
 
@@ -1255,19 +2382,21 @@ ArrayIndexKind computeArrayOffset(FILE* targetFile, STT* symbolTable, SymbolTabl
             // regNum(arrayOffset) += value of dimenChild * offsetOfEachDimension[i];
             genExpr(targetFile, symbolTable, dimenChild);
 
-            // constRegNum = offsetOfEachDimension[i]
+            // childRegNum = value of dimenChild * offsetOfEachDimension[i]
+            // (product goes to constRegNum, index register may be a pinned constant)
+            int indexRegNum = getExprNodeReg(targetFile, dimenChild);
             int constRegNum = getReg(GR.regManager, targetFile);
-            fprintf(targetFile, "li $%d, %d\n", constRegNum, offsetOfEachDimension[i]);
-
-            // childRegNum = value of dimenChild * constRegNum
-            int childRegNum = getExprNodeReg(targetFile, dimenChild);
-            genMulOpInstr(targetFile, childRegNum, childRegNum, constRegNum);
-            releaseReg(GR.regManager, constRegNum);
+            if(!genMulConstInstr(targetFile, constRegNum, indexRegNum, offsetOfEachDimension[i])){
+                genLoadIntConstInstr(targetFile, constRegNum, offsetOfEachDimension[i]);
+                genMulOpInstr(targetFile, constRegNum, indexRegNum, constRegNum);
+            }
+            releaseReg(GR.regManager, indexRegNum);
+            int childRegNum = constRegNum;
 
             // regNum += childRegNum
             if(i == 0){
                 regNum = getReg(GR.regManager, targetFile);
-                fprintf(targetFile, "li $%d, 0\n", regNum);
+                genLoadIntConstInstr(targetFile, regNum, 0);
             }
             else
                 regNum = getExprNodeReg(targetFile, FirstChild);
@@ -1281,6 +2410,8 @@ ArrayIndexKind computeArrayOffset(FILE* targetFile, STT* symbolTable, SymbolTabl
             dimenChild = dimenChild->rightSibling;
         }
 
+        if(isValue)
+            addValue(GR.valueTable, &key, regNum);
         return DYNAMIC_INDEX;
     }
 }
@@ -1304,6 +2435,7 @@ void RMinit(RegisterManager* pThis, int numOfReg, int firstRegNum){
     int i;
     for(i=0; i<pThis->numOfReg; i++){
         pThis->regFull[i] = 0;
+        pThis->regPinned[i] = 0;
         pThis->regUser[i] = NULL;
     }
     pThis->lastReg = 0;
@@ -1320,9 +2452,15 @@ int getReg(RegisterManager* pThis, FILE* targetFile){
         return regNum;
     }
     
-    /* if no empty register, spill one register out */
+    /* if no empty register, drop a value kept for reuse, or spill one register out */
+    if(evictValue(GR.valueTable, pThis)){
+        regIndex = findEmptyReg(pThis);
+        pThis->regFull[regIndex] = 1;
+        return regIndex + pThis->firstRegNum;
+    }
     regIndex = findEarlestUsedReg(pThis);
     spillReg(pThis, regIndex, targetFile);
+    pThis->regFull[regIndex] = 1;
     int regNum = regIndex + pThis->firstRegNum; // s0 = r16 in mips
     return regNum;
 }
@@ -1331,7 +2469,8 @@ void useReg(RegisterManager* pThis, int regNum, AST_NODE* nodeUseThisReg){
     /* AST_NODE use register, build link from register Manager to AST_NODE */
     int regIndex = regNum - pThis->firstRegNum;
     /* border check */
-    assert(regIndex >= 0);
+    if(regIndex < 0)
+        return; /* variable register, not managed */
     assert(regIndex <= pThis->numOfReg);
 
     pThis->regUser[regIndex] = nodeUseThisReg;
@@ -1342,9 +2481,12 @@ void releaseReg(RegisterManager* pThis, int regNum){
      * break link from Register Manager to AST_NODE */
     int regIndex = regNum - pThis->firstRegNum;
     /* border check */
-    assert(regIndex >= 0);
+    if(regIndex < 0)
+        return; /* variable register, not managed */
     assert(regIndex <= pThis->numOfReg);
 
+    if(pThis->regPinned[regIndex])
+        return;
     pThis->regFull[regIndex] = 0;
     pThis->regUser[regIndex] = NULL;
 }
@@ -1352,23 +2494,87 @@ void releaseReg(RegisterManager* pThis, int regNum){
 int findEmptyReg(RegisterManager* pThis){
     /* find the nearest(compare to lastReg) empty register.
      * if no empty register. return -1 */
-    int index = (pThis->lastReg+1) % pThis->numOfReg;
-    while(index != pThis->lastReg){
+    int i, index = pThis->lastReg;
+    for(i = 0; i < pThis->numOfReg; i++){
+        index = (index+1) % pThis->numOfReg;
         if(!pThis->regFull[index]){
             pThis->lastReg = index;
             return index;
         }
-
-        index = (index+1) % pThis->numOfReg;
     }
     return -1;
 }
 
 int findEarlestUsedReg(RegisterManager* pThis){
     /* find the earlest allocated register.
-     * the function used when all register is full. */
-    pThis->lastReg = (pThis->lastReg + 1) % pThis->numOfReg;
-    return pThis->lastReg;
+     * the function used when all register is full.
+     * register without user is being computed by caller of getReg, it can't be spilled */
+    int i;
+    for(i = 0; i < pThis->numOfReg; i++){
+        pThis->lastReg = (pThis->lastReg + 1) % pThis->numOfReg;
+        if(!pThis->regPinned[pThis->lastReg] && pThis->regUser[pThis->lastReg])
+            return pThis->lastReg;
+    }
+    assert(0);
+    return -1;
+}
+
+void pinReg(RegisterManager* pThis, int regNum){
+    /* pin a register got from getReg, it keeps its value until unpinReg */
+    int regIndex = regNum - pThis->firstRegNum;
+    assert(regIndex >= 0);
+    assert(regIndex < pThis->numOfReg);
+
+    pThis->regFull[regIndex] = 1;
+    pThis->regPinned[regIndex] = 1;
+    pThis->regUser[regIndex] = NULL;
+}
+
+void unpinReg(RegisterManager* pThis, int regNum){
+    int regIndex = regNum - pThis->firstRegNum;
+    assert(regIndex >= 0);
+    assert(regIndex < pThis->numOfReg);
+
+    pThis->regPinned[regIndex] = 0;
+    releaseReg(pThis, regNum);
+}
+
+int holdReg(RegisterManager* pThis, int regNum){
+    /* keep register with its user from being spilled for a while.
+     * return 0 if it is never spilled anyway, pass the result to unholdReg */
+    int regIndex = regNum - pThis->firstRegNum;
+    if(regIndex < 0 || pThis->regPinned[regIndex])
+        return 0;
+    pThis->regPinned[regIndex] = 1;
+    return 1;
+}
+
+void unholdReg(RegisterManager* pThis, int regNum, int isHeld){
+    if(isHeld)
+        pThis->regPinned[regNum - pThis->firstRegNum] = 0;
+}
+
+int isPinnedReg(RegisterManager* pThis, int regNum){
+    int regIndex = regNum - pThis->firstRegNum;
+    if(regIndex < 0)
+        return 1;
+    return pThis->regPinned[regIndex];
+}
+
+int getAddrReg(FILE* targetFile, int offsetRegNum){
+    if(isPinnedReg(GR.regManager, offsetRegNum))
+        return getReg(GR.regManager, targetFile);
+    return offsetRegNum;
+}
+
+void releaseExprNodeReg(AST_NODE* exprNode){
+    if(exprNode->valPlace.kind != REG_TYPE)
+        return;
+
+    if(exprNode->valPlace.dataType == INT_TYPE)
+        releaseReg(GR.regManager, exprNode->valPlace.place.regNum);
+    else if(exprNode->valPlace.dataType == FLOAT_TYPE)
+        releaseReg(GR.FPRegManager, exprNode->valPlace.place.regNum);
 }
 
 void spillReg(RegisterManager* pThis, int regIndex, FILE* targetFile){
@@ -1383,9 +2589,16 @@ void spillReg(RegisterManager* pThis, int regIndex, FILE* targetFile){
         ExpValPlace* place = &(pThis->regUser[regIndex]->valPlace);
 
         /* store value of register into stack */
-        fprintf(targetFile, "sw $%d, %d($fp)\n", regNum, -1*(GR.stackTop + 4));
-        place->dataType = INT_TYPE;
+        if(pThis == GR.FPRegManager){
+            fprintf(targetFile, "s.s $f%d, %d($fp)\n", regNum, -1*(GR.stackTop + 4));
+            place->dataType = FLOAT_TYPE;
+        }
+        else{
+            fprintf(targetFile, "sw $%d, %d($fp)\n", regNum, -1*(GR.stackTop + 4));
+            place->dataType = INT_TYPE;
+        }
         place->kind = STACK_TYPE;
+        place->arrIdxKind = STATIC_INDEX;
         place->place.stackOffset = GR.stackTop + 4;
         GR.stackTop += 4;
     }
@@ -1396,29 +2609,619 @@ void spillReg(RegisterManager* pThis, int regIndex, FILE* targetFile){
 /*** Constant String Implementation ***/
 void initConstStringSet(ConstStringSet* pThis){
     pThis->numOfConstString = 0;
+    pThis->capacity = INIT_CON_STRING_SIZE;
+    pThis->constStrings = malloc(sizeof(ConstStringPair) * pThis->capacity);
+    pThis->bucket = malloc(sizeof(int) * pThis->capacity);
+    assert(pThis->constStrings && pThis->bucket);
+
+    int i;
+    for(i=0; i<pThis->capacity; i++)
+        pThis->bucket[i] = -1;
+}
+
+void finConstStringSet(ConstStringSet* pThis){
+    int i;
+    for(i=0; i<pThis->numOfConstString; i++)
+        free(pThis->constStrings[i].unitOffset);
+    free(pThis->constStrings);
+    free(pThis->bucket);
+
+    pThis->numOfConstString = 0;
+    pThis->capacity = 0;
+    pThis->constStrings = NULL;
+    pThis->bucket = NULL;
 }
 
-void addConstString(ConstStringSet* pThis, int labelNum, char* string){
-    pThis->constStrings[pThis->numOfConstString].labelNum = labelNum;
-    pThis->constStrings[pThis->numOfConstString].string = string;
-    pThis->numOfConstString++;
+unsigned int _hashString(char* string){
+    unsigned int hash = 5381;
+    for(; *string; string++)
+        hash = hash * 33 + (unsigned char)*string;
+    return hash;
 }
 
-void genConstStrings(ConstStringSet* pThis, FILE* targetFile){
+void _growConstStringSet(ConstStringSet* pThis){
+    /* double the capacity, then rebuild hash buckets */
+    pThis->capacity *= 2;
+    pThis->constStrings = realloc(pThis->constStrings, sizeof(ConstStringPair) * pThis->capacity);
+    free(pThis->bucket);
+    pThis->bucket = malloc(sizeof(int) * pThis->capacity);
+    assert(pThis->constStrings && pThis->bucket);
+
     int i;
+    for(i=0; i<pThis->capacity; i++)
+        pThis->bucket[i] = -1;
     for(i=0; i<pThis->numOfConstString; i++){
         ConstStringPair* pair = &(pThis->constStrings[i]);
-        fprintf(targetFile, "L%d: .asciiz %s\n", pair->labelNum, pair->string);
+        int bucketIndex = pair->hash % pThis->capacity;
+        pair->hashNext = pThis->bucket[bucketIndex];
+        pThis->bucket[bucketIndex] = i;
+    }
+}
+
+void _splitStringUnit(ConstStringPair* pair){
+    /* "a\nb" has 3 units: a, \n, b. quotes are not units */
+    int length = strlen(pair->string);
+    pair->unitOffset = malloc(sizeof(int) * length);
+    pair->numOfUnit = 0;
+
+    int i = 1;
+    while(i < length - 1){
+        pair->unitOffset[pair->numOfUnit++] = i;
+        if(pair->string[i] == '\\' && i + 1 < length - 1)
+            i += 2;
+        else
+            i += 1;
+    }
+}
+
+int addConstString(ConstStringSet* pThis, char* string){
+    unsigned int hash = _hashString(string);
+
+    int index = pThis->bucket[hash % pThis->capacity];
+    while(index != -1){
+        ConstStringPair* pair = &(pThis->constStrings[index]);
+        if(pair->hash == hash && strcmp(pair->string, string) == 0)
+            return pair->labelNum;
+        index = pair->hashNext;
+    }
+
+    if(pThis->numOfConstString == pThis->capacity)
+        _growConstStringSet(pThis);
+
+    index = pThis->numOfConstString++;
+    ConstStringPair* pair = &(pThis->constStrings[index]);
+    pair->labelNum = GR.labelCounter++;
+    pair->string = string;
+    pair->hash = hash;
+    pair->hostIndex = -1;
+    _splitStringUnit(pair);
+
+    int bucketIndex = hash % pThis->capacity;
+    pair->hashNext = pThis->bucket[bucketIndex];
+    pThis->bucket[bucketIndex] = index;
+
+    return pair->labelNum;
+}
+
+int _unitLength(ConstStringPair* pair, int unitIndex){
+    int end = strlen(pair->string) - 1; /* closing quote */
+    if(unitIndex + 1 < pair->numOfUnit)
+        end = pair->unitOffset[unitIndex + 1];
+    return end - pair->unitOffset[unitIndex];
+}
+
+int _compareUnit(ConstStringPair* pair1, int unitIndex1, ConstStringPair* pair2, int unitIndex2){
+    int length1 = _unitLength(pair1, unitIndex1);
+    int length2 = _unitLength(pair2, unitIndex2);
+    int minLength = length1 < length2 ? length1 : length2;
+
+    int cmp = memcmp(pair1->string + pair1->unitOffset[unitIndex1], 
+      pair2->string + pair2->unitOffset[unitIndex2], minLength);
+    if(cmp != 0)
+        return cmp;
+    return length1 - length2;
+}
+
+ConstStringSet* _sortingStringSet; /* qsort has no context argument */
+
+int _compareReversedString(const void* index1, const void* index2){
+    /* order strings by their units from the end, a suffix is placed before the longer string */
+    ConstStringPair* pair1 = &(_sortingStringSet->constStrings[*(const int*)index1]);
+    ConstStringPair* pair2 = &(_sortingStringSet->constStrings[*(const int*)index2]);
+
+    int i = pair1->numOfUnit - 1, j = pair2->numOfUnit - 1;
+    for(; i >= 0 && j >= 0; i--, j--){
+        int cmp = _compareUnit(pair1, i, pair2, j);
+        if(cmp != 0)
+            return cmp;
+    }
+    return (i >= 0) - (j >= 0);
+}
+
+int _isSuffixString(ConstStringPair* suffix, ConstStringPair* pair){
+    if(suffix->numOfUnit > pair->numOfUnit)
+        return 0;
+
+    int i = suffix->numOfUnit - 1, j = pair->numOfUnit - 1;
+    for(; i >= 0; i--, j--){
+        if(_compareUnit(suffix, i, pair, j) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+void genConstStrings(ConstStringSet* pThis, FILE* targetFile){
+    /* suffix sharing: after sorting by reversed string, a string which is a suffix of
+     * another one is a suffix of its next string. it is emitted as a label inside the
+     * longest string of the chain:
+     *     L1: .ascii "Hello, "
+     *     L2: .asciiz "world\n"
+     */
+    int numOfString = pThis->numOfConstString;
+    if(numOfString == 0)
+        return;
+
+    int* order = malloc(sizeof(int) * numOfString);
+    int* nextInHost = malloc(sizeof(int) * numOfString);
+    int* firstInHost = malloc(sizeof(int) * numOfString);
+    int i;
+    for(i=0; i<numOfString; i++){
+        order[i] = i;
+        nextInHost[i] = -1;
+        firstInHost[i] = -1;
+    }
+
+    _sortingStringSet = pThis;
+    qsort(order, numOfString, sizeof(int), _compareReversedString);
+    for(i=numOfString-2; i>=0; i--){
+        ConstStringPair* pair = &(pThis->constStrings[order[i]]);
+        ConstStringPair* next = &(pThis->constStrings[order[i+1]]);
+        if(_isSuffixString(pair, next))
+            pair->hostIndex = (next->hostIndex == -1) ? order[i+1] : next->hostIndex;
+    }
+
+    /* suffixes of the same host, longer suffix first */
+    for(i=0; i<numOfString; i++){
+        int index = order[i];
+        int hostIndex = pThis->constStrings[index].hostIndex;
+        if(hostIndex != -1){
+            nextInHost[index] = firstInHost[hostIndex];
+            firstInHost[hostIndex] = index;
+        }
+    }
+
+    fprintf(targetFile, ".data\n");
+    for(i=0; i<numOfString; i++){
+        ConstStringPair* host = &(pThis->constStrings[i]);
+        if(host->hostIndex != -1)
+            continue;
+
+        int start = 1; /* skip quote */
+        int end = strlen(host->string) - 1;
+        int labelNum = host->labelNum;
+        int suffixIndex;
+        for(suffixIndex = firstInHost[i]; suffixIndex != -1; suffixIndex = nextInHost[suffixIndex]){
+            ConstStringPair* suffix = &(pThis->constStrings[suffixIndex]);
+            int split = end;
+            if(suffix->numOfUnit > 0)
+                split = host->unitOffset[host->numOfUnit - suffix->numOfUnit];
+
+            fprintf(targetFile, "L%d: .ascii \"%.*s\"\n", labelNum, split - start, host->string + start);
+            start = split;
+            labelNum = suffix->labelNum;
+        }
+        fprintf(targetFile, "L%d: .asciiz \"%.*s\"\n", labelNum, end - start, host->string + start);
+    }
+
+    free(order);
+    free(nextInHost);
+    free(firstInHost);
+}
+
+/*** Constant Pool Implementation ***/
+void initConstPool(ConstPool* pThis){
+    int i;
+    for(i=0; i<CONST_POOL_HASH_SIZE; i++)
+        pThis->bucket[i] = NULL;
+    pThis->head = NULL;
+    pThis->tail = NULL;
+    pThis->numOfConst = 0;
+    pThis->numOfHoisted = 0;
+}
+
+void finConstPool(ConstPool* pThis){
+    ConstPoolEntry* entry = pThis->head;
+    while(entry){
+        ConstPoolEntry* next = entry->next;
+        free(entry);
+        entry = next;
+    }
+    initConstPool(pThis);
+}
+
+unsigned int floatToBits(float value){
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+int addConstFloat(ConstPool* pThis, float value){
+    /* constants are keyed by bit pattern, so 0.0 and -0.0 are different entries */
+    unsigned int bits = floatToBits(value);
+    unsigned int hash = (bits ^ (bits >> 16)) % CONST_POOL_HASH_SIZE;
+
+    ConstPoolEntry* entry = pThis->bucket[hash];
+    while(entry){
+        if(entry->bits == bits)
+            return entry->labelNum;
+        entry = entry->hashNext;
+    }
+
+    entry = malloc(sizeof(ConstPoolEntry));
+    entry->labelNum = GR.labelCounter++;
+    entry->bits = bits;
+    entry->hashNext = pThis->bucket[hash];
+    entry->next = NULL;
+    pThis->bucket[hash] = entry;
+
+    if(pThis->tail)
+        pThis->tail->next = entry;
+    else
+        pThis->head = entry;
+    pThis->tail = entry;
+    pThis->numOfConst++;
+
+    return entry->labelNum;
+}
+
+void genConstPool(ConstPool* pThis, FILE* targetFile){
+    ConstPoolEntry* entry;
+    if(pThis->numOfConst == 0)
+        return;
+
+    fprintf(targetFile, ".data\n");
+    for(entry = pThis->head; entry; entry = entry->next)
+        fprintf(targetFile, "L%d: .word 0x%08x\n", entry->labelNum, entry->bits);
+}
+
+int findHoistedConst(ConstPool* pThis, DATA_TYPE type, unsigned int bits){
+    int i;
+    for(i=pThis->numOfHoisted-1; i>=0; i--){
+        HoistedConst* hoisted = &(pThis->hoisted[i]);
+        if(hoisted->type == type && hoisted->bits == bits)
+            return hoisted->regNum;
+    }
+    return -1;
+}
+
+int isImm16(int value){
+    return value >= -32768 && value <= 32767;
+}
+
+int isUImm16(int value){
+    return value >= 0 && value <= 65535;
+}
+
+void _collectLoopConsts(AST_NODE* node, HoistedConst* candidates, int* numOfCandidates, int* hasFuncCall){
+    /* collect constants worth keeping in register through the loop:
+     * every float constant (l.s from pool) and int constants that need lui + ori */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == CONST_VALUE_NODE){
+            CON_Type* constant = node->semantic_value.const1;
+            HoistedConst candidate;
+            if(constant->const_type == FLOATC){
+                candidate.type = FLOAT_TYPE;
+                candidate.bits = floatToBits(constant->const_u.fval);
+            }
+            else if(constant->const_type == INTEGERC){
+                int value = constant->const_u.intval;
+                if(isImm16(value) || isUImm16(value) || (value & 0xffff) == 0)
+                    continue;
+                candidate.type = INT_TYPE;
+                candidate.bits = (unsigned int)value;
+            }
+            else
+                continue;
+
+            int i;
+            for(i=0; i<*numOfCandidates; i++){
+                if(candidates[i].type == candidate.type && candidates[i].bits == candidate.bits)
+                    break;
+            }
+            if(i == *numOfCandidates && *numOfCandidates < MAX_HOISTED_CONST){
+                candidates[i] = candidate;
+                (*numOfCandidates)++;
+            }
+            continue;
+        }
+
+        if(node->nodeType == STMT_NODE &&
+          node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT){
+            char* funcName = node->child->semantic_value.identifierSemanticValue.identifierName;
+            if(strcmp(funcName, "read") != 0 && strcmp(funcName, "fread") != 0 &&
+              strcmp(funcName, "write") != 0)
+                *hasFuncCall = 1;
+        }
+
+        _collectLoopConsts(node->child, candidates, numOfCandidates, hasFuncCall);
+    }
+}
+
+int genHoistLoopConsts(FILE* targetFile, AST_NODE* loopNode){
+    /* load constants used in while/for loop into pinned registers before the loop,
+     * return number of hoisted constants, pass it to releaseHoistedConsts after the loop.
+     * callee don't save FP registers, float constants are hoisted only if loop has no call. */
+    ConstPool* pool = GR.constPool;
+    HoistedConst candidates[MAX_HOISTED_CONST];
+    int numOfCandidates = 0, hasFuncCall = 0;
+
+    AST_NODE* node = loopNode->child;
+    if(loopNode->semantic_value.stmtSemanticValue.kind == FOR_STMT)
+        node = node->rightSibling; /* for-loop initialization runs only once */
+    _collectLoopConsts(node, candidates, &numOfCandidates, &hasFuncCall);
+
+    int numOfInt = 0, numOfFloat = 0, i;
+    for(i=0; i<pool->numOfHoisted; i++){
+        if(pool->hoisted[i].type == INT_TYPE)
+            numOfInt++;
+        else
+            numOfFloat++;
+    }
+
+    int numOfHoisted = 0;
+    for(i=0; i<numOfCandidates && pool->numOfHoisted < MAX_HOISTED_CONST; i++){
+        HoistedConst* candidate = &(candidates[i]);
+        if(findHoistedConst(pool, candidate->type, candidate->bits) != -1)
+            continue; /* hoisted by outer loop */
+
+        if(candidate->type == INT_TYPE){
+            if(numOfInt >= MAX_HOISTED_INT_CONST)
+                continue;
+            candidate->regNum = getReg(GR.regManager, targetFile);
+            genLoadIntConstInstr(targetFile, candidate->regNum, (int)candidate->bits);
+            pinReg(GR.regManager, candidate->regNum);
+            numOfInt++;
+        }
+        else{
+            if(hasFuncCall || numOfFloat >= MAX_HOISTED_FLOAT_CONST)
+                continue;
+            float value;
+            memcpy(&value, &(candidate->bits), sizeof(value));
+            candidate->regNum = getReg(GR.FPRegManager, targetFile);
+            genLoadFloatConstInstr(targetFile, candidate->regNum, value);
+            pinReg(GR.FPRegManager, candidate->regNum);
+            numOfFloat++;
+        }
+        pool->hoisted[pool->numOfHoisted++] = *candidate;
+        numOfHoisted++;
+    }
+    return numOfHoisted;
+}
+
+void releaseHoistedConsts(int numOfHoisted){
+    ConstPool* pool = GR.constPool;
+    while(numOfHoisted > 0){
+        HoistedConst* hoisted = &(pool->hoisted[--pool->numOfHoisted]);
+        if(hoisted->type == INT_TYPE)
+            unpinReg(GR.regManager, hoisted->regNum);
+        else
+            unpinReg(GR.FPRegManager, hoisted->regNum);
+        numOfHoisted--;
+    }
+}
+
+/*** Instruction Selection ***/
+/* cycles on R2000, instruction not listed takes 1 */
+static const InstrCost INSTR_COSTS[] = {
+    {"mult", 12}, {"div", 35}
+};
+
+static const InstrTile TILES[] = {
+    /* int value */
+    {INT_TYPE, UNARY_OP_POSITIVE, UNARY_TILE, VALUE_TILE, {"addu D, A, $0"}},
+    {INT_TYPE, UNARY_OP_NEGATIVE, UNARY_TILE, VALUE_TILE, {"subu D, $0, A"}},
+    {INT_TYPE, UNARY_OP_LOGICAL_NEGATION, UNARY_TILE, VALUE_TILE, {"sltiu D, A, 1"}},
+
+    {INT_TYPE, BINARY_OP_ADD, REG_REG_TILE, VALUE_TILE, {"addu D, A, B"}},
+    {INT_TYPE, BINARY_OP_SUB, REG_REG_TILE, VALUE_TILE, {"subu D, A, B"}},
+    {INT_TYPE, BINARY_OP_MUL, REG_REG_TILE, VALUE_TILE, {"mult A, B", "mflo D"}},
+    {INT_TYPE, BINARY_OP_DIV, REG_REG_TILE, VALUE_TILE, {"div A, B", "mflo D"}},
+    {INT_TYPE, BINARY_OP_EQ, REG_REG_TILE, VALUE_TILE, {"xor D, A, B", "sltiu D, D, 1"}},
+    {INT_TYPE, BINARY_OP_NE, REG_REG_TILE, VALUE_TILE, {"xor D, A, B", "sltu D, $0, D"}},
+    {INT_TYPE, BINARY_OP_LT, REG_REG_TILE, VALUE_TILE, {"slt D, A, B"}},
+    {INT_TYPE, BINARY_OP_GT, REG_REG_TILE, VALUE_TILE, {"slt D, B, A"}},
+    {INT_TYPE, BINARY_OP_LE, REG_REG_TILE, VALUE_TILE, {"slt D, B, A", "xori D, D, 1"}},
+    {INT_TYPE, BINARY_OP_GE, REG_REG_TILE, VALUE_TILE, {"slt D, A, B", "xori D, D, 1"}},
+    {INT_TYPE, BINARY_OP_AND, REG_REG_TILE, VALUE_TILE, {"and D, A, B"}},
+    {INT_TYPE, BINARY_OP_OR, REG_REG_TILE, VALUE_TILE, {"or D, A, B"}},
+
+    {INT_TYPE, BINARY_OP_ADD, REG_IMM_TILE, VALUE_TILE, {"addiu D, A, I"}},
+    {INT_TYPE, BINARY_OP_SUB, REG_IMM_TILE, VALUE_TILE, {"addiu D, A, N"}},
+    {INT_TYPE, BINARY_OP_EQ, REG_IMM_TILE, VALUE_TILE, {"xori D, A, U", "sltiu D, D, 1"}},
+    {INT_TYPE, BINARY_OP_EQ, REG_IMM_TILE, VALUE_TILE, {"addiu D, A, N", "sltiu D, D, 1"}},
+    {INT_TYPE, BINARY_OP_NE, REG_IMM_TILE, VALUE_TILE, {"xori D, A, U", "sltu D, $0, D"}},
+    {INT_TYPE, BINARY_OP_NE, REG_IMM_TILE, VALUE_TILE, {"addiu D, A, N", "sltu D, $0, D"}},
+    {INT_TYPE, BINARY_OP_LT, REG_IMM_TILE, VALUE_TILE, {"slti D, A, I"}},
+    {INT_TYPE, BINARY_OP_GE, REG_IMM_TILE, VALUE_TILE, {"slti D, A, I", "xori D, D, 1"}},
+    {INT_TYPE, BINARY_OP_LE, REG_IMM_TILE, VALUE_TILE, {"slti D, A, J"}},
+    {INT_TYPE, BINARY_OP_GT, REG_IMM_TILE, VALUE_TILE, {"slti D, A, J", "xori D, D, 1"}},
+
+    {INT_TYPE, BINARY_OP_EQ, REG_ZERO_TILE, VALUE_TILE, {"sltiu D, A, 1"}},
+    {INT_TYPE, BINARY_OP_NE, REG_ZERO_TILE, VALUE_TILE, {"sltu D, $0, A"}},
+    {INT_TYPE, BINARY_OP_LT, REG_ZERO_TILE, VALUE_TILE, {"srl D, A, 31"}},
+    {INT_TYPE, BINARY_OP_GT, REG_ZERO_TILE, VALUE_TILE, {"slt D, $0, A"}},
+
+    /* float relation value, dest = 1 is cleared from $0 by movf (movt if negated) without branch */
+    {FLOAT_TYPE, BINARY_OP_EQ, REG_REG_TILE, VALUE_TILE, {"c.eq.s fA, fB", "addiu D, $0, 1", "movf D, $0, 0"}},
+    {FLOAT_TYPE, BINARY_OP_NE, REG_REG_TILE, VALUE_TILE, {"c.eq.s fA, fB", "addiu D, $0, 1", "movt D, $0, 0"}},
+    {FLOAT_TYPE, BINARY_OP_LT, REG_REG_TILE, VALUE_TILE, {"c.lt.s fA, fB", "addiu D, $0, 1", "movf D, $0, 0"}},
+    {FLOAT_TYPE, BINARY_OP_GT, REG_REG_TILE, VALUE_TILE, {"c.lt.s fB, fA", "addiu D, $0, 1", "movf D, $0, 0"}},
+    {FLOAT_TYPE, BINARY_OP_LE, REG_REG_TILE, VALUE_TILE, {"c.le.s fA, fB", "addiu D, $0, 1", "movf D, $0, 0"}},
+    {FLOAT_TYPE, BINARY_OP_GE, REG_REG_TILE, VALUE_TILE, {"c.le.s fB, fA", "addiu D, $0, 1", "movf D, $0, 0"}},
+
+    /* int condition with its branch */
+    {INT_TYPE, UNARY_OP_LOGICAL_NEGATION, UNARY_TILE, TRUE_BRANCH_TILE, {"beq A, $0, L"}},
+    {INT_TYPE, UNARY_OP_LOGICAL_NEGATION, UNARY_TILE, FALSE_BRANCH_TILE, {"bne A, $0, L"}},
+
+    {INT_TYPE, BINARY_OP_EQ, REG_REG_TILE, TRUE_BRANCH_TILE, {"beq A, B, L"}},
+    {INT_TYPE, BINARY_OP_EQ, REG_REG_TILE, FALSE_BRANCH_TILE, {"bne A, B, L"}},
+    {INT_TYPE, BINARY_OP_NE, REG_REG_TILE, TRUE_BRANCH_TILE, {"bne A, B, L"}},
+    {INT_TYPE, BINARY_OP_NE, REG_REG_TILE, FALSE_BRANCH_TILE, {"beq A, B, L"}},
+    {INT_TYPE, BINARY_OP_LT, REG_REG_TILE, TRUE_BRANCH_TILE, {"slt S, A, B", "bne S, $0, L"}},
+    {INT_TYPE, BINARY_OP_LT, REG_REG_TILE, FALSE_BRANCH_TILE, {"slt S, A, B", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GT, REG_REG_TILE, TRUE_BRANCH_TILE, {"slt S, B, A", "bne S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GT, REG_REG_TILE, FALSE_BRANCH_TILE, {"slt S, B, A", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_LE, REG_REG_TILE, TRUE_BRANCH_TILE, {"slt S, B, A", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_LE, REG_REG_TILE, FALSE_BRANCH_TILE, {"slt S, B, A", "bne S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GE, REG_REG_TILE, TRUE_BRANCH_TILE, {"slt S, A, B", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GE, REG_REG_TILE, FALSE_BRANCH_TILE, {"slt S, A, B", "bne S, $0, L"}},
+
+    {INT_TYPE, BINARY_OP_LT, REG_IMM_TILE, TRUE_BRANCH_TILE, {"slti S, A, I", "bne S, $0, L"}},
+    {INT_TYPE, BINARY_OP_LT, REG_IMM_TILE, FALSE_BRANCH_TILE, {"slti S, A, I", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GE, REG_IMM_TILE, TRUE_BRANCH_TILE, {"slti S, A, I", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GE, REG_IMM_TILE, FALSE_BRANCH_TILE, {"slti S, A, I", "bne S, $0, L"}},
+    {INT_TYPE, BINARY_OP_LE, REG_IMM_TILE, TRUE_BRANCH_TILE, {"slti S, A, J", "bne S, $0, L"}},
+    {INT_TYPE, BINARY_OP_LE, REG_IMM_TILE, FALSE_BRANCH_TILE, {"slti S, A, J", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GT, REG_IMM_TILE, TRUE_BRANCH_TILE, {"slti S, A, J", "beq S, $0, L"}},
+    {INT_TYPE, BINARY_OP_GT, REG_IMM_TILE, FALSE_BRANCH_TILE, {"slti S, A, J", "bne S, $0, L"}},
+
+    {INT_TYPE, BINARY_OP_EQ, REG_ZERO_TILE, TRUE_BRANCH_TILE, {"beq A, $0, L"}},
+    {INT_TYPE, BINARY_OP_EQ, REG_ZERO_TILE, FALSE_BRANCH_TILE, {"bne A, $0, L"}},
+    {INT_TYPE, BINARY_OP_NE, REG_ZERO_TILE, TRUE_BRANCH_TILE, {"bne A, $0, L"}},
+    {INT_TYPE, BINARY_OP_NE, REG_ZERO_TILE, FALSE_BRANCH_TILE, {"beq A, $0, L"}},
+    {INT_TYPE, BINARY_OP_LT, REG_ZERO_TILE, TRUE_BRANCH_TILE, {"bltz A, L"}},
+    {INT_TYPE, BINARY_OP_LT, REG_ZERO_TILE, FALSE_BRANCH_TILE, {"bgez A, L"}},
+    {INT_TYPE, BINARY_OP_GE, REG_ZERO_TILE, TRUE_BRANCH_TILE, {"bgez A, L"}},
+    {INT_TYPE, BINARY_OP_GE, REG_ZERO_TILE, FALSE_BRANCH_TILE, {"bltz A, L"}},
+    {INT_TYPE, BINARY_OP_GT, REG_ZERO_TILE, TRUE_BRANCH_TILE, {"bgtz A, L"}},
+    {INT_TYPE, BINARY_OP_GT, REG_ZERO_TILE, FALSE_BRANCH_TILE, {"blez A, L"}},
+    {INT_TYPE, BINARY_OP_LE, REG_ZERO_TILE, TRUE_BRANCH_TILE, {"blez A, L"}},
+    {INT_TYPE, BINARY_OP_LE, REG_ZERO_TILE, FALSE_BRANCH_TILE, {"bgtz A, L"}},
+
+    /* float condition with its branch, not negated by swapping relation since NaN is unordered */
+    {FLOAT_TYPE, BINARY_OP_EQ, REG_REG_TILE, TRUE_BRANCH_TILE, {"c.eq.s fA, fB", "bc1t L"}},
+    {FLOAT_TYPE, BINARY_OP_EQ, REG_REG_TILE, FALSE_BRANCH_TILE, {"c.eq.s fA, fB", "bc1f L"}},
+    {FLOAT_TYPE, BINARY_OP_NE, REG_REG_TILE, TRUE_BRANCH_TILE, {"c.eq.s fA, fB", "bc1f L"}},
+    {FLOAT_TYPE, BINARY_OP_NE, REG_REG_TILE, FALSE_BRANCH_TILE, {"c.eq.s fA, fB", "bc1t L"}},
+    {FLOAT_TYPE, BINARY_OP_LT, REG_REG_TILE, TRUE_BRANCH_TILE, {"c.lt.s fA, fB", "bc1t L"}},
+    {FLOAT_TYPE, BINARY_OP_LT, REG_REG_TILE, FALSE_BRANCH_TILE, {"c.lt.s fA, fB", "bc1f L"}},
+    {FLOAT_TYPE, BINARY_OP_GT, REG_REG_TILE, TRUE_BRANCH_TILE, {"c.lt.s fB, fA", "bc1t L"}},
+    {FLOAT_TYPE, BINARY_OP_GT, REG_REG_TILE, FALSE_BRANCH_TILE, {"c.lt.s fB, fA", "bc1f L"}},
+    {FLOAT_TYPE, BINARY_OP_LE, REG_REG_TILE, TRUE_BRANCH_TILE, {"c.le.s fA, fB", "bc1t L"}},
+    {FLOAT_TYPE, BINARY_OP_LE, REG_REG_TILE, FALSE_BRANCH_TILE, {"c.le.s fA, fB", "bc1f L"}},
+    {FLOAT_TYPE, BINARY_OP_GE, REG_REG_TILE, TRUE_BRANCH_TILE, {"c.le.s fB, fA", "bc1t L"}},
+    {FLOAT_TYPE, BINARY_OP_GE, REG_REG_TILE, FALSE_BRANCH_TILE, {"c.le.s fB, fA", "bc1f L"}}
+};
+
+int _splitTileInstr(const char* instr, char* buffer, char** tokens){
+    /* tokens[0] = mnemonic, then operands. return number of tokens */
+    int numOfToken = 0;
+    char* token;
+    strcpy(buffer, instr);
+    for(token = strtok(buffer, " ,"); token; token = strtok(NULL, " ,"))
+        tokens[numOfToken++] = token;
+    return numOfToken;
+}
+
+int _isTileImmFit(const InstrTile* tile, int value){
+    char buffer[MAX_TILE_INSTR_LEN];
+    char* tokens[MAX_TILE_TOKEN];
+    int i, j;
+    for(i = 0; i < MAX_TILE_INSTR && tile->instrs[i]; i++){
+        int numOfToken = _splitTileInstr(tile->instrs[i], buffer, tokens);
+        for(j = 1; j < numOfToken; j++){
+            if(!strcmp(tokens[j], "I") && !isImm16(value))
+                return 0;
+            if(!strcmp(tokens[j], "J") && (value == 0x7fffffff || !isImm16(value + 1)))
+                return 0;
+            if(!strcmp(tokens[j], "N") && (value == (int)0x80000000 || !isImm16(-value)))
+                return 0;
+            if(!strcmp(tokens[j], "U") && !isUImm16(value))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+int getTileCost(const InstrTile* tile){
+    char buffer[MAX_TILE_INSTR_LEN];
+    char* tokens[MAX_TILE_TOKEN];
+    int i, cost = 0;
+    unsigned int j;
+    for(i = 0; i < MAX_TILE_INSTR && tile->instrs[i]; i++){
+        int instrCost = 1;
+        _splitTileInstr(tile->instrs[i], buffer, tokens);
+        for(j = 0; j < sizeof(INSTR_COSTS) / sizeof(INSTR_COSTS[0]); j++){
+            if(!strcmp(tokens[0], INSTR_COSTS[j].name))
+                instrCost = INSTR_COSTS[j].cost;
+        }
+        cost += instrCost;
+    }
+    return cost;
+}
+
+const InstrTile* selectTile(DATA_TYPE type, int op, TileShape shape, int value, TileKind kind){
+    const InstrTile* best = NULL;
+    int bestCost = 0;
+    unsigned int i;
+    for(i = 0; i < sizeof(TILES) / sizeof(TILES[0]); i++){
+        const InstrTile* tile = &(TILES[i]);
+        if(tile->type != type || tile->op != op || tile->kind != kind)
+            continue;
+        if(tile->shape != shape && !(shape == REG_IMM_TILE && tile->shape == REG_ZERO_TILE && value == 0))
+            continue;
+        if(!_isTileImmFit(tile, value))
+            continue;
+
+        int cost = getTileCost(tile);
+        if(!best || cost < bestCost){
+            best = tile;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+void genTile(FILE* targetFile, const InstrTile* tile,
+  int destRegNum, int src1RegNum, int src2RegNum, int value, int label){
+    char buffer[MAX_TILE_INSTR_LEN];
+    char* tokens[MAX_TILE_TOKEN];
+    int i, j;
+    for(i = 0; i < MAX_TILE_INSTR && tile->instrs[i]; i++){
+        int numOfToken = _splitTileInstr(tile->instrs[i], buffer, tokens);
+        fprintf(targetFile, "%s", tokens[0]);
+        for(j = 1; j < numOfToken; j++){
+            fprintf(targetFile, j == 1 ? " " : ", ");
+            if(!strcmp(tokens[j], "D"))
+                fprintf(targetFile, "$%d", destRegNum);
+            else if(!strcmp(tokens[j], "A"))
+                fprintf(targetFile, "$%d", src1RegNum);
+            else if(!strcmp(tokens[j], "B"))
+                fprintf(targetFile, "$%d", src2RegNum);
+            else if(!strcmp(tokens[j], "fA"))
+                fprintf(targetFile, "$f%d", src1RegNum);
+            else if(!strcmp(tokens[j], "fB"))
+                fprintf(targetFile, "$f%d", src2RegNum);
+            else if(!strcmp(tokens[j], "S"))
+                fprintf(targetFile, "$%d", SCRATCH_REG_NUM);
+            else if(!strcmp(tokens[j], "L"))
+                fprintf(targetFile, "L%d", label);
+            else if(!strcmp(tokens[j], "I") || !strcmp(tokens[j], "U"))
+                fprintf(targetFile, "%d", value);
+            else if(!strcmp(tokens[j], "J"))
+                fprintf(targetFile, "%d", value + 1);
+            else if(!strcmp(tokens[j], "N"))
+                fprintf(targetFile, "%d", -value);
+            else
+                fprintf(targetFile, "%s", tokens[j]);
+        }
+        fprintf(targetFile, "\n");
     }
 }
 
 /*** MIPS instruction generation ***/
 void genIntUnaryOpInstr(FILE* targetFile, UNARY_OPERATOR op, int destRegNum, int srcRegNum){
-    switch(op){
-        case UNARY_OP_POSITIVE: genPosOpInstr(targetFile, destRegNum, srcRegNum); break;
-        case UNARY_OP_NEGATIVE: genNegOpInstr(targetFile, destRegNum, srcRegNum); break;
-        case UNARY_OP_LOGICAL_NEGATION: genNOTExpr(targetFile, destRegNum, srcRegNum); break;
-    }
+    genTile(targetFile, selectTile(INT_TYPE, op, UNARY_TILE, 0, VALUE_TILE), destRegNum, srcRegNum, 0, 0, 0);
 }
 
 void genFloatUnaryOpInstr(FILE* targetFile, UNARY_OPERATOR op, int destRegNum, int srcRegNum){
@@ -1431,20 +3234,8 @@ void genFloatUnaryOpInstr(FILE* targetFile, UNARY_OPERATOR op, int destRegNum, i
 
 void genIntBinaryOpInstr(FILE* targetFile, BINARY_OPERATOR op, 
   int destRegNum, int src1RegNum, int src2RegNum){
-    switch(op){
-        case BINARY_OP_ADD: genAddOpInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_SUB: genSubOpInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_MUL: genMulOpInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_DIV: genDivOpInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_EQ: genEQExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_GE: genGEExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_LE: genLEExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_NE: genNEExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_GT: genGTExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_LT: genLTExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_AND: genANDExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_OR: genORExpr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-    }
+    genTile(targetFile, selectTile(INT_TYPE, op, REG_REG_TILE, 0, VALUE_TILE),
+      destRegNum, src1RegNum, src2RegNum, 0, 0);
 }
 
 void genFloatBinaryArithOpInstr(FILE* targetFile, BINARY_OPERATOR op, 
@@ -1459,22 +3250,16 @@ void genFloatBinaryArithOpInstr(FILE* targetFile, BINARY_OPERATOR op,
 
 void genFloatBinaryRelaOpInstr(FILE* targetFile, BINARY_OPERATOR op, 
   int destRegNum, int src1RegNum, int src2RegNum){
-    switch(op){
-        case BINARY_OP_EQ: genFPEQInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_GE: genFPGEInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_LE: genFPLEInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_NE: genFPNEInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_GT: genFPGTInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-        case BINARY_OP_LT: genFPLTInstr(targetFile, destRegNum, src1RegNum, src2RegNum); break;
-    }
+    genTile(targetFile, selectTile(FLOAT_TYPE, op, REG_REG_TILE, 0, VALUE_TILE),
+      destRegNum, src1RegNum, src2RegNum, 0, 0);
 }
 
 void genAddOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    fprintf(targetFile, "add $%d, $%d, $%d\n", destRegNum, src1RegNum, src2RegNum);
+    fprintf(targetFile, "addu $%d, $%d, $%d\n", destRegNum, src1RegNum, src2RegNum);
 }
 
 void genSubOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    fprintf(targetFile, "sub $%d, $%d, $%d\n", destRegNum, src1RegNum, src2RegNum);
+    fprintf(targetFile, "subu $%d, $%d, $%d\n", destRegNum, src1RegNum, src2RegNum);
 }
 
 void genMulOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
@@ -1487,48 +3272,248 @@ void genDivOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2Reg
     fprintf(targetFile, "mflo $%d\n", destRegNum);
 }
 
-void genEQExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "seq $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
-
-void genNEExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "sne $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
-
-void genLTExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "slt $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
+int _getRegNeed(AST_NODE* exprNode){
+    /* Sethi-Ullman number, registers held while evaluating exprNode without spill.
+     * index of later array dimension is evaluated while offset of former ones is held */
+    if(exprNode->nodeType == IDENTIFIER_NODE){
+        int need = 1, isHeld = 0;
+        AST_NODE* indexNode;
+        for(indexNode = exprNode->child; indexNode; indexNode = indexNode->rightSibling){
+            int indexNeed = _getRegNeed(indexNode) + isHeld;
+            if(indexNeed > need)
+                need = indexNeed;
+            isHeld = 1;
+        }
+        return need;
+    }
+    if(exprNode->nodeType != EXPR_NODE)
+        return 1;
+    if(exprNode->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return _getRegNeed(exprNode->child);
+
+    int need1 = _getRegNeed(exprNode->child);
+    int need2 = _getRegNeed(exprNode->child->rightSibling);
+    if(need1 == need2)
+        return need1 + 1;
+    return need1 > need2 ? need1 : need2;
+}
+
+int getIntConstValue(AST_NODE* node, int* value){
+    /* int constant, or expression value ranges narrow to one value */
+    int max;
+    return getExprRange(node, value, &max) && *value == max;
+}
+
+AST_NODE* _getConstMulDivOperand(STT* symbolTable, AST_NODE* exprNode, int* value){
+    /* int operand of multiplication worth shifts and adds, or of division by nonzero constant,
+     * return NULL if exprNode isn't such operation */
+    BINARY_OPERATOR op = exprNode->semantic_value.exprSemanticValue.op.binaryOp;
+    AST_NODE* child1 = exprNode->child;
+    AST_NODE* child2 = child1->rightSibling;
+    if((op != BINARY_OP_MUL && op != BINARY_OP_DIV) ||
+      getTypeOfExpr(symbolTable, child1) != INT_TYPE || getTypeOfExpr(symbolTable, child2) != INT_TYPE)
+        return NULL;
+
+    if(getIntConstValue(child2, value)){
+        if(op == BINARY_OP_DIV)
+            return *value != 0 ? child1 : NULL;
+        if(_genShiftAddSequence(NULL, 0, 0, (unsigned int)*value) <= MAX_MUL_SHIFT_INSTR ||
+          _genShiftAddSequence(NULL, 0, 0, 0u - (unsigned int)*value) + 1 <= MAX_MUL_SHIFT_INSTR)
+            return child1;
+    }
+    if(op == BINARY_OP_MUL && getIntConstValue(child1, value)){
+        if(_genShiftAddSequence(NULL, 0, 0, (unsigned int)*value) <= MAX_MUL_SHIFT_INSTR ||
+          _genShiftAddSequence(NULL, 0, 0, 0u - (unsigned int)*value) + 1 <= MAX_MUL_SHIFT_INSTR)
+            return child2;
+    }
+    return NULL;
+}
+
+AST_NODE* _getImmOperand(STT* symbolTable, AST_NODE* exprNode, BINARY_OPERATOR* op, int* value, TileKind kind){
+    /* int operand of operation whose other operand fits immediate field of some tile,
+     * op is mirrored if the constant comes first. return NULL if exprNode isn't such operation */
+    AST_NODE* child1 = exprNode->child;
+    AST_NODE* child2 = child1->rightSibling;
+    if(getTypeOfExpr(symbolTable, child1) != INT_TYPE || getTypeOfExpr(symbolTable, child2) != INT_TYPE)
+        return NULL;
+
+    *op = exprNode->semantic_value.exprSemanticValue.op.binaryOp;
+    AST_NODE* operandNode = child1;
+    if(!getIntConstValue(child2, value)){
+        if(!getIntConstValue(child1, value))
+            return NULL;
+        operandNode = child2;
+        switch(*op){
+            case BINARY_OP_ADD: case BINARY_OP_EQ: case BINARY_OP_NE: break;
+            case BINARY_OP_LT: *op = BINARY_OP_GT; break;
+            case BINARY_OP_GT: *op = BINARY_OP_LT; break;
+            case BINARY_OP_LE: *op = BINARY_OP_GE; break;
+            case BINARY_OP_GE: *op = BINARY_OP_LE; break;
+            default: return NULL;
+        }
+    }
+    return selectTile(INT_TYPE, *op, REG_IMM_TILE, *value, kind) ? operandNode : NULL;
+}
+
+int _genShiftAddSequence(FILE* targetFile, int destRegNum, int srcRegNum, unsigned int value){
+    /* dest = src * value from non-adjacent form digits of value, highest digit first.
+     * return number of instructions, targetFile NULL only counts them */
+    int shifts[33], signs[33], numOfDigits = 0, pos;
+    unsigned long long rest = value;
+    for(pos = 0; rest; pos++, rest >>= 1){
+        if(!(rest & 1))
+            continue;
+        int sign = (rest & 3) == 3 ? -1 : 1;
+        if(sign > 0)
+            rest--;
+        else
+            rest++;
+        if(pos < 32){
+            /* digit of 2^32 vanishes */
+            shifts[numOfDigits] = pos;
+            signs[numOfDigits++] = sign;
+        }
+    }
 
-void genGTExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "sgt $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
+    if(numOfDigits == 0){
+        if(targetFile)
+            genLoadIntConstInstr(targetFile, destRegNum, 0);
+        return 1;
+    }
+    int numOfInstr = 0, i;
+    for(i = numOfDigits - 1; i >= 0; i--){
+        int gap = shifts[i] - (i > 0 ? shifts[i - 1] : 0);
+        int accRegNum = destRegNum;
+        if(i == numOfDigits - 1 && signs[i] > 0)
+            accRegNum = srcRegNum;
+        else{
+            if(targetFile)
+                fprintf(targetFile, "%s $%d, $%d, $%d\n", signs[i] > 0 ? "addu" : "subu", destRegNum,
+                  i == numOfDigits - 1 ? 0 : destRegNum, srcRegNum);
+            numOfInstr++;
+        }
 
-void genLEExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "sle $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
+        if(gap > 0 || accRegNum != destRegNum){
+            if(targetFile)
+                fprintf(targetFile, "sll $%d, $%d, %d\n", destRegNum, accRegNum, gap);
+            numOfInstr++;
+        }
+    }
+    return numOfInstr;
 }
 
-void genGEExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "sge $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
+int genMulConstInstr(FILE* targetFile, int destRegNum, int srcRegNum, int value){
+    unsigned int bits = (unsigned int)value;
+    int cost = _genShiftAddSequence(NULL, 0, 0, bits);
+    int negatedCost = _genShiftAddSequence(NULL, 0, 0, 0u - bits) + 1;
+    if(cost > MAX_MUL_SHIFT_INSTR && negatedCost > MAX_MUL_SHIFT_INSTR)
+        return 0;
 
-void genANDExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "and $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
+    if(destRegNum == srcRegNum){
+        /* result register reuses the operand's */
+        fprintf(targetFile, "addu $%d, $%d, $0\n", SCRATCH_REG_NUM, srcRegNum);
+        srcRegNum = SCRATCH_REG_NUM;
+    }
+    if(cost <= negatedCost)
+        _genShiftAddSequence(targetFile, destRegNum, srcRegNum, bits);
+    else{
+        _genShiftAddSequence(targetFile, destRegNum, srcRegNum, 0u - bits);
+        fprintf(targetFile, "subu $%d, $0, $%d\n", destRegNum, destRegNum);
+    }
+    return 1;
+}
+
+void _computeDivMagic(unsigned int divisor, int* magic, int* shift){
+    /* smallest magic number and shift for signed division by divisor >= 3,
+     * Hacker's Delight, figure 10-1 */
+    unsigned int two31 = 0x80000000u;
+    unsigned int anc = two31 - 1 - two31 % divisor;
+    unsigned int q1 = two31 / anc, r1 = two31 - q1 * anc;
+    unsigned int q2 = two31 / divisor, r2 = two31 - q2 * divisor;
+    unsigned int delta;
+    int p = 31;
+    do{
+        p++;
+        q1 *= 2;
+        r1 *= 2;
+        if(r1 >= anc){
+            q1++;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if(r2 >= divisor){
+            q2++;
+            r2 -= divisor;
+        }
+        delta = divisor - r2;
+    }while(q1 < delta || (q1 == delta && r1 == 0));
+
+    *magic = (int)(q2 + 1);
+    *shift = p - 32;
+}
+
+void genDivConstInstr(FILE* targetFile, int destRegNum, int srcRegNum, int value, int isNonNegative){
+    /* quotient rounds toward zero like div.
+     * by 2^k, negative dividend is biased by 2^k - 1 before shifting,
+     * otherwise take high word of product with magic number, plus one if dividend is negative.
+     * dividend known non-negative needs no correction */
+    assert(value != 0);
+    unsigned int divisor = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    int isPowerOfTwo = (divisor & (divisor - 1)) == 0;
+    if(destRegNum == srcRegNum && divisor != 1 && (!isPowerOfTwo || !isNonNegative)){
+        /* result register reuses the operand's */
+        fprintf(targetFile, "addu $%d, $%d, $0\n", SCRATCH_REG_NUM, srcRegNum);
+        srcRegNum = SCRATCH_REG_NUM;
+    }
 
-void genORExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
-    fprintf(targetFile, "or $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
-}
+    if(divisor == 1)
+        fprintf(targetFile, "addu $%d, $%d, $0\n", destRegNum, srcRegNum);
+    else if(isPowerOfTwo){
+        int k = 0;
+        while((1u << k) != divisor)
+            k++;
+        if(isNonNegative)
+            fprintf(targetFile, "srl $%d, $%d, %d\n", destRegNum, srcRegNum, k);
+        else{
+            if(k == 1)
+                fprintf(targetFile, "srl $%d, $%d, 31\n", destRegNum, srcRegNum);
+            else{
+                fprintf(targetFile, "sra $%d, $%d, 31\n", destRegNum, srcRegNum);
+                fprintf(targetFile, "srl $%d, $%d, %d\n", destRegNum, destRegNum, 32 - k);
+            }
+            fprintf(targetFile, "addu $%d, $%d, $%d\n", destRegNum, destRegNum, srcRegNum);
+            fprintf(targetFile, "sra $%d, $%d, %d\n", destRegNum, destRegNum, k);
+        }
+    }
+    else{
+        int magic, shift;
+        _computeDivMagic(divisor, &magic, &shift);
+        genLoadIntConstInstr(targetFile, destRegNum, magic);
+        fprintf(targetFile, "mult $%d, $%d\n", srcRegNum, destRegNum);
+        fprintf(targetFile, "mfhi $%d\n", destRegNum);
+        if(magic < 0)
+            fprintf(targetFile, "addu $%d, $%d, $%d\n", destRegNum, destRegNum, srcRegNum);
+        if(shift > 0)
+            fprintf(targetFile, "sra $%d, $%d, %d\n", destRegNum, destRegNum, shift);
+        if(!isNonNegative){
+            fprintf(targetFile, "srl $%d, $%d, 31\n", SCRATCH_REG_NUM, srcRegNum);
+            fprintf(targetFile, "addu $%d, $%d, $%d\n", destRegNum, destRegNum, SCRATCH_REG_NUM);
+        }
+    }
 
-void genNOTExpr(FILE* targetFile, int destReg, int srcReg){
-    fprintf(targetFile, "seq $%d, $%d, $%d\n", destReg, srcReg, 0);
+    if(value < 0)
+        fprintf(targetFile, "subu $%d, $0, $%d\n", destRegNum, destRegNum);
 }
 
-void genPosOpInstr(FILE* targetFile, int destRegNum, int srcRegNum){
-    fprintf(targetFile, "add $%d, $%d, $0\n", destRegNum, srcRegNum);
+void genIntImmOpInstr(FILE* targetFile, BINARY_OPERATOR op, int destRegNum, int srcRegNum, int value){
+    const InstrTile* tile = selectTile(INT_TYPE, op, REG_IMM_TILE, value, VALUE_TILE);
+    assert(tile);
+    genTile(targetFile, tile, destRegNum, srcRegNum, 0, value, 0);
 }
 
-void genNegOpInstr(FILE* targetFile, int destRegNum, int srcRegNum){
-    fprintf(targetFile, "sub $%d, $0, $%d\n", destRegNum, srcRegNum);
+void genLTExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2){
+    fprintf(targetFile, "slt $%d, $%d, $%d\n", destReg, srcReg1, srcReg2);
 }
 
 // floating arithmetic operation
@@ -1548,84 +3533,6 @@ void genFPDivOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2R
     fprintf(targetFile, "div.s $f%d, $f%d, $f%d\n", destRegNum, src1RegNum, src2RegNum);
 }
 
-void genFPEQInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    int falseLabel = GR.labelCounter++;
-    int exitLabel  = GR.labelCounter++;
-    
-    fprintf(targetFile, "c.eq.s $f%d, $f%d\n", src1RegNum, src2RegNum);
-    fprintf(targetFile, "bc1f L%d\n", falseLabel);
-    fprintf(targetFile, "li $%d, 1\n", destRegNum);
-    fprintf(targetFile, "j L%d\n", exitLabel);
-    fprintf(targetFile, "L%d:\n", falseLabel);
-    fprintf(targetFile, "li $%d, 0\n", destRegNum);
-    fprintf(targetFile, "L%d:\n", exitLabel);
-}
-
-void genFPNEInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    int falseLabel = GR.labelCounter++;
-    int exitLabel  = GR.labelCounter++;
-    
-    fprintf(targetFile, "c.eq.s $f%d, $f%d\n", src1RegNum, src2RegNum);
-    fprintf(targetFile, "bc1f L%d\n", falseLabel);
-    fprintf(targetFile, "li $%d, 0\n", destRegNum);
-    fprintf(targetFile, "j L%d\n", exitLabel);
-    fprintf(targetFile, "L%d:\n", falseLabel);
-    fprintf(targetFile, "li $%d, 1\n", destRegNum);
-    fprintf(targetFile, "L%d:\n", exitLabel);
-}
-
-void genFPLTInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    int falseLabel = GR.labelCounter++;
-    int exitLabel  = GR.labelCounter++;
-    
-    fprintf(targetFile, "c.lt.s $f%d, $f%d\n", src1RegNum, src2RegNum);
-    fprintf(targetFile, "bc1f L%d\n", falseLabel);
-    fprintf(targetFile, "li $%d, 1\n", destRegNum);
-    fprintf(targetFile, "j L%d\n", exitLabel);
-    fprintf(targetFile, "L%d:\n", falseLabel);
-    fprintf(targetFile, "li $%d, 0\n", destRegNum);
-    fprintf(targetFile, "L%d:\n", exitLabel);
-}
-
-void genFPGTInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    int falseLabel = GR.labelCounter++;
-    int exitLabel  = GR.labelCounter++;
-    
-    fprintf(targetFile, "c.le.s $f%d, $f%d\n", src1RegNum, src2RegNum);
-    fprintf(targetFile, "bc1f L%d\n", falseLabel);
-    fprintf(targetFile, "li $%d, 0\n", destRegNum);
-    fprintf(targetFile, "j L%d\n", exitLabel);
-    fprintf(targetFile, "L%d:\n", falseLabel);
-    fprintf(targetFile, "li $%d, 1\n", destRegNum);
-    fprintf(targetFile, "L%d:\n", exitLabel);
-}
-
-void genFPGEInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    int falseLabel = GR.labelCounter++;
-    int exitLabel  = GR.labelCounter++;
-    
-    fprintf(targetFile, "c.lt.s $f%d, $f%d\n", src1RegNum, src2RegNum);
-    fprintf(targetFile, "bc1f L%d\n", falseLabel);
-    fprintf(targetFile, "li $%d, 0\n", destRegNum);
-    fprintf(targetFile, "j L%d\n", exitLabel);
-    fprintf(targetFile, "L%d:\n", falseLabel);
-    fprintf(targetFile, "li $%d, 1\n", destRegNum);
-    fprintf(targetFile, "L%d:\n", exitLabel);
-}
-
-void genFPLEInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum){
-    int falseLabel = GR.labelCounter++;
-    int exitLabel  = GR.labelCounter++;
-    
-    fprintf(targetFile, "c.le.s $f%d, $f%d\n", src1RegNum, src2RegNum);
-    fprintf(targetFile, "bc1f L%d\n", falseLabel);
-    fprintf(targetFile, "li $%d, 1\n", destRegNum);
-    fprintf(targetFile, "j L%d\n", exitLabel);
-    fprintf(targetFile, "L%d:\n", falseLabel);
-    fprintf(targetFile, "li $%d, 0\n", destRegNum);
-    fprintf(targetFile, "L%d:\n", exitLabel);
-}
-
 void genFPPosOpInstr(FILE* targetFile, int destRegNum, int srcRegNum){
     fprintf(targetFile, "mov.s $f%d, $f%d\n", destRegNum, srcRegNum);
 }
@@ -1634,10 +3541,35 @@ void genFPNegOpInstr(FILE* targetFile, int destRegNum, int srcRegNum){
     fprintf(targetFile, "neg.s $f%d, $f%d\n", destRegNum, srcRegNum);
 }
 
+// constant
+void genLoadIntConstInstr(FILE* targetFile, int destRegNum, int value){
+    /* cheapest lui/ori form instead of li pseudo instruction */
+    if(isImm16(value))
+        fprintf(targetFile, "addiu $%d, $0, %d\n", destRegNum, value);
+    else if(isUImm16(value))
+        fprintf(targetFile, "ori $%d, $0, %d\n", destRegNum, value);
+    else{
+        unsigned int bits = (unsigned int)value;
+        fprintf(targetFile, "lui $%d, %u\n", destRegNum, bits >> 16);
+        if(bits & 0xffff)
+            fprintf(targetFile, "ori $%d, $%d, %u\n", destRegNum, destRegNum, bits & 0xffff);
+    }
+}
+
+void genLoadFloatConstInstr(FILE* targetFile, int destRegNum, float value){
+    if(floatToBits(value) == 0)
+        fprintf(targetFile, "mtc1 $0, $f%d\n", destRegNum);
+    else
+        fprintf(targetFile, "l.s $f%d, L%d\n", destRegNum, addConstFloat(GR.constPool, value));
+}
+
 // casting
 void genFloatToInt(FILE* targetFile, int destRegNum, int floatRegNum){
-    fprintf(targetFile, "cvt.w.s $f%d, $f%d\n", floatRegNum, floatRegNum);
-    fprintf(targetFile, "mfc1 $%d, $f%d\n", destRegNum, floatRegNum);
+    /* keep floatRegNum unchanged, it may be a pinned constant */
+    int tempRegNum = getReg(GR.FPRegManager, targetFile);
+    fprintf(targetFile, "cvt.w.s $f%d, $f%d\n", tempRegNum, floatRegNum);
+    fprintf(targetFile, "mfc1 $%d, $f%d\n", destRegNum, tempRegNum);
+    releaseReg(GR.FPRegManager, tempRegNum);
 }
 
 void genIntToFloat(FILE* targetFile, int destRegNum, int intRegNum){
@@ -1648,52 +3580,148 @@ void genIntToFloat(FILE* targetFile, int destRegNum, int intRegNum){
 /* IO system call */
 void genRead(FILE *targetFile){
     
-    fprintf(targetFile, "li $v0 5\n");//syscall 5 means read_int;
-    fprintf(targetFile, "syscall\n"); //the returned result will be in $v0
+    GR.runtimeUsed |= RUNTIME_INPUT;
+    fprintf(targetFile, "jal _read_int\n"); //the returned result will be in $v0
 }
 
 void genFRead(FILE *targetFile){
     
-    fprintf(targetFile, "li $v0 6\n");//syscall 6 means read_float;
-    fprintf(targetFile, "syscall\n"); //the returned result will be in $f0
+    GR.runtimeUsed |= RUNTIME_INPUT;
+    fprintf(targetFile, "jal _read_float\n"); //the returned result will be in $f0
+}
+
+
+int isWriteStmt(AST_NODE* stmtNode){
+    if(stmtNode->nodeType != STMT_NODE || 
+      stmtNode->semantic_value.stmtSemanticValue.kind != FUNCTION_CALL_STMT)
+        return 0;
+
+    char* funcName = stmtNode->child->semantic_value.identifierSemanticValue.identifierName;
+    return strcmp(funcName, "write") == 0;
+}
+
+int _getConstWriteText(AST_NODE* exprNode, char* text){
+    /* text printed by write(exprNode) at compile time, escape sequences not decoded.
+     * return 0 if exprNode isn't constant */
+    int isNegative = 0;
+    if(exprNode->nodeType == EXPR_NODE && 
+      exprNode->semantic_value.exprSemanticValue.kind == UNARY_OPERATION &&
+      exprNode->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_NEGATIVE){
+        isNegative = 1;
+        exprNode = exprNode->child;
+    }
+    if(exprNode->nodeType != CONST_VALUE_NODE)
+        return 0;
+
+    CON_Type* constant = exprNode->semantic_value.const1;
+    if(constant->const_type == STRINGC){
+        if(isNegative)
+            return 0;
+        char* string = constant->const_u.sc;
+        sprintf(text, "%.*s", (int)strlen(string) - 2, string + 1); /* without quotes */
+    }
+    else if(constant->const_type == INTEGERC){
+        /* same format as SPIM print_int */
+        unsigned int value = constant->const_u.intval;
+        sprintf(text, "%d", (int)(isNegative ? 0u - value : value));
+    }
+    else if(constant->const_type == FLOATC){
+        /* same format as SPIM print_float */
+        float value = constant->const_u.fval;
+        sprintf(text, "%.8f", isNegative ? -value : value);
+    }
+    return 1;
+}
+
+void _genPendingWriteText(FILE *targetFile, char* pendingText){
+    /* append constant text of merged write() calls to output buffer */
+    if(pendingText[1] == '\0')
+        return;
+
+    int length = strlen(pendingText);
+    pendingText[length] = '"';
+    pendingText[length + 1] = '\0';
+    int constStringLabel = addConstString(GR.constStrings, strdup(pendingText));
+    fprintf(targetFile, "la $a0, L%d\n", constStringLabel);
+    fprintf(targetFile, "jal _write_str\n");
+    pendingText[1] = '\0';
+}
+
+void _genWriteValue(FILE *targetFile, STT* symbolTable, AST_NODE* exprNode){
+    /* append value of evaluated exprNode to output buffer */
+    DATA_TYPE dataType = getTypeOfExpr(symbolTable, exprNode);
+    if(dataType == INT_TYPE){
+        int intRegNum = getExprNodeReg(targetFile, exprNode);
+        fprintf(targetFile, "move $a0, $%d\n", intRegNum);
+        fprintf(targetFile, "jal _write_int\n");
+        releaseReg(GR.regManager, intRegNum);
+    }
+    else if(dataType == FLOAT_TYPE){
+        int floatRegNum = getExprNodeReg(targetFile, exprNode);
+        fprintf(targetFile, "mov.s $f12, $f%d\n", floatRegNum);
+        fprintf(targetFile, "jal _write_float\n");
+        releaseReg(GR.FPRegManager, floatRegNum);
+    }
 }
 
+AST_NODE* genWriteSequence(FILE *targetFile, STT* symbolTable, AST_NODE* firstWriteNode){
+    /* consecutive write() calls in a statement list:
+     * adjacent constants are merged into one string literal at compile time */
+    AST_NODE* writeNode;
+    AST_NODE* endNode = firstWriteNode;
+    char constText[64];
+    int textLength = 2;
+
+    while(endNode && isWriteStmt(endNode)){
+        char* text = constText;
+        constText[0] = '\0';
+        AST_NODE* exprNode = endNode->child->rightSibling->child;
+        if(exprNode->nodeType == CONST_VALUE_NODE && 
+          exprNode->semantic_value.const1->const_type == STRINGC)
+            text = exprNode->semantic_value.const1->const_u.sc;
+        else
+            _getConstWriteText(exprNode, constText);
+        textLength += strlen(text);
+        endNode = endNode->rightSibling;
+    }
+
+    char* pendingText = malloc(textLength + 2);
+    strcpy(pendingText, "\"");
+    GR.runtimeUsed |= RUNTIME_OUTPUT;
+
+    for(writeNode = firstWriteNode; writeNode != endNode; writeNode = writeNode->rightSibling){
+        AST_NODE* exprNode = writeNode->child->rightSibling->child;
+        int length = strlen(pendingText);
+        if(_getConstWriteText(exprNode, pendingText + length))
+            continue;
+
+        _genPendingWriteText(targetFile, pendingText);
+        beginValueStmt(GR.valueTable);
+        genExpr(targetFile, symbolTable, exprNode);
+        _genWriteValue(targetFile, symbolTable, exprNode);
+    }
+    _genPendingWriteText(targetFile, pendingText);
+
+    free(pendingText);
+    return endNode;
+}
 
 void genWrite(FILE *targetFile, STT* symbolTable, AST_NODE* funcCallNode){
     
     // genExpr
     AST_NODE* ExprNode = funcCallNode->child->rightSibling->child;
     genExpr(targetFile, symbolTable, ExprNode);
+    GR.runtimeUsed |= RUNTIME_OUTPUT;
 
     // check type to be printed
     if( ExprNode->nodeType == CONST_VALUE_NODE && 
       ExprNode->semantic_value.const1->const_type == STRINGC ){
         
         char *constString = ExprNode->semantic_value.const1->const_u.sc;
-        int constStringLabel = GR.labelCounter++;
-        addConstString(GR.constStrings, constStringLabel, constString);
-        fprintf(targetFile, "li $v0, 4\n");
-        fprintf(targetFile, "la $a0 L%d\n", constStringLabel);
-        fprintf(targetFile, "syscall\n");
-    }
-    else{
-
-        DATA_TYPE dataType = getTypeOfExpr(symbolTable, ExprNode);
-
-        if(dataType == INT_TYPE){
-            int intRegNum = getExprNodeReg(targetFile, ExprNode);
-            fprintf(targetFile, "li $v0, 1\n");
-            fprintf(targetFile, "move $a0, $%d\n", intRegNum);
-            fprintf(targetFile, "syscall\n");
-            releaseReg(GR.regManager, intRegNum);
-        }
-        else if(dataType == FLOAT_TYPE){
-            int floatRegNum = getExprNodeReg(targetFile, ExprNode);
-            fprintf(targetFile, "li $v0, 2\n");
-            fprintf(targetFile, "mov.s $f12, $f%d\n", floatRegNum);
-            fprintf(targetFile, "syscall\n");
-            releaseReg(GR.FPRegManager, floatRegNum);
-        }
+        int constStringLabel = addConstString(GR.constStrings, constString);
+        fprintf(targetFile, "la $a0, L%d\n", constStringLabel);
+        fprintf(targetFile, "jal _write_str\n");
     }
-
+    else
+        _genWriteValue(targetFile, symbolTable, ExprNode);
 }
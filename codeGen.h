@@ -50,6 +50,7 @@ ArrayIndexKind computeArrayOffset(FILE* targetFile, STT* symbolTable, SymbolTabl
 
 struct RegisterManager {
     int regFull[256];
+    int regPinned[256]; /* pinned register is never spilled or released */
     AST_NODE* regUser[256];
     int lastReg;
     /* const value after constructor */
@@ -68,28 +69,646 @@ void releaseReg(RegisterManager* pThis, int regNum);
 void spillReg(RegisterManager* pThis, int regIndex, FILE* targetFile);
 int findEmptyReg(RegisterManager* pThis);
 int findEarlestUsedReg(RegisterManager* pThis);
+void pinReg(RegisterManager* pThis, int regNum);
+void unpinReg(RegisterManager* pThis, int regNum);
+int holdReg(RegisterManager* pThis, int regNum);
+void unholdReg(RegisterManager* pThis, int regNum, int isHeld);
+/* register with user isn't spilled between holdReg and unholdReg */
+int isPinnedReg(RegisterManager* pThis, int regNum);
+/* variable register is never released either */
+int getAddrReg(FILE* targetFile, int offsetRegNum);
+/* register to compute address from array offset in, the offset itself unless it must be kept */
+void releaseExprNodeReg(AST_NODE* exprNode);
+/* release register of expression value, if the value is in register */
 
 /*** Constant String Implementation ***/
-#define MAX_CON_STRING 2048
+/* growable string table, identical literals share one label,
+ * a literal which is a suffix of another one is emitted inside the longer one */
+#define INIT_CON_STRING_SIZE 64
 
 typedef struct ConstStringSet ConstStringSet;
 typedef struct ConstStringPair ConstStringPair;
 
 struct ConstStringPair{
     int labelNum;
-    char* string;
+    char* string; /* with quotes, escape sequences not decoded */
+    unsigned int hash;
+    int hashNext; /* index of next pair in the same bucket, -1 at the end */
+    int numOfUnit;
+    int* unitOffset; /* offset of each character(escape sequence as one) in string */
+    int hostIndex; /* string which this string is emitted in, -1 if emitted by itself */
 };
 
 struct ConstStringSet{
     int numOfConstString;
-    ConstStringPair constStrings[MAX_CON_STRING];
+    int capacity;
+    ConstStringPair* constStrings;
+    int* bucket; /* size = capacity, index of first pair, -1 if empty */
 };
 
 void initConstStringSet(ConstStringSet* pThis);
-void addConstString(ConstStringSet* pThis, int labelNum, char* string);
+void finConstStringSet(ConstStringSet* pThis);
+int addConstString(ConstStringSet* pThis, char* string);
+/* return label number of string, add it to the set if not exist */
 void genConstStrings(ConstStringSet* pThis, FILE* targetFile);
 
+/*** Constant Pool Implementation ***/
+/* float constants are emitted once per program as exact bit patterns in .data,
+ * and loaded with l.s; constants used in a loop may be hoisted into a pinned register */
+#define CONST_POOL_HASH_SIZE 256
+#define MAX_HOISTED_CONST 16
+#define MAX_HOISTED_INT_CONST 2
+#define MAX_HOISTED_FLOAT_CONST 4
+
+typedef struct ConstPoolEntry ConstPoolEntry;
+typedef struct HoistedConst HoistedConst;
+
+struct ConstPoolEntry{
+    int labelNum;
+    unsigned int bits; /* IEEE-754 single precision bit pattern */
+    ConstPoolEntry* hashNext;
+    ConstPoolEntry* next; /* emission order */
+};
+
+struct HoistedConst{
+    DATA_TYPE type;
+    unsigned int bits;
+    int regNum;
+};
+
+struct ConstPool{
+    ConstPoolEntry* bucket[CONST_POOL_HASH_SIZE];
+    ConstPoolEntry* head;
+    ConstPoolEntry* tail;
+    int numOfConst;
+    /* stack of hoisted constants, innermost loop at the top */
+    int numOfHoisted;
+    HoistedConst hoisted[MAX_HOISTED_CONST];
+};
+
+void initConstPool(ConstPool* pThis);
+void finConstPool(ConstPool* pThis);
+int addConstFloat(ConstPool* pThis, float value);
+/* return label number of float constant, add it to pool if not exist */
+void genConstPool(ConstPool* pThis, FILE* targetFile);
+unsigned int floatToBits(float value);
+int findHoistedConst(ConstPool* pThis, DATA_TYPE type, unsigned int bits);
+/* return register holding hoisted constant, -1 if not hoisted */
+int genHoistLoopConsts(FILE* targetFile, AST_NODE* loopNode);
+void releaseHoistedConsts(int numOfHoisted);
+int isImm16(int value);
+int isUImm16(int value);
+int getIntConstValue(AST_NODE* node, int* value);
+/* int expression of one known value, return 0 if node isn't */
+
+/*** Local Variable Optimization ***/
+/* scalar locals and parameters of the function being generated.
+ * liveness marks dead stores, locals which are never read get no storage,
+ * the most used ones live in $t0 ~ $t7 / $f4 ~ $f11, saved by callee */
+#define FIRST_VAR_REG_NUM 8
+#define MAX_VAR_REG_NUM 8
+#define FIRST_VAR_FP_REG_NUM 4
+#define MAX_VAR_FP_REG_NUM 8
+
+typedef struct LocalVar LocalVar;
+typedef struct CachedGlobal CachedGlobal;
+typedef struct TiledLoop TiledLoop;
+typedef struct UnswitchedLoop UnswitchedLoop;
+
+struct LocalVar{
+    SymbolTableEntry* entry;
+    int paraOffset; /* stack offset of parameter, 0 if it isn't parameter */
+    int isLiveAtEntry;
+    int numOfRead;
+    int weight; /* occurrences weighted by loop depth */
+};
+
+struct LocalVarSet{
+    int numOfVar;
+    int capacity;
+    LocalVar* vars;
+    int numOfWord; /* size of live set */
+    int numOfVarReg;
+    int numOfVarFPReg;
+    int saveOffset; /* stack offset of saved variable registers */
+    int numOfCached;
+    int capacityOfCached;
+    CachedGlobal* cached;
+    AST_NODE* activeRegion; /* loop whose cached globals are in registers now */
+    int numOfTiled;
+    TiledLoop* tiled;
+    int numOfUnswitched;
+    UnswitchedLoop* unswitched;
+};
+
+void initLocalVarSet(LocalVarSet* pThis);
+void finLocalVarSet(LocalVarSet* pThis);
+void analyzeLocalVars(LocalVarSet* pThis, STT* symbolTable, AST_NODE* declarationNode);
+/* call in function scope, after parameters get their place */
+int isUnusedLocalVar(LocalVarSet* pThis, SymbolTableEntry* entry);
+int isDeadAssignment(AST_NODE* assignmentNode);
+/* dead store whose rvalue has no side effect, generate nothing */
+int hasFuncCall(AST_NODE* node);
+void genVarRegPrologue(FILE* targetFile, char* funcName);
+void genVarRegEpilogue(FILE* targetFile, char* funcName);
+
+/*** Call Graph ***/
+/* global scalars each function may read or write, directly or through its callees.
+ * C-- has no prototype, a callee is always generated before its caller,
+ * so the summary is complete when the caller is analyzed */
+typedef struct GlobalAccess GlobalAccess;
+typedef struct FuncSummary FuncSummary;
+
+struct GlobalAccess{
+    SymbolTableEntry* entry;
+    int isMod;
+    int isRef;
+    int weight; /* occurrences weighted by loop depth, of loop region only */
+    int offset; /* byte offset of constant-index array element, of loop region only */
+};
+
+struct FuncSummary{
+    char* name;
+    int numOfAccess;
+    int capacity;
+    GlobalAccess* accesses;
+};
+
+struct CallGraph{
+    int numOfFunc;
+    int capacity;
+    FuncSummary* funcs;
+};
+
+void initCallGraph(CallGraph* pThis);
+void finCallGraph(CallGraph* pThis);
+int mayRefGlobal(CallGraph* pThis, char* funcName, SymbolTableEntry* entry);
+
+/*** Array Alias Analysis ***/
+/* local and global arrays are distinct objects, an array parameter refers to one of the
+ * arrays passed to it. before code generation, the arrays bound to each parameter by call sites
+ * and the arrays each function reads or writes are propagated over all calls until stable.
+ * names are resolved syntactically, a local array name also stands for the global one */
+typedef struct ArrayRoot ArrayRoot;
+typedef struct ArrayRootSet ArrayRootSet;
+typedef struct FuncAliases FuncAliases;
+
+struct ArrayRoot{
+    char* funcName; /* function of local array or parameter, NULL for global array */
+    char* name;
+    int isMod;
+    int isRef;
+};
+
+struct ArrayRootSet{
+    int numOfRoot;
+    int capacity;
+    ArrayRoot* roots;
+};
+
+struct FuncAliases{
+    char* name;
+    AST_NODE* blockNode;
+    int numOfParam;
+    char** paramNames; /* every parameter, a typedef name may declare an array */
+    ArrayRootSet* paramRoots; /* arrays each parameter may refer to */
+    ArrayRootSet localArrays;
+    ArrayRootSet accesses; /* global arrays and own parameters read or written, directly or by callees */
+};
+
+struct AliasAnalysis{
+    int numOfFunc;
+    int capacity;
+    FuncAliases* funcs;
+    FuncAliases* current; /* function being generated */
+};
+
+void initAliasAnalysis(AliasAnalysis* pThis);
+void finAliasAnalysis(AliasAnalysis* pThis);
+void analyzeArrayAliases(AliasAnalysis* pThis, AST_NODE* programNode);
+void setAliasFunc(AliasAnalysis* pThis, char* funcName);
+int isArrayElement(AST_NODE* idNode);
+/* identifier indexed in every dimension */
+int mayAliasArray(AliasAnalysis* pThis, SymbolTableEntry* entry1, SymbolTableEntry* entry2);
+int mayAliasElement(AliasAnalysis* pThis, SymbolTableEntry* entry1, AST_NODE* index1,
+  SymbolTableEntry* entry2, AST_NODE* index2);
+/* index list is NULL if unknown, indices of the same array are compared in current variable values */
+int callMayTouchArray(AliasAnalysis* pThis, AST_NODE* funcCallNode, SymbolTableEntry* entry, int isModOnly);
+
+/*** Value Range Analysis ***/
+/* range of int expression without call, in current variable values. a local index of a counted
+ * loop is within loop bounds in body, and within the dimension of an array indexed by it in
+ * assignments at the start of body, which run on every iteration. an int parameter its function
+ * never assigns is within the constants passed by all call sites, matched by name like arrays.
+ * a result which may overflow is unknown */
+#define RANGE_MIN (-0x7fffffffLL - 1)
+#define RANGE_MAX 0x7fffffffLL
+
+typedef struct ParamRange ParamRange;
+typedef struct FuncRanges FuncRanges;
+
+struct ParamRange{
+    char* name;
+    SymbolTableEntry* entry; /* resolved when function is generated */
+    int isKnown; /* not assigned, and only constants passed */
+    int isCalled;
+    int min;
+    int max;
+};
+
+struct FuncRanges{
+    char* name;
+    int numOfParam;
+    ParamRange* params;
+};
+
+struct RangeAnalysis{
+    int numOfFunc;
+    int capacity;
+    FuncRanges* funcs;
+    FuncRanges* current; /* function being generated */
+};
+
+void initRangeAnalysis(RangeAnalysis* pThis);
+void finRangeAnalysis(RangeAnalysis* pThis);
+void analyzeParamRanges(RangeAnalysis* pThis, AST_NODE* programNode);
+void setRangeFunc(RangeAnalysis* pThis, char* funcName, STT* symbolTable);
+int getExprRange(AST_NODE* exprNode, int* min, int* max);
+/* return 0 if expression isn't int or may call, full range if nothing is known */
+int getKnownCondition(AST_NODE* condNode, int* outcome);
+/* return 0 if condition may be either true or false */
+
+/*** Global Variable Caching ***/
+/* in each outermost loop, global scalars which no callee modifies are kept in
+ * variable registers left by locals. they are loaded before the loop, and written back
+ * after it, before return, and before calling a function which may read them.
+ * constant-index array elements are cached the same way, if nothing else in the loop
+ * may access them */
+struct CachedGlobal{
+    AST_NODE* regionNode;
+    SymbolTableEntry* entry;
+    int offset; /* byte offset of array element */
+    int regNum;
+    int isWritten;
+};
+
+void genEnterCacheRegion(FILE* targetFile, AST_NODE* regionNode);
+void genExitCacheRegion(FILE* targetFile, AST_NODE* regionNode);
+void genFlushCachedGlobals(FILE* targetFile, char* calleeName);
+/* calleeName NULL writes back all cached globals */
+int findCachedElement(LocalVarSet* pThis, SymbolTableEntry* entry, int offset);
+/* return register of array element cached in current loop, -1 if not cached */
+
+/*** Loop Unrolling ***/
+/* an innermost for(i = c0; i < bound; i = i + step) whose local index and bound are
+ * not assigned in body runs copies of body and increment between tests.
+ * with a constant trip count, the copies repeat in a loop tested at the bottom and
+ * the remainder follows, or the loop is unrolled fully. otherwise a group of copies runs
+ * while that many iterations are left, and the original loop runs the rest.
+ * copies are limited by a budget of AST nodes */
+#define UNROLL_BUDGET 96
+#define MAX_UNROLL_FACTOR 4
+#define MAX_FULL_UNROLL 16
+#define MAX_UNROLL_STEP 1024
+#define MAX_ACCUMULATOR 4
+
+typedef struct CountedLoop CountedLoop;
+
+struct CountedLoop{
+    AST_NODE* indexNode; /* of condition */
+    AST_NODE* boundNode; /* constant or local scalar */
+    AST_NODE* initNode; /* NULL if the index isn't initialized alone */
+    int isInclusive; /* i <= bound */
+    int step;
+    int first; /* constant initial value */
+    int tripCount; /* -1 if unknown at compile time */
+    int factor; /* copies of body per test */
+    AST_NODE* reductionNode; /* lvalue of an int sum the copies add into separate registers, or NULL */
+};
+
+int analyzeCountedLoop(LocalVarSet* pThis, AST_NODE* forStmtNode, CountedLoop* loop);
+/* return unroll factor, 1 if loop isn't unrolled */
+
+/*** Loop Nest Optimization ***/
+/* two perfectly nested counted loops whose body indexes arrays by i + c of the loop indices.
+ * headers are swapped if more accesses get unit stride in the inner loop, and a large
+ * sweep which still walks a row-major array by column runs in tiles of the inner range.
+ * both need that no dependence between iterations of the nest reverses direction, and that
+ * the indices end with the same values or are assigned again before use */
+#define TILE_SIZE 16
+#define MIN_TILED_ITERATIONS 4096
+#define MAX_TILED_LOOP 8
+#define MAX_NEST_ACCESS 32
+
+/* subscript of an array access in loop nest is index + constant, or doesn't change in the nest */
+#define SUBSCRIPT_UNKNOWN 0
+#define SUBSCRIPT_NONE 1
+#define SUBSCRIPT_OUTER 2
+#define SUBSCRIPT_INNER 3
+#define SUBSCRIPT_INVARIANT 4
+
+typedef struct LoopNest LoopNest;
+struct LoopNest{
+    AST_NODE* outerNode;
+    AST_NODE* innerNode;
+    CountedLoop outer;
+    CountedLoop inner;
+    int numOfStmt; /* assignments of inner body in order */
+    AST_NODE* stmts[MAX_NEST_ACCESS];
+    int numOfAccess; /* array elements */
+    AST_NODE* accesses[MAX_NEST_ACCESS];
+    int numOfWritten; /* scalars */
+    SymbolTableEntry* written[MAX_NEST_ACCESS];
+};
+
+struct TiledLoop{
+    AST_NODE* outerNode;
+    AST_NODE* innerNode;
+    int first; /* range of inner index, step 1 */
+    int last;
+    int tileRegNum; /* first inner index of current tile, -1 if no register is left */
+    int limitRegNum; /* end of current tile */
+    int isActive; /* tiles are being generated */
+};
+
+TiledLoop* findTiledLoop(LocalVarSet* pThis, AST_NODE* forStmtNode);
+/* tile of outer or inner loop, NULL if loop isn't tiled */
+
+/*** Idiom Recognition ***/
+/* a counted loop with step 1 whose body only stores an invariant value into consecutive elements,
+ * or copies consecutive elements of an array, calls a block routine of the runtime.
+ * a nest whose inner loop walks whole rows is a single call */
+#define MIN_IDIOM_TRIP 8
+#define IDIOM_NONE 0
+#define IDIOM_FILL 1
+#define IDIOM_COPY 2
+
+typedef struct LoopIdiom LoopIdiom;
+struct LoopIdiom{
+    int kind;
+    AST_NODE* destNode; /* lvalue, its address at the initial indices is the first element */
+    AST_NODE* srcNode; /* value stored, or element copied */
+    CountedLoop loop;
+    AST_NODE* rowLoopNode; /* inner loop over whole rows, NULL if loop isn't a nest */
+    AST_NODE* rowIndexNode;
+    int rowLength;
+};
+
+int analyzeLoopIdiom(LocalVarSet* pThis, AST_NODE* forStmtNode, LoopIdiom* idiom);
+/* return kind of idiom, IDIOM_NONE if loop isn't one */
+
+/*** Loop Unswitching ***/
+/* an if statement in a loop whose condition only compares scalars the loop doesn't assign
+ * is tested once before the loop, and the loop is generated twice, with the branch taken
+ * and not taken. the condition has no arithmetic, so testing it early can't trap */
+#define MAX_UNSWITCHED_LOOP 8
+#define MAX_UNSWITCHED_SIZE 300 /* AST nodes of loop */
+
+struct UnswitchedLoop{
+    AST_NODE* loopNode;
+    AST_NODE* ifNode;
+    int outcome; /* branch taken by the copy being generated, -1 outside of loop */
+};
+
+UnswitchedLoop* findUnswitchedLoop(LocalVarSet* pThis, AST_NODE* loopNode);
+/* NULL if loop isn't unswitched */
+int findUnswitchedOutcome(LocalVarSet* pThis, AST_NODE* ifStmtNode);
+/* branch of if statement taken by the copy being generated, -1 if it's tested in place */
+
+/*** If Conversion ***/
+/* an if statement whose branches assign one scalar is generated without branch,
+ * values of both branches are computed and a conditional move picks one.
+ * they can't trap or write, an array element is read only if the condition reads it */
+#define MAX_SELECT_OPS 4 /* operators of both values */
+
+int isSelectIf(AST_NODE* ifStmtNode, AST_NODE** thenAssignNode, AST_NODE** elseAssignNode);
+/* else assignment is NULL if if statement has no else */
+
+/*** Multi-way Branch ***/
+/* a chain of if else statements testing one int expression for equality to constants
+ * evaluates it once. dense values index a jump table, sparse ones are binary searched */
+#define MIN_SWITCH_CASES 4
+#define MAX_SWITCH_CASES 64
+#define MAX_JUMP_TABLE 256 /* entries */
+#define MAX_TABLE_SPREAD 3 /* range of values is at most this times cases for a table */
+#define MAX_LINEAR_CASES 3 /* leaf of search tree tests them one by one */
+
+typedef struct SwitchChain SwitchChain;
+struct SwitchChain{
+    AST_NODE* exprNode; /* compared in every test */
+    int numOfCase;
+    int values[MAX_SWITCH_CASES];
+    AST_NODE* caseNodes[MAX_SWITCH_CASES]; /* then statement of each test, in source order */
+    AST_NODE* defaultNode; /* last else, NUL_NODE if none */
+};
+
+int analyzeSwitchChain(LocalVarSet* pThis, AST_NODE* ifStmtNode, SwitchChain* chain);
+/* return 0 if if statement isn't a chain */
+
+/*** Expression Simplification ***/
+/* after symbols are bound, chains of int + and - or of int * are flattened. their constants fold
+ * into one last operand, a pure term both added and subtracted cancels, and terms without call
+ * are regrouped into a balanced tree, otherwise terms keep their evaluation order. identities
+ * like x * 1, x - 0, -(-x), !!x and !(a < b) are simplified. float chains are reassociated only
+ * with -ffast-math, since rounding depends on the order */
+#define MAX_CHAIN_TERMS 32
+#define MIN_BALANCED_TERMS 4
+
+typedef struct ExprChain ExprChain;
+struct ExprChain{
+    BINARY_OPERATOR op; /* BINARY_OP_ADD for + and -, or BINARY_OP_MUL */
+    DATA_TYPE type;
+    int numOfTerm;
+    AST_NODE* terms[MAX_CHAIN_TERMS]; /* in evaluation order */
+    int isNegative[MAX_CHAIN_TERMS]; /* subtracted term */
+    int numOfConst;
+    int isConstLast; /* the only constant is already the last operand */
+    int intConst;
+    float floatConst;
+};
+
+/*** Local Value Numbering ***/
+/* values loaded from variables and array elements, and computed array offsets, are kept
+ * in pinned registers and reused until the end of basic block, or a store or call kills them.
+ * a value not used by current statement is evicted when registers run out.
+ * arithmetic on scalars is hash-consed by structure like a DAG node. it is kept only if the
+ * same expression occurs again later in basic block, and dropped after its last counted use */
+#define MAX_VALUE_NUM 32
+#define MIN_FREE_REG_NUM 4
+
+typedef struct Value Value;
+
+typedef enum ValueKind{
+    SCALAR_VALUE,
+    ELEMENT_VALUE,
+    OFFSET_VALUE, /* byte offset of dynamic array index */
+    EXPR_VALUE /* arithmetic on scalars */
+} ValueKind;
+
+struct Value{
+    ValueKind kind;
+    SymbolTableEntry* entry;
+    int offset; /* byte offset of constant array index */
+    AST_NODE* indexNode; /* first index of array element or offset */
+    DATA_TYPE type;
+    int regNum;
+    int stmtStamp; /* statement which used it last */
+    int isValid; /* killed value keeps its register until its statement ends */
+    AST_NODE* exprNode; /* expression of EXPR_VALUE, its operands are indexNode */
+    int numOfUse; /* uses of EXPR_VALUE left */
+};
+
+struct ValueTable{
+    int numOfValue;
+    Value values[MAX_VALUE_NUM];
+    int stmtStamp;
+};
+
+void initValueTable(ValueTable* pThis);
+void clearValueTable(ValueTable* pThis);
+/* between functions */
+void killAllValues(ValueTable* pThis);
+/* at label, control flow joins */
+void beginValueStmt(ValueTable* pThis);
+int evictValue(ValueTable* pThis, RegisterManager* regManager);
+int isPureIndex(AST_NODE* node);
+int getValueKey(AST_NODE* idNode, Value* key);
+/* call before identifier is loaded, return 0 if its value can't be numbered */
+int getExprValueKey(AST_NODE* exprNode, Value* key);
+/* return 0 if expression can't be numbered */
+int countLaterUses(AST_NODE* exprNode);
+/* occurrences of the same expression after this one in basic block, estimated */
+int findValue(ValueTable* pThis, Value* key);
+/* return register, -1 if not found */
+void addValue(ValueTable* pThis, Value* key, int regNum);
+void assignValue(ValueTable* pThis, AST_NODE* lvalueNode, int regNum, int isStored);
+void killValuesAtCall(ValueTable* pThis, AST_NODE* funcCallNode);
+void genLabel(FILE* targetFile, int labelNum);
+
+/*** Runtime Library ***/
+/* bits of GR.runtimeUsed */
+#define RUNTIME_OUTPUT 1
+#define RUNTIME_INPUT 2
+#define RUNTIME_FILL 4
+#define RUNTIME_COPY 8
+
+void genRuntime(FILE* targetFile);
+
+/*** Instruction Selection ***/
+/* operator node, or condition with its branch, is covered by the cheapest tile matching it.
+ * tile is a template of real MIPS instructions, costed by INSTR_COSTS, so no pseudo
+ * instruction hides its expansion. new pattern is one more entry of TILES.
+ * template operands: D result, A B operands, fA fB float operands, S scratch register,
+ * L label, I constant, J constant + 1, N negated constant, U unsigned constant */
+#define MAX_TILE_INSTR 3
+#define MAX_TILE_INSTR_LEN 32
+#define MAX_TILE_TOKEN 8
+
+typedef enum TileShape{
+    UNARY_TILE,
+    REG_REG_TILE,  /* operands in registers */
+    REG_IMM_TILE,  /* second operand is constant in immediate field */
+    REG_ZERO_TILE  /* second operand is 0, read from $0 */
+}TileShape;
+
+typedef enum TileKind{
+    VALUE_TILE,        /* result in register D */
+    TRUE_BRANCH_TILE,  /* jump to L if true */
+    FALSE_BRANCH_TILE  /* jump to L if false */
+}TileKind;
+
+typedef struct InstrCost InstrCost;
+typedef struct InstrTile InstrTile;
+struct InstrCost{
+    char* name;
+    int cost;
+};
+
+struct InstrTile{
+    DATA_TYPE type; /* operand type */
+    int op; /* UNARY_OPERATOR of UNARY_TILE, BINARY_OPERATOR otherwise */
+    TileShape shape;
+    TileKind kind;
+    char* instrs[MAX_TILE_INSTR];
+};
+
+const InstrTile* selectTile(DATA_TYPE type, int op, TileShape shape, int value, TileKind kind);
+/* cheapest tile, REG_IMM_TILE with 0 may take REG_ZERO_TILE. return NULL if no tile matches */
+int getTileCost(const InstrTile* tile);
+void genTile(FILE* targetFile, const InstrTile* tile,
+  int destRegNum, int src1RegNum, int src2RegNum, int value, int label);
+
+/*** Instruction Scheduling ***/
+/* post pass over output.s. each basic block of .text is list scheduled by R2000/R3000
+ * latencies of INSTR_FORMATS, so independent instructions fill load-use and mult gaps.
+ * with delay slots, instruction no later one depends on moves after branch, otherwise nop,
+ * and nop also separates load from its use */
+#define MAX_SCHED_BLOCK 64
+#define MAX_SCHED_OPERAND 4
+#define MAX_SCHED_LABEL 64
+#define MAX_ASM_LINE 256
+/* resource: $0 - $31, $f0 - $f31, HI, LO, float condition flag */
+#define FIRST_FP_RESOURCE 32
+#define HI_RESOURCE 64
+#define LO_RESOURCE 65
+#define FCC_RESOURCE 66
+#define NUM_OF_RESOURCE 67
+
+/* flags of InstrFormat */
+#define SCHED_LOAD 1
+#define SCHED_STORE 2
+#define SCHED_BRANCH 4 /* ends basic block, has delay slot */
+#define SCHED_BARRIER 8 /* ends basic block in place */
+#define SCHED_DOUBLE 16 /* float register operand is a pair */
+#define SCHED_DEF_HILO 32
+#define SCHED_USE_HI 64
+#define SCHED_USE_LO 128
+#define SCHED_DEF_FCC 256
+#define SCHED_USE_FCC 512
+#define SCHED_LINK 1024 /* defines $ra */
+#define SCHED_PSEUDO 2048 /* may expand to several instructions, never in delay slot */
+
+typedef struct InstrFormat InstrFormat;
+typedef struct SchedInstr SchedInstr;
+typedef struct AsmScheduler AsmScheduler;
+struct InstrFormat{
+    char* mnemonic;
+    char* roles; /* per operand, d def, u use, b def and use, m memory address, i immediate or label */
+    int latency; /* cycles until result can be used */
+    int flags;
+    int memWidth; /* bytes accessed by load/store */
+};
+
+struct SchedInstr{
+    int firstLine; /* comment lines before instruction move with it */
+    int lastLine;
+    const InstrFormat* format;
+    char isDef[NUM_OF_RESOURCE];
+    char isUse[NUM_OF_RESOURCE];
+    int memBase; /* -1 if address has no base register */
+    char memLabel[MAX_SCHED_LABEL];
+    int memOffset;
+    int isSlotSafe; /* single real instruction */
+};
+
+struct AsmScheduler{
+    FILE* targetFile;
+    char** lines;
+    int isDelaySlot;
+    int isLoadPending; /* last instruction emitted is load */
+    char loadDef[NUM_OF_RESOURCE];
+};
+
+void scheduleAsmFile(char* fileName, int isDelaySlot);
+/* rewrite file in place, isDelaySlot for SPIM with delayed branches and loads */
+
 /*** MIPS instruction generation ***/
+/* multiplication and division by constant avoid slow mult/div,
+ * mult by constant with more shifts and adds than this stays mult */
+#define MAX_MUL_SHIFT_INSTR 4
+/* $t8, only used inside one emitted instruction sequence */
+#define SCRATCH_REG_NUM 24
+
 void genIntUnaryOpInstr(FILE* targetFile, UNARY_OPERATOR op, int destRegNum, int srcRegNum);
 void genFloatUnaryOpInstr(FILE* targetFile, UNARY_OPERATOR op, int destRegNum, int srcRegNum);
 void genIntBinaryOpInstr(FILE* targetFile, BINARY_OPERATOR op, 
@@ -103,35 +722,22 @@ void genAddOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2Reg
 void genSubOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
 void genMulOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
 void genDivOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-
-void genEQExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-void genNEExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
+int genMulConstInstr(FILE* targetFile, int destRegNum, int srcRegNum, int value);
+/* shifts and adds, return 0 without output if it takes more than MAX_MUL_SHIFT_INSTR */
+void genDivConstInstr(FILE* targetFile, int destRegNum, int srcRegNum, int value, int isNonNegative);
+/* shifts, or multiply-high by magic number, for nonzero value. no sign fix for non-negative dividend */
+void genIntImmOpInstr(FILE* targetFile, BINARY_OPERATOR op, int destRegNum, int srcRegNum, int value);
+/* add, sub and relational operation with constant in immediate field */
 void genLTExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-void genGTExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-void genLEExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-void genGEExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-
-void genANDExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-void genORExpr(FILE* targetFile, int destReg, int srcReg1, int srcReg2);
-void genNOTExpr(FILE* targetFile, int destReg, int srcReg);
-
-void genPosOpInstr(FILE* targetFile, int destRegNum, int srcRegNum);
-void genNegOpInstr(FILE* targetFile, int destRegNum, int srcRegNum);
 /* float instruction */
 void genFPAddOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
 void genFPSubOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
 void genFPMulOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
 void genFPDivOpInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-
-void genFPEQInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-void genFPNEInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-void genFPLTInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-void genFPGTInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-void genFPGEInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-void genFPLEInstr(FILE* targetFile, int destRegNum, int src1RegNum, int src2RegNum);
-
 void genFPPosOpInstr(FILE* targetFile, int destRegNum, int srcRegNum);
 void genFPNegOpInstr(FILE* targetFile, int destRegNum, int srcRegNum);
+void genLoadIntConstInstr(FILE* targetFile, int destRegNum, int value);
+void genLoadFloatConstInstr(FILE* targetFile, int destRegNum, float value);
 /* casting */
 void genFloatToInt(FILE* targetFile, int destRegNum, int floatRegNum);
 void genIntToFloat(FILE* targetFile, int destRegNum, int intRegNum);
@@ -139,4 +745,7 @@ void genIntToFloat(FILE* targetFile, int destRegNum, int intRegNum);
 void genRead(FILE *targetFile);
 void genFRead(FILE *targetFile);
 void genWrite(FILE *targetFile, STT* symbolTable, AST_NODE* funcCallNode);
+int isWriteStmt(AST_NODE* stmtNode);
+AST_NODE* genWriteSequence(FILE *targetFile, STT* symbolTable, AST_NODE* firstWriteNode);
+/* merge consecutive write() calls, return the statement after them */
 #endif
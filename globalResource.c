@@ -5,6 +5,9 @@
 void GRinit(struct GlobalResource* GR){
     GR->labelCounter = 1;
     GR->stackTop = 36;
+    GR->runtimeUsed = 0;
+    GR->isFastMath = 0;
+    GR->isDelaySlot = 0;
 
     GR->regManager = malloc(sizeof(RegisterManager));
     RMinit(GR->regManager, MAX_REG_NUM, FIRST_RM_REG_NUM);
@@ -13,11 +16,53 @@ void GRinit(struct GlobalResource* GR){
     
     GR->constStrings = malloc(sizeof(ConstStringSet));
     initConstStringSet(GR->constStrings);
+
+    GR->constPool = malloc(sizeof(ConstPool));
+    initConstPool(GR->constPool);
+
+    GR->localVars = malloc(sizeof(LocalVarSet));
+    initLocalVarSet(GR->localVars);
+
+    GR->callGraph = malloc(sizeof(CallGraph));
+    initCallGraph(GR->callGraph);
+
+    GR->aliasAnalysis = malloc(sizeof(AliasAnalysis));
+    initAliasAnalysis(GR->aliasAnalysis);
+
+    GR->rangeAnalysis = malloc(sizeof(RangeAnalysis));
+    initRangeAnalysis(GR->rangeAnalysis);
+
+    GR->valueTable = malloc(sizeof(ValueTable));
+    initValueTable(GR->valueTable);
 }
 
 void GRfin(struct GlobalResource* GR){
-    if(GR->constStrings)
+    if(GR->constStrings){
+        finConstStringSet(GR->constStrings);
         free(GR->constStrings);
+    }
+    if(GR->constPool){
+        finConstPool(GR->constPool);
+        free(GR->constPool);
+    }
+    if(GR->localVars){
+        finLocalVarSet(GR->localVars);
+        free(GR->localVars);
+    }
+    if(GR->callGraph){
+        finCallGraph(GR->callGraph);
+        free(GR->callGraph);
+    }
+    if(GR->aliasAnalysis){
+        finAliasAnalysis(GR->aliasAnalysis);
+        free(GR->aliasAnalysis);
+    }
+    if(GR->rangeAnalysis){
+        finRangeAnalysis(GR->rangeAnalysis);
+        free(GR->rangeAnalysis);
+    }
+    if(GR->valueTable)
+        free(GR->valueTable);
     if(GR->regManager);
         free(GR->regManager);
     if(GR->FPRegManager);
@@ -13,6 +13,12 @@ typedef struct AST_NODE AST_NODE;
 typedef struct SymbolTableTree SymbolTableTree, STT;
 typedef struct RegisterManager RegisterManager;
 typedef struct ConstStringSet ConstStringSet;
+typedef struct ConstPool ConstPool;
+typedef struct LocalVarSet LocalVarSet;
+typedef struct CallGraph CallGraph;
+typedef struct AliasAnalysis AliasAnalysis;
+typedef struct RangeAnalysis RangeAnalysis;
+typedef struct ValueTable ValueTable;
 void addBuiltinFunction(STT* symbolTable);
 
 /*** GlobalResource ***/
@@ -22,6 +28,15 @@ struct GlobalResource {
     RegisterManager* FPRegManager;
     int stackTop;
     ConstStringSet* constStrings;
+    ConstPool* constPool;
+    int runtimeUsed; /* bitmask of runtime routines called by generated code */
+    int isFastMath; /* float operations may be reassociated */
+    int isDelaySlot; /* branch and load delay slots are exposed, as SPIM -delayed_branches -delayed_loads */
+    LocalVarSet* localVars; /* of the function being generated */
+    CallGraph* callGraph; /* summaries of generated functions */
+    AliasAnalysis* aliasAnalysis; /* array parameters of the whole program */
+    RangeAnalysis* rangeAnalysis; /* int parameters of the whole program */
+    ValueTable* valueTable; /* of the basic block being generated */
 };
 
 #define MAX_REG_NUM 8
@@ -238,6 +253,9 @@ struct AST_NODE {
 		CON_Type *const1;
 	} semantic_value;
     struct ExpValPlace valPlace;
+    /* set by optimization before code generation */
+    struct SymbolTableEntry* symbolEntry; /* symbol of identifier */
+    int isDeadStore; /* assignment or initialization whose value is never read */
 };
 
 /*** other files ***/
@@ -245,5 +263,7 @@ AST_NODE *Allocate(AST_TYPE type);
 void semanticAnalysis(AST_NODE *prog, STT* symbolTable);
 void codeGen(FILE* targetFile, AST_NODE* prog, STT* symbolTable);
 void genConstStrings(ConstStringSet* pThis, FILE* targetFile);
+void genConstPool(ConstPool* pThis, FILE* targetFile);
+void genRuntime(FILE* targetFile);
 
 #endif
@@ -0,0 +1,3129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+#include "symbolTable.h"
+#include "codeGen.h"
+#include "semanticAnalysis.h"
+
+extern GlobalResource GR;
+
+/* inner function prototype */
+void _resolveSymbols(LocalVarSet* pThis, STT* symbolTable, FuncSummary* summary, AST_NODE* node, int loopDepth);
+void _liveStmt(LocalVarSet* pThis, AST_NODE* stmtNode, unsigned int* live);
+void _liveStmtList(LocalVarSet* pThis, AST_NODE* stmtNode, unsigned int* live);
+void _promoteLocalVars(LocalVarSet* pThis, int isMain);
+void _cacheGlobalsInLoops(LocalVarSet* pThis, AST_NODE* node, int numOfLocalReg, int numOfLocalFPReg, int isMain);
+int _isSameIndex(AST_NODE* index1, AST_NODE* index2);
+void _markDeadArrayStores(AST_NODE* node);
+void _optimizeLoopNests(LocalVarSet* pThis, AST_NODE* node, AST_NODE* funcBodyNode);
+void _fuseAdjacentLoops(LocalVarSet* pThis, STT* symbolTable, AST_NODE* node);
+void _unswitchLoops(LocalVarSet* pThis, AST_NODE* node);
+int _countScopes(AST_NODE* node);
+int _containsNode(AST_NODE* node, AST_NODE* target);
+int _countMentions(AST_NODE* node, SymbolTableEntry* entry);
+int _usesFloat(AST_NODE* node);
+void _simplifyExprs(AST_NODE* node);
+DATA_TYPE _exprType(AST_NODE* node);
+
+/*** Call Graph ***/
+void initCallGraph(CallGraph* pThis){
+    pThis->numOfFunc = 0;
+    pThis->capacity = 8;
+    pThis->funcs = malloc(sizeof(FuncSummary) * pThis->capacity);
+}
+
+void finCallGraph(CallGraph* pThis){
+    int i;
+    for(i = 0; i < pThis->numOfFunc; i++)
+        free(pThis->funcs[i].accesses);
+    free(pThis->funcs);
+}
+
+void _initFuncSummary(FuncSummary* summary, char* name){
+    summary->name = name;
+    summary->numOfAccess = 0;
+    summary->capacity = 4;
+    summary->accesses = malloc(sizeof(GlobalAccess) * summary->capacity);
+}
+
+FuncSummary* _findFuncSummary(CallGraph* pThis, char* name){
+    /* NULL for builtin function, it touches no global variable */
+    int i;
+    for(i = 0; i < pThis->numOfFunc; i++)
+        if(strcmp(pThis->funcs[i].name, name) == 0)
+            return &(pThis->funcs[i]);
+    return NULL;
+}
+
+FuncSummary* _addFuncSummary(CallGraph* pThis, char* name){
+    if(pThis->numOfFunc == pThis->capacity){
+        pThis->capacity *= 2;
+        pThis->funcs = realloc(pThis->funcs, sizeof(FuncSummary) * pThis->capacity);
+    }
+    FuncSummary* summary = &(pThis->funcs[pThis->numOfFunc++]);
+    _initFuncSummary(summary, name);
+    return summary;
+}
+
+GlobalAccess* _findGlobalAccess(FuncSummary* summary, SymbolTableEntry* entry){
+    int i;
+    for(i = 0; i < summary->numOfAccess; i++)
+        if(summary->accesses[i].entry == entry)
+            return &(summary->accesses[i]);
+    return NULL;
+}
+
+GlobalAccess* _addGlobalAccess(FuncSummary* summary, SymbolTableEntry* entry, int isMod, int isRef){
+    GlobalAccess* access = _findGlobalAccess(summary, entry);
+    if(!access){
+        if(summary->numOfAccess == summary->capacity){
+            summary->capacity *= 2;
+            summary->accesses = realloc(summary->accesses, sizeof(GlobalAccess) * summary->capacity);
+        }
+        access = &(summary->accesses[summary->numOfAccess++]);
+        access->entry = entry;
+        access->isMod = 0;
+        access->isRef = 0;
+        access->weight = 0;
+        access->offset = 0;
+    }
+    access->isMod |= isMod;
+    access->isRef |= isRef;
+    return access;
+}
+
+void _mergeFuncSummary(FuncSummary* dest, FuncSummary* src){
+    /* caller touches everything its callee touches */
+    int i;
+    if(!src || src == dest)
+        return;
+    for(i = 0; i < src->numOfAccess; i++)
+        _addGlobalAccess(dest, src->accesses[i].entry, src->accesses[i].isMod, src->accesses[i].isRef);
+}
+
+int mayRefGlobal(CallGraph* pThis, char* funcName, SymbolTableEntry* entry){
+    FuncSummary* summary = _findFuncSummary(pThis, funcName);
+    GlobalAccess* access = summary ? _findGlobalAccess(summary, entry) : NULL;
+    return access && access->isRef;
+}
+
+/*** Local Variable Optimization ***/
+void initLocalVarSet(LocalVarSet* pThis){
+    pThis->numOfVar = 0;
+    pThis->capacity = 16;
+    pThis->vars = malloc(sizeof(LocalVar) * pThis->capacity);
+    pThis->numOfWord = 1;
+    pThis->numOfVarReg = 0;
+    pThis->numOfVarFPReg = 0;
+    pThis->saveOffset = 0;
+    pThis->numOfCached = 0;
+    pThis->capacityOfCached = 8;
+    pThis->cached = malloc(sizeof(CachedGlobal) * pThis->capacityOfCached);
+    pThis->activeRegion = NULL;
+    pThis->numOfTiled = 0;
+    pThis->tiled = malloc(sizeof(TiledLoop) * MAX_TILED_LOOP);
+    pThis->numOfUnswitched = 0;
+    pThis->unswitched = malloc(sizeof(UnswitchedLoop) * MAX_UNSWITCHED_LOOP);
+}
+
+void finLocalVarSet(LocalVarSet* pThis){
+    free(pThis->vars);
+    free(pThis->cached);
+    free(pThis->tiled);
+    free(pThis->unswitched);
+}
+
+int _findLocalVar(LocalVarSet* pThis, SymbolTableEntry* entry){
+    /* return index of local scalar variable, -1 if entry isn't one */
+    int i;
+    if(!entry)
+        return -1;
+    for(i = 0; i < pThis->numOfVar; i++)
+        if(pThis->vars[i].entry == entry)
+            return i;
+    return -1;
+}
+
+int _addLocalVar(LocalVarSet* pThis, SymbolTableEntry* entry){
+    int index = _findLocalVar(pThis, entry);
+    if(index != -1)
+        return index;
+
+    if(pThis->numOfVar == pThis->capacity){
+        pThis->capacity *= 2;
+        pThis->vars = realloc(pThis->vars, sizeof(LocalVar) * pThis->capacity);
+    }
+    LocalVar* var = &(pThis->vars[pThis->numOfVar]);
+    var->entry = entry;
+    var->paraOffset = 0;
+    var->isLiveAtEntry = 0;
+    var->numOfRead = 0;
+    var->weight = 0;
+    return pThis->numOfVar++;
+}
+
+int isUnusedLocalVar(LocalVarSet* pThis, SymbolTableEntry* entry){
+    /* local never read needs no storage, all stores to it are dead */
+    int index = _findLocalVar(pThis, entry);
+    if(index == -1)
+        return 0;
+    return pThis->vars[index].numOfRead == 0 && pThis->vars[index].paraOffset == 0;
+}
+
+int hasFuncCall(AST_NODE* node){
+    /* node or its descendant calls a function, it has side effect */
+    if(node->nodeType == STMT_NODE &&
+      node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT)
+        return 1;
+
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        if(hasFuncCall(child))
+            return 1;
+    return 0;
+}
+
+int isDeadAssignment(AST_NODE* assignmentNode){
+    if(assignmentNode->nodeType != STMT_NODE ||
+      assignmentNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT)
+        return 0;
+    return assignmentNode->isDeadStore && !hasFuncCall(assignmentNode->child->rightSibling);
+}
+
+int _isDefinedId(AST_NODE* idNode){
+    /* identifier is declared or assigned, not read */
+    AST_NODE* parent = idNode->parent;
+    if(parent->nodeType == DECLARATION_NODE)
+        return 1;
+    return parent->nodeType == STMT_NODE &&
+      parent->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT && parent->child == idNode;
+}
+
+void _resolveSymbols(LocalVarSet* pThis, STT* symbolTable, FuncSummary* summary, AST_NODE* node, int loopDepth){
+    /* bind identifiers to symbols, collect local scalar variables and global scalars used by function.
+     * scopes are opened in the same order as code generation */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == BLOCK_NODE){
+            openScope(symbolTable, USE, NULL);
+            _resolveSymbols(pThis, symbolTable, summary, node->child, loopDepth);
+            closeScope(symbolTable);
+            continue;
+        }
+
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT){
+            /* callee is generated before caller */
+            char* calleeName = node->child->semantic_value.identifierSemanticValue.identifierName;
+            _mergeFuncSummary(summary, _findFuncSummary(GR.callGraph, calleeName));
+        }
+
+        if(node->nodeType == IDENTIFIER_NODE){
+            char* name = node->semantic_value.identifierSemanticValue.identifierName;
+            int level;
+            SymbolTableEntry* entry = lookupSymbolWithLevel(symbolTable, name, &level);
+            node->symbolEntry = entry;
+
+            if(entry && level > 0 && entry->kind != FUNC_ENTRY && entry->kind != TYPE_ENTRY &&
+              entry->type->dimension == 0){
+                LocalVar* var = &(pThis->vars[_addLocalVar(pThis, entry)]);
+                var->weight += 1 << (3 * (loopDepth < 4 ? loopDepth : 4));
+                if(!_isDefinedId(node))
+                    var->numOfRead++;
+            }
+            else if(entry && level == 0 && entry->kind == VAR_ENTRY && entry->type->dimension == 0)
+                _addGlobalAccess(summary, entry, _isDefinedId(node), !_isDefinedId(node));
+        }
+
+        int childLoopDepth = loopDepth;
+        if(node->nodeType == STMT_NODE &&
+          (node->semantic_value.stmtSemanticValue.kind == WHILE_STMT ||
+           node->semantic_value.stmtSemanticValue.kind == FOR_STMT))
+            childLoopDepth++;
+        _resolveSymbols(pThis, symbolTable, summary, node->child, childLoopDepth);
+    }
+}
+
+/* live set, bit i is set if variable i may be read before it is assigned */
+unsigned int* _newLiveSet(LocalVarSet* pThis){
+    return calloc(pThis->numOfWord, sizeof(unsigned int));
+}
+
+void _copyLiveSet(LocalVarSet* pThis, unsigned int* dest, unsigned int* src){
+    memcpy(dest, src, sizeof(unsigned int) * pThis->numOfWord);
+}
+
+void _unionLiveSet(LocalVarSet* pThis, unsigned int* dest, unsigned int* src){
+    int i;
+    for(i = 0; i < pThis->numOfWord; i++)
+        dest[i] |= src[i];
+}
+
+int _isLive(unsigned int* live, int index){
+    return (live[index / 32] >> (index % 32)) & 1;
+}
+
+void _setLive(unsigned int* live, int index, int isLive){
+    if(isLive)
+        live[index / 32] |= 1u << (index % 32);
+    else
+        live[index / 32] &= ~(1u << (index % 32));
+}
+
+/* transfer functions, live is the set after the node on entry, before the node on return */
+void _liveUses(LocalVarSet* pThis, AST_NODE* node, unsigned int* live){
+    /* variables read by expression */
+    if(node->nodeType == IDENTIFIER_NODE){
+        int index = _findLocalVar(pThis, node->symbolEntry);
+        if(index != -1)
+            _setLive(live, index, 1);
+    }
+
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        _liveUses(pThis, child, live);
+}
+
+void _liveAssignExpr(LocalVarSet* pThis, AST_NODE* node, unsigned int* live, int isValueUsed){
+    if(node->nodeType != STMT_NODE || node->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT){
+        _liveUses(pThis, node, live);
+        return;
+    }
+
+    AST_NODE* lvalueNode = node->child;
+    AST_NODE* rvalueNode = lvalueNode->rightSibling;
+    int index = _findLocalVar(pThis, lvalueNode->symbolEntry);
+    node->isDeadStore = 0;
+    if(index == -1)
+        _liveUses(pThis, lvalueNode, live); /* array index */
+    else{
+        node->isDeadStore = !_isLive(live, index);
+        _setLive(live, index, 0);
+    }
+
+    /* rvalue of dead assignment isn't evaluated unless its value is needed */
+    if(!node->isDeadStore || isValueUsed || hasFuncCall(rvalueNode))
+        _liveUses(pThis, rvalueNode, live);
+}
+
+void _liveAssignExprList(LocalVarSet* pThis, AST_NODE* node, unsigned int* live, int isLastValueUsed){
+    if(!node)
+        return;
+    _liveAssignExprList(pThis, node->rightSibling, live, isLastValueUsed);
+    _liveAssignExpr(pThis, node, live, isLastValueUsed && !node->rightSibling);
+}
+
+void _liveDeclList(LocalVarSet* pThis, AST_NODE* declListNode, unsigned int* live){
+    /* initializers are constant, only kill variables */
+    AST_NODE* declNode;
+    for(declNode = declListNode->child; declNode; declNode = declNode->rightSibling){
+        if(declNode->semantic_value.declSemanticValue.kind != VARIABLE_DECL)
+            continue;
+
+        AST_NODE* variableNode;
+        for(variableNode = declNode->child->rightSibling; variableNode; variableNode = variableNode->rightSibling){
+            int index = _findLocalVar(pThis, variableNode->symbolEntry);
+            if(index == -1 || variableNode->semantic_value.identifierSemanticValue.kind != WITH_INIT_ID)
+                continue;
+            variableNode->isDeadStore = !_isLive(live, index);
+            _setLive(live, index, 0);
+        }
+    }
+}
+
+void _liveBlockItems(LocalVarSet* pThis, AST_NODE* node, unsigned int* live){
+    /* children of block: declaration list and statement list */
+    if(!node)
+        return;
+    _liveBlockItems(pThis, node->rightSibling, live);
+    if(node->nodeType == VARIABLE_DECL_LIST_NODE)
+        _liveDeclList(pThis, node, live);
+    else if(node->nodeType == STMT_LIST_NODE)
+        _liveStmtList(pThis, node->child, live);
+}
+
+void _liveStmtList(LocalVarSet* pThis, AST_NODE* stmtNode, unsigned int* live){
+    if(!stmtNode)
+        return;
+    _liveStmtList(pThis, stmtNode->rightSibling, live);
+    _liveStmt(pThis, stmtNode, live);
+}
+
+void _liveIfStmt(LocalVarSet* pThis, AST_NODE* ifStmtNode, unsigned int* live){
+    AST_NODE* testNode = ifStmtNode->child;
+    AST_NODE* thenNode = testNode->rightSibling;
+    AST_NODE* elseNode = thenNode->rightSibling;
+
+    unsigned int* elseLive = _newLiveSet(pThis);
+    _copyLiveSet(pThis, elseLive, live);
+    _liveStmt(pThis, thenNode, live);
+    _liveStmt(pThis, elseNode, elseLive);
+    _unionLiveSet(pThis, live, elseLive);
+    free(elseLive);
+
+    _liveAssignExpr(pThis, testNode, live, 1);
+}
+
+void _liveWhileStmt(LocalVarSet* pThis, AST_NODE* whileStmtNode, unsigned int* live){
+    /* iterate until live set at the test is stable */
+    AST_NODE* testNode = whileStmtNode->child;
+    AST_NODE* bodyNode = testNode->rightSibling;
+
+    unsigned int* exitLive = _newLiveSet(pThis);
+    unsigned int* testLive = _newLiveSet(pThis);
+    _copyLiveSet(pThis, exitLive, live);
+    _copyLiveSet(pThis, testLive, live);
+    _liveAssignExpr(pThis, testNode, testLive, 1);
+
+    while(1){
+        _copyLiveSet(pThis, live, testLive);
+        _liveStmt(pThis, bodyNode, live);
+        _unionLiveSet(pThis, live, exitLive);
+        _liveAssignExpr(pThis, testNode, live, 1);
+
+        if(memcmp(live, testLive, sizeof(unsigned int) * pThis->numOfWord) == 0)
+            break;
+        _copyLiveSet(pThis, testLive, live);
+    }
+    free(exitLive);
+    free(testLive);
+}
+
+void _liveForStmt(LocalVarSet* pThis, AST_NODE* forStmtNode, unsigned int* live){
+    /* init; test: cond; body; inc; goto test */
+    AST_NODE* initNode = forStmtNode->child;
+    AST_NODE* condNode = initNode->rightSibling;
+    AST_NODE* incNode  = condNode->rightSibling;
+    AST_NODE* bodyNode = incNode->rightSibling;
+
+    unsigned int* exitLive = _newLiveSet(pThis);
+    unsigned int* testLive = _newLiveSet(pThis);
+    _copyLiveSet(pThis, exitLive, live);
+    _copyLiveSet(pThis, testLive, live);
+    _liveAssignExprList(pThis, condNode->child, testLive, 1);
+
+    while(1){
+        _copyLiveSet(pThis, live, testLive);
+        _liveAssignExprList(pThis, incNode->child, live, 0);
+        _liveStmt(pThis, bodyNode, live);
+        _unionLiveSet(pThis, live, exitLive);
+        _liveAssignExprList(pThis, condNode->child, live, 1);
+
+        if(memcmp(live, testLive, sizeof(unsigned int) * pThis->numOfWord) == 0)
+            break;
+        _copyLiveSet(pThis, testLive, live);
+    }
+    free(exitLive);
+    free(testLive);
+
+    _liveAssignExprList(pThis, initNode->child, live, 0);
+}
+
+void _liveStmt(LocalVarSet* pThis, AST_NODE* stmtNode, unsigned int* live){
+    if(stmtNode->nodeType == BLOCK_NODE){
+        _liveBlockItems(pThis, stmtNode->child, live);
+        return;
+    }
+    if(stmtNode->nodeType != STMT_NODE)
+        return; /* empty statement */
+
+    switch(stmtNode->semantic_value.stmtSemanticValue.kind){
+        case ASSIGN_STMT: _liveAssignExpr(pThis, stmtNode, live, 0); break;
+        case FUNCTION_CALL_STMT: _liveUses(pThis, stmtNode, live); break;
+        case IF_STMT: _liveIfStmt(pThis, stmtNode, live); break;
+        case WHILE_STMT: _liveWhileStmt(pThis, stmtNode, live); break;
+        case FOR_STMT: _liveForStmt(pThis, stmtNode, live); break;
+        case RETURN_STMT:
+            /* nothing is live after return */
+            memset(live, 0, sizeof(unsigned int) * pThis->numOfWord);
+            _liveUses(pThis, stmtNode, live);
+            break;
+    }
+}
+
+void _promoteLocalVars(LocalVarSet* pThis, int isMain){
+    /* variables with the largest weight get registers,
+     * outside main a register costs a save and a restore, a live parameter costs one more load */
+    int* order = malloc(sizeof(int) * (pThis->numOfVar + 1));
+    int i, j;
+    for(i = 0; i < pThis->numOfVar; i++){
+        int index = i;
+        for(j = i; j > 0 && pThis->vars[order[j - 1]].weight < pThis->vars[index].weight; j--)
+            order[j] = order[j - 1];
+        order[j] = index;
+    }
+
+    pThis->numOfVarReg = 0;
+    pThis->numOfVarFPReg = 0;
+    for(i = 0; i < pThis->numOfVar; i++){
+        LocalVar* var = &(pThis->vars[order[i]]);
+        int cost = isMain ? 0 : 2 + var->isLiveAtEntry;
+        if(var->numOfRead == 0 || var->weight <= cost)
+            continue;
+
+        DATA_TYPE type = var->entry->type->primitiveType;
+        if(type == INT_TYPE && pThis->numOfVarReg < MAX_VAR_REG_NUM)
+            setPlaceOfSymTableToReg(var->entry, FIRST_VAR_REG_NUM + pThis->numOfVarReg++);
+        else if(type == FLOAT_TYPE && pThis->numOfVarFPReg < MAX_VAR_FP_REG_NUM)
+            setPlaceOfSymTableToReg(var->entry, FIRST_VAR_FP_REG_NUM + pThis->numOfVarFPReg++);
+    }
+    free(order);
+}
+
+void analyzeLocalVars(LocalVarSet* pThis, STT* symbolTable, AST_NODE* declarationNode){
+    /* dead store elimination and register promotion of scalar locals and parameters,
+     * scalars can't be aliased in C--, only arrays are passed by address */
+    AST_NODE* paraListNode = declarationNode->child->rightSibling->rightSibling;
+    AST_NODE* blockNode = paraListNode->rightSibling;
+    pThis->numOfVar = 0;
+
+    AST_NODE* paraNode;
+    for(paraNode = paraListNode->child; paraNode; paraNode = paraNode->rightSibling){
+        AST_NODE* idNode = paraNode->child->rightSibling;
+        char* name = idNode->semantic_value.identifierSemanticValue.identifierName;
+        SymbolTableEntry* entry = lookupSymbolCurrentScope(symbolTable, name);
+        idNode->symbolEntry = entry;
+        if(entry->type->dimension == 0){
+            int index = _addLocalVar(pThis, entry);
+            pThis->vars[index].paraOffset = entry->place.place.stackOffset;
+        }
+    }
+
+    char* funcName = declarationNode->child->rightSibling->semantic_value.identifierSemanticValue.identifierName;
+    FuncSummary* summary = _addFuncSummary(GR.callGraph, funcName);
+    _resolveSymbols(pThis, symbolTable, summary, blockNode->child, 0);
+    symbolTable->lastChildScope = NULL; /* code generation enters the same scopes again */
+    _simplifyExprs(blockNode->child);
+    _fuseAdjacentLoops(pThis, symbolTable, blockNode->child);
+    symbolTable->lastChildScope = NULL;
+    pThis->numOfTiled = 0;
+    _optimizeLoopNests(pThis, blockNode->child, blockNode->child);
+    pThis->numOfUnswitched = 0;
+    _unswitchLoops(pThis, blockNode->child);
+
+    pThis->numOfWord = pThis->numOfVar / 32 + 1;
+    unsigned int* live = _newLiveSet(pThis);
+    _liveBlockItems(pThis, blockNode->child, live);
+    int i;
+    for(i = 0; i < pThis->numOfVar; i++)
+        pThis->vars[i].isLiveAtEntry = _isLive(live, i);
+    free(live);
+    _markDeadArrayStores(blockNode->child);
+
+    _promoteLocalVars(pThis, strcmp(funcName, "main") == 0);
+    pThis->numOfCached = 0;
+    pThis->activeRegion = NULL;
+    _cacheGlobalsInLoops(pThis, blockNode->child, pThis->numOfVarReg, pThis->numOfVarFPReg,
+      strcmp(funcName, "main") == 0);
+}
+
+/*** Global Variable Caching ***/
+int _constElementOffset(AST_NODE* idNode, int* offset){
+    /* byte offset of array element indexed by constants, 0 if any index is not constant */
+    TypeDescriptor* type = idNode->symbolEntry->type;
+    AST_NODE* indexNode = idNode->child;
+    int i;
+    *offset = 0;
+    for(i = 0; i < type->dimension; i++, indexNode = indexNode->rightSibling){
+        if(indexNode->nodeType != CONST_VALUE_NODE || indexNode->semantic_value.const1->const_type != INTEGERC)
+            return 0;
+        *offset = *offset * type->sizeOfEachDimension[i] + indexNode->semantic_value.const1->const_u.intval;
+    }
+    *offset *= 4;
+    return 1;
+}
+
+GlobalAccess* _addElementAccess(FuncSummary* summary, SymbolTableEntry* entry, int offset, int isMod, int isRef){
+    int i;
+    for(i = 0; i < summary->numOfAccess; i++)
+        if(summary->accesses[i].entry == entry && summary->accesses[i].offset == offset)
+            break;
+    if(i == summary->numOfAccess){
+        if(summary->numOfAccess == summary->capacity){
+            summary->capacity *= 2;
+            summary->accesses = realloc(summary->accesses, sizeof(GlobalAccess) * summary->capacity);
+        }
+        summary->numOfAccess++;
+        summary->accesses[i].entry = entry;
+        summary->accesses[i].isMod = 0;
+        summary->accesses[i].isRef = 0;
+        summary->accesses[i].weight = 0;
+        summary->accesses[i].offset = offset;
+    }
+    GlobalAccess* access = &(summary->accesses[i]);
+    access->isMod |= isMod;
+    access->isRef |= isRef;
+    return access;
+}
+
+void _scanRegion(AST_NODE* node, FuncSummary* region, FuncSummary* elements, FuncSummary* clobbered, int loopDepth){
+    /* global scalars and constant-index array elements used in loop, and the globals its callees may touch */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT){
+            char* calleeName = node->child->semantic_value.identifierSemanticValue.identifierName;
+            _mergeFuncSummary(clobbered, _findFuncSummary(GR.callGraph, calleeName));
+        }
+
+        SymbolTableEntry* entry = node->symbolEntry;
+        int offset;
+        if(node->nodeType == IDENTIFIER_NODE && entry && entry->kind == VAR_ENTRY &&
+          entry->type->dimension == 0 && entry->place.kind == GLOBAL_TYPE){
+            GlobalAccess* access = _addGlobalAccess(region, entry, _isDefinedId(node), !_isDefinedId(node));
+            access->weight += 1 << (3 * (loopDepth < 4 ? loopDepth : 4));
+        }
+        else if(node->nodeType == IDENTIFIER_NODE && isArrayElement(node) && _constElementOffset(node, &offset)){
+            GlobalAccess* access = _addElementAccess(elements, entry, offset, _isDefinedId(node), !_isDefinedId(node));
+            access->weight += 1 << (3 * (loopDepth < 4 ? loopDepth : 4));
+        }
+
+        int childLoopDepth = loopDepth;
+        if(node->nodeType == STMT_NODE &&
+          (node->semantic_value.stmtSemanticValue.kind == WHILE_STMT ||
+           node->semantic_value.stmtSemanticValue.kind == FOR_STMT))
+            childLoopDepth++;
+        _scanRegion(node->child, region, elements, clobbered, childLoopDepth);
+    }
+}
+
+int _isCacheableElement(AST_NODE* node, GlobalAccess* access){
+    /* no call, declaration, or access other than the same constant index in loop may touch the element */
+    for(; node; node = node->rightSibling){
+        SymbolTableEntry* entry = node->symbolEntry;
+        int offset;
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT &&
+          callMayTouchArray(GR.aliasAnalysis, node, access->entry, 0))
+            return 0;
+        if(node->nodeType == IDENTIFIER_NODE && entry && entry->kind != FUNC_ENTRY && entry->kind != TYPE_ENTRY &&
+          entry->type->dimension > 0){
+            if(node->parent->nodeType == DECLARATION_NODE){
+                if(entry == access->entry)
+                    return 0;
+            }
+            else if(entry == access->entry && isArrayElement(node) && _constElementOffset(node, &offset)){
+                /* the element itself, or another element of the array */
+            }
+            else if(mayAliasArray(GR.aliasAnalysis, entry, access->entry))
+                return 0;
+        }
+        if(!_isCacheableElement(node->child, access))
+            return 0;
+    }
+    return 1;
+}
+
+int* _orderByWeight(FuncSummary* summary){
+    /* indices of accesses, the most used first */
+    int* order = malloc(sizeof(int) * (summary->numOfAccess + 1));
+    int i, j;
+    for(i = 0; i < summary->numOfAccess; i++){
+        for(j = i; j > 0 && summary->accesses[order[j - 1]].weight < summary->accesses[i].weight; j--)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    return order;
+}
+
+void _addCachedVar(LocalVarSet* pThis, AST_NODE* regionNode, GlobalAccess* access, int* numOfReg, int* numOfFPReg){
+    /* take the next free variable register of its type, if any */
+    int regNum;
+    if(access->entry->type->primitiveType == INT_TYPE && *numOfReg < MAX_VAR_REG_NUM)
+        regNum = FIRST_VAR_REG_NUM + (*numOfReg)++;
+    else if(access->entry->type->primitiveType == FLOAT_TYPE && *numOfFPReg < MAX_VAR_FP_REG_NUM)
+        regNum = FIRST_VAR_FP_REG_NUM + (*numOfFPReg)++;
+    else
+        return;
+
+    if(pThis->numOfCached == pThis->capacityOfCached){
+        pThis->capacityOfCached *= 2;
+        pThis->cached = realloc(pThis->cached, sizeof(CachedGlobal) * pThis->capacityOfCached);
+    }
+    CachedGlobal* cached = &(pThis->cached[pThis->numOfCached++]);
+    cached->regionNode = regionNode;
+    cached->entry = access->entry;
+    cached->offset = access->offset;
+    cached->regNum = regNum;
+    cached->isWritten = access->isMod;
+}
+
+void _reserveTileRegs(LocalVarSet* pThis, AST_NODE* regionNode, int* numOfReg){
+    /* tiled nests of region keep the current tile in two registers, they aren't tiled if none is left */
+    int i, isReserved = 0;
+    for(i = 0; i < pThis->numOfTiled; i++){
+        TiledLoop* tile = &(pThis->tiled[i]);
+        if(!_containsNode(regionNode, tile->outerNode) || *numOfReg + 2 > MAX_VAR_REG_NUM)
+            continue;
+        tile->tileRegNum = FIRST_VAR_REG_NUM + *numOfReg;
+        tile->limitRegNum = FIRST_VAR_REG_NUM + *numOfReg + 1;
+        isReserved = 1;
+    }
+    if(isReserved)
+        *numOfReg += 2;
+}
+
+void _cacheGlobalsInRegion(LocalVarSet* pThis, AST_NODE* regionNode, int numOfLocalReg, int numOfLocalFPReg, int isMain){
+    /* variable registers left by locals hold the most used globals no callee modifies,
+     * then the most used array elements no other access may touch,
+     * a cached variable costs a load, a store if it is written, and a save and a restore outside main */
+    FuncSummary region, elements, clobbered;
+    _initFuncSummary(&region, NULL);
+    _initFuncSummary(&elements, NULL);
+    _initFuncSummary(&clobbered, NULL);
+    _scanRegion(regionNode->child, &region, &elements, &clobbered, 1);
+
+    int numOfReg = numOfLocalReg, numOfFPReg = numOfLocalFPReg;
+    _reserveTileRegs(pThis, regionNode, &numOfReg);
+    int* order = _orderByWeight(&region);
+    int i;
+    for(i = 0; i < region.numOfAccess; i++){
+        GlobalAccess* access = &(region.accesses[order[i]]);
+        GlobalAccess* clobber = _findGlobalAccess(&clobbered, access->entry);
+        int cost = 1 + access->isMod + (isMain ? 0 : 2);
+        if((clobber && clobber->isMod) || access->weight <= cost)
+            continue;
+        _addCachedVar(pThis, regionNode, access, &numOfReg, &numOfFPReg);
+    }
+    free(order);
+
+    order = _orderByWeight(&elements);
+    for(i = 0; i < elements.numOfAccess; i++){
+        GlobalAccess* access = &(elements.accesses[order[i]]);
+        int cost = 1 + access->isMod + (isMain ? 0 : 2);
+        if(access->weight <= cost || !_isCacheableElement(regionNode->child, access))
+            continue;
+        _addCachedVar(pThis, regionNode, access, &numOfReg, &numOfFPReg);
+    }
+    free(order);
+
+    /* prologue saves every variable register used by some region */
+    if(numOfReg > pThis->numOfVarReg)
+        pThis->numOfVarReg = numOfReg;
+    if(numOfFPReg > pThis->numOfVarFPReg)
+        pThis->numOfVarFPReg = numOfFPReg;
+
+    free(region.accesses);
+    free(elements.accesses);
+    free(clobbered.accesses);
+}
+
+void _cacheGlobalsInLoops(LocalVarSet* pThis, AST_NODE* node, int numOfLocalReg, int numOfLocalFPReg, int isMain){
+    /* every outermost loop is a region, registers are reused by the next one */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_NODE &&
+          (node->semantic_value.stmtSemanticValue.kind == WHILE_STMT ||
+           node->semantic_value.stmtSemanticValue.kind == FOR_STMT))
+            _cacheGlobalsInRegion(pThis, node, numOfLocalReg, numOfLocalFPReg, isMain);
+        else
+            _cacheGlobalsInLoops(pThis, node->child, numOfLocalReg, numOfLocalFPReg, isMain);
+    }
+}
+
+/*** Local Value Numbering ***/
+void initValueTable(ValueTable* pThis){
+    pThis->numOfValue = 0;
+    pThis->stmtStamp = 0;
+}
+
+RegisterManager* _managerOfValue(Value* value){
+    return value->type == FLOAT_TYPE ? GR.FPRegManager : GR.regManager;
+}
+
+void _removeValue(ValueTable* pThis, int index){
+    unpinReg(_managerOfValue(&(pThis->values[index])), pThis->values[index].regNum);
+    pThis->values[index] = pThis->values[--pThis->numOfValue];
+}
+
+void _killValue(ValueTable* pThis, int index){
+    /* register of value used by current statement may still be an operand, keep it until statement ends */
+    if(pThis->values[index].stmtStamp == pThis->stmtStamp)
+        pThis->values[index].isValid = 0;
+    else
+        _removeValue(pThis, index);
+}
+
+void clearValueTable(ValueTable* pThis){
+    while(pThis->numOfValue > 0)
+        _removeValue(pThis, pThis->numOfValue - 1);
+}
+
+void killAllValues(ValueTable* pThis){
+    int i;
+    for(i = pThis->numOfValue - 1; i >= 0; i--)
+        _killValue(pThis, i);
+}
+
+void beginValueStmt(ValueTable* pThis){
+    int i;
+    pThis->stmtStamp++;
+    for(i = pThis->numOfValue - 1; i >= 0; i--)
+        if(!pThis->values[i].isValid)
+            _removeValue(pThis, i);
+}
+
+int evictValue(ValueTable* pThis, RegisterManager* regManager){
+    /* free the register of a value unused by current statement, return 0 if there is none */
+    int i;
+    for(i = 0; i < pThis->numOfValue; i++){
+        Value* value = &(pThis->values[i]);
+        if(_managerOfValue(value) == regManager && value->stmtStamp != pThis->stmtStamp){
+            _removeValue(pThis, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int _isPureIndexNode(AST_NODE* node){
+    /* index of scalar variables, int constants and arithmetic, its value changes only by assignment */
+    if(node->nodeType == IDENTIFIER_NODE)
+        return node->symbolEntry && node->symbolEntry->type->dimension == 0 && !node->child;
+    if(node->nodeType == CONST_VALUE_NODE)
+        return node->semantic_value.const1->const_type == INTEGERC;
+    if(node->nodeType != EXPR_NODE)
+        return 0;
+    if(node->semantic_value.exprSemanticValue.kind == BINARY_OPERATION){
+        BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+        if(op != BINARY_OP_ADD && op != BINARY_OP_SUB && op != BINARY_OP_MUL)
+            return 0;
+    }
+    else if(node->semantic_value.exprSemanticValue.op.unaryOp != UNARY_OP_NEGATIVE)
+        return 0;
+    return isPureIndex(node->child);
+}
+
+int isPureIndex(AST_NODE* node){
+    for(; node; node = node->rightSibling)
+        if(!_isPureIndexNode(node))
+            return 0;
+    return 1;
+}
+
+int _isSameIndexNode(AST_NODE* index1, AST_NODE* index2){
+    /* structural equality of pure index expressions */
+    if(index1->nodeType != index2->nodeType)
+        return 0;
+    if(index1->nodeType == IDENTIFIER_NODE)
+        return index1->symbolEntry == index2->symbolEntry;
+    if(index1->nodeType == CONST_VALUE_NODE)
+        return index1->semantic_value.const1->const_u.intval == index2->semantic_value.const1->const_u.intval;
+    return index1->semantic_value.exprSemanticValue.kind == index2->semantic_value.exprSemanticValue.kind &&
+      index1->semantic_value.exprSemanticValue.op.binaryOp == index2->semantic_value.exprSemanticValue.op.binaryOp &&
+      _isSameIndex(index1->child, index2->child);
+}
+
+int _isSameIndex(AST_NODE* index1, AST_NODE* index2){
+    for(; index1 && index2; index1 = index1->rightSibling, index2 = index2->rightSibling)
+        if(!_isSameIndexNode(index1, index2))
+            return 0;
+    return index1 == index2;
+}
+
+int _indexUsesVar(AST_NODE* node, SymbolTableEntry* entry, int isAnyGlobal){
+    /* index reads entry, or any global scalar in memory if isAnyGlobal */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == IDENTIFIER_NODE && (node->symbolEntry == entry ||
+          (isAnyGlobal && node->symbolEntry->place.kind == GLOBAL_TYPE)))
+            return 1;
+        if(_indexUsesVar(node->child, entry, isAnyGlobal))
+            return 1;
+    }
+    return 0;
+}
+
+int getValueKey(AST_NODE* idNode, Value* key){
+    /* key of variable or array element loaded from its own memory place, not a spilled register.
+     * return 0 if the value can't be numbered */
+    SymbolTableEntry* entry = idNode->symbolEntry;
+    ExpValPlace* place = &(idNode->valPlace);
+    if(idNode->nodeType != IDENTIFIER_NODE || !entry || entry->kind == FUNC_ENTRY ||
+      place->kind == REG_TYPE || place->kind != entry->place.kind)
+        return 0;
+
+    int numOfIndex = 0;
+    AST_NODE* indexNode;
+    for(indexNode = idNode->child; indexNode; indexNode = indexNode->rightSibling)
+        numOfIndex++;
+    if(numOfIndex != entry->type->dimension)
+        return 0;
+
+    key->kind = entry->type->dimension == 0 ? SCALAR_VALUE : ELEMENT_VALUE;
+    key->entry = entry;
+    key->offset = 0;
+    key->indexNode = idNode->child;
+    key->type = place->dataType;
+    key->exprNode = NULL;
+    key->numOfUse = 0;
+
+    if(place->arrIdxKind == DYNAMIC_INDEX){
+        if(!isPureIndex(idNode->child))
+            return 0;
+        if(place->kind == STACK_TYPE)
+            return place->place.stackOffset == entry->place.place.stackOffset;
+        return 1;
+    }
+
+    if(place->kind == STACK_TYPE)
+        key->offset = entry->place.place.stackOffset - place->place.stackOffset;
+    else if(place->kind == GLOBAL_TYPE)
+        key->offset = place->place.data.offset;
+    else if(place->kind == INDIRECT_ADDRESS)
+        key->offset = place->place.inAddr.offset2;
+    return key->offset >= 0; /* spill slot is above every variable */
+}
+
+int getExprValueKey(AST_NODE* exprNode, Value* key){
+    DATA_TYPE type = _exprType(exprNode);
+    if(exprNode->nodeType != EXPR_NODE || !_isPureIndexNode(exprNode) || (type != INT_TYPE && type != FLOAT_TYPE))
+        return 0;
+    key->kind = EXPR_VALUE;
+    key->entry = NULL;
+    key->offset = 0;
+    key->indexNode = exprNode->child;
+    key->type = type;
+    key->exprNode = exprNode;
+    key->numOfUse = 0;
+    return 1;
+}
+
+int _countSameExprs(AST_NODE* node, AST_NODE* exprNode){
+    /* occurrences in node and its descendants, other than exprNode itself */
+    if(node == exprNode)
+        return 0;
+    if(node->nodeType == EXPR_NODE && _isSameIndexNode(node, exprNode))
+        return 1;
+    int numOfSame = 0;
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        numOfSame += _countSameExprs(child, exprNode);
+    return numOfSame;
+}
+
+int _isStraightStmt(AST_NODE* node){
+    return node->nodeType == STMT_NODE && (node->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT ||
+      node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT);
+}
+
+int countLaterUses(AST_NODE* exprNode){
+    /* occurrences in the statement, and in the following simple statements until one of them
+     * assigns an operand or calls. an overestimate only keeps the register longer */
+    AST_NODE* rootNode = exprNode;
+    while(rootNode->parent->nodeType == EXPR_NODE || rootNode->parent->nodeType == IDENTIFIER_NODE ||
+      rootNode->parent->nodeType == NONEMPTY_RELOP_EXPR_LIST_NODE || _isStraightStmt(rootNode->parent) ||
+      (rootNode->parent->nodeType == STMT_NODE && rootNode->parent->semantic_value.stmtSemanticValue.kind == RETURN_STMT))
+        rootNode = rootNode->parent;
+
+    int numOfUse = _countSameExprs(rootNode, exprNode);
+    AST_NODE* stmtNode = rootNode;
+    if(rootNode->parent->nodeType != STMT_LIST_NODE || !_isStraightStmt(rootNode))
+        return numOfUse;
+
+    while(1){
+        if(hasFuncCall(stmtNode))
+            break;
+        AST_NODE* lvalueNode = stmtNode->child;
+        if(stmtNode->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT && !lvalueNode->child &&
+          _indexUsesVar(exprNode->child, lvalueNode->symbolEntry, 0))
+            break;
+        stmtNode = stmtNode->rightSibling;
+        if(!stmtNode || !_isStraightStmt(stmtNode))
+            break;
+        numOfUse += _countSameExprs(stmtNode, exprNode);
+    }
+    return numOfUse;
+}
+
+int _findValueIndex(ValueTable* pThis, Value* key){
+    int i;
+    for(i = 0; i < pThis->numOfValue; i++){
+        Value* value = &(pThis->values[i]);
+        if(value->isValid && value->kind == key->kind && value->entry == key->entry &&
+          value->offset == key->offset && value->type == key->type &&
+          (value->indexNode == key->indexNode || 
+           (value->indexNode && key->indexNode && _isSameIndex(value->indexNode, key->indexNode))) &&
+          (value->exprNode == key->exprNode ||
+           (value->exprNode && key->exprNode && _isSameIndexNode(value->exprNode, key->exprNode))))
+            return i;
+    }
+    return -1;
+}
+
+int findValue(ValueTable* pThis, Value* key){
+    int index = _findValueIndex(pThis, key);
+    if(index == -1)
+        return -1;
+    Value* value = &(pThis->values[index]);
+    int regNum = value->regNum;
+    value->stmtStamp = pThis->stmtStamp;
+    if(value->kind == EXPR_VALUE && --value->numOfUse == 0)
+        _killValue(pThis, index); /* register is freed when statement ends */
+    return regNum;
+}
+
+void addValue(ValueTable* pThis, Value* key, int regNum){
+    /* keep register holding value of key, as long as enough registers are left for expressions */
+    RegisterManager* regManager = _managerOfValue(key);
+    if(isPinnedReg(regManager, regNum) || pThis->numOfValue == MAX_VALUE_NUM)
+        return;
+
+    int i, numOfPinned = 0;
+    for(i = 0; i < regManager->numOfReg; i++)
+        numOfPinned += regManager->regPinned[i];
+    if(numOfPinned + 1 > regManager->numOfReg - MIN_FREE_REG_NUM)
+        return;
+
+    int index = _findValueIndex(pThis, key);
+    if(index != -1)
+        _killValue(pThis, index);
+
+    Value* value = &(pThis->values[pThis->numOfValue++]);
+    *value = *key;
+    value->regNum = regNum;
+    value->stmtStamp = pThis->stmtStamp;
+    value->isValid = 1;
+    pinReg(regManager, regNum);
+}
+
+void assignValue(ValueTable* pThis, AST_NODE* lvalueNode, int regNum, int isStored){
+    /* lvalue gets the value of register, values depending on old one are killed */
+    SymbolTableEntry* entry = lvalueNode->symbolEntry;
+    Value key;
+    int isKey = getValueKey(lvalueNode, &key);
+    int i;
+    for(i = pThis->numOfValue - 1; i >= 0; i--){
+        Value* value = &(pThis->values[i]);
+        if(!value->isValid)
+            continue;
+        if(entry->type->dimension == 0 ?
+          (value->entry == entry || (value->indexNode && _indexUsesVar(value->indexNode, entry, 0))) :
+          (value->kind == ELEMENT_VALUE &&
+           mayAliasElement(GR.aliasAnalysis, value->entry, value->indexNode, entry, lvalueNode->child)))
+            _killValue(pThis, i);
+    }
+
+    if(isKey && isStored)
+        addValue(pThis, &key, regNum);
+}
+
+void killValuesAtCall(ValueTable* pThis, AST_NODE* funcCallNode){
+    /* callee may write globals and arrays, and doesn't save FP registers */
+    int i;
+    for(i = pThis->numOfValue - 1; i >= 0; i--){
+        Value* value = &(pThis->values[i]);
+        if(!value->isValid)
+            continue;
+        if(value->type == FLOAT_TYPE ||
+          (value->kind == ELEMENT_VALUE && callMayTouchArray(GR.aliasAnalysis, funcCallNode, value->entry, 1)) ||
+          (value->kind == SCALAR_VALUE && value->entry->place.kind == GLOBAL_TYPE) ||
+          (value->indexNode && _indexUsesVar(value->indexNode, NULL, 1)))
+            _killValue(pThis, i);
+    }
+}
+
+/*** Array Alias Analysis ***/
+void _initRootSet(ArrayRootSet* pThis){
+    pThis->numOfRoot = 0;
+    pThis->capacity = 4;
+    pThis->roots = malloc(sizeof(ArrayRoot) * pThis->capacity);
+}
+
+int _isSameName(char* name1, char* name2){
+    /* NULL function name is global scope */
+    return name1 == name2 || (name1 && name2 && strcmp(name1, name2) == 0);
+}
+
+ArrayRoot* _findRoot(ArrayRootSet* pThis, char* funcName, char* name){
+    int i;
+    for(i = 0; i < pThis->numOfRoot; i++)
+        if(_isSameName(pThis->roots[i].funcName, funcName) && strcmp(pThis->roots[i].name, name) == 0)
+            return &(pThis->roots[i]);
+    return NULL;
+}
+
+int _addRoot(ArrayRootSet* pThis, char* funcName, char* name, int isMod, int isRef){
+    /* return 1 if the set grows */
+    ArrayRoot* root = _findRoot(pThis, funcName, name);
+    int isChanged = 0;
+    if(!root){
+        if(pThis->numOfRoot == pThis->capacity){
+            pThis->capacity *= 2;
+            pThis->roots = realloc(pThis->roots, sizeof(ArrayRoot) * pThis->capacity);
+        }
+        root = &(pThis->roots[pThis->numOfRoot++]);
+        root->funcName = funcName;
+        root->name = name;
+        root->isMod = 0;
+        root->isRef = 0;
+        isChanged = 1;
+    }
+    isChanged |= (isMod && !root->isMod) || (isRef && !root->isRef);
+    root->isMod |= isMod;
+    root->isRef |= isRef;
+    return isChanged;
+}
+
+void initAliasAnalysis(AliasAnalysis* pThis){
+    pThis->numOfFunc = 0;
+    pThis->capacity = 8;
+    pThis->funcs = malloc(sizeof(FuncAliases) * pThis->capacity);
+    pThis->current = NULL;
+}
+
+void finAliasAnalysis(AliasAnalysis* pThis){
+    int i, j;
+    for(i = 0; i < pThis->numOfFunc; i++){
+        FuncAliases* func = &(pThis->funcs[i]);
+        for(j = 0; j < func->numOfParam; j++)
+            free(func->paramRoots[j].roots);
+        free(func->paramNames);
+        free(func->paramRoots);
+        free(func->localArrays.roots);
+        free(func->accesses.roots);
+    }
+    free(pThis->funcs);
+}
+
+FuncAliases* _findFuncAliases(AliasAnalysis* pThis, char* name){
+    /* NULL for builtin function, it touches no array */
+    int i;
+    for(i = 0; i < pThis->numOfFunc; i++)
+        if(strcmp(pThis->funcs[i].name, name) == 0)
+            return &(pThis->funcs[i]);
+    return NULL;
+}
+
+int _paramIndex(FuncAliases* func, char* name){
+    int i;
+    for(i = 0; i < func->numOfParam; i++)
+        if(strcmp(func->paramNames[i], name) == 0)
+            return i;
+    return -1;
+}
+
+void _collectLocalArrays(FuncAliases* func, AST_NODE* node){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == DECLARATION_NODE &&
+          node->semantic_value.declSemanticValue.kind == VARIABLE_DECL){
+            AST_NODE* idNode;
+            for(idNode = node->child->rightSibling; idNode; idNode = idNode->rightSibling)
+                if(idNode->semantic_value.identifierSemanticValue.kind == ARRAY_ID)
+                    _addRoot(&(func->localArrays), func->name,
+                      idNode->semantic_value.identifierSemanticValue.identifierName, 0, 0);
+            continue;
+        }
+        _collectLocalArrays(func, node->child);
+    }
+}
+
+void _addFuncAliases(AliasAnalysis* pThis, AST_NODE* declarationNode){
+    AST_NODE* funcNameNode = declarationNode->child->rightSibling;
+    AST_NODE* paraListNode = funcNameNode->rightSibling;
+    if(pThis->numOfFunc == pThis->capacity){
+        pThis->capacity *= 2;
+        pThis->funcs = realloc(pThis->funcs, sizeof(FuncAliases) * pThis->capacity);
+    }
+    FuncAliases* func = &(pThis->funcs[pThis->numOfFunc++]);
+    func->name = funcNameNode->semantic_value.identifierSemanticValue.identifierName;
+    func->blockNode = paraListNode->rightSibling;
+
+    /* a typedef name may declare array parameter, every parameter is kept */
+    func->numOfParam = countRightSibling(paraListNode->child);
+    func->paramNames = malloc(sizeof(char*) * (func->numOfParam + 1));
+    func->paramRoots = malloc(sizeof(ArrayRootSet) * (func->numOfParam + 1));
+    AST_NODE* paraNode;
+    int i = 0;
+    for(paraNode = paraListNode->child; paraNode; paraNode = paraNode->rightSibling, i++){
+        func->paramNames[i] = paraNode->child->rightSibling->semantic_value.identifierSemanticValue.identifierName;
+        _initRootSet(&(func->paramRoots[i]));
+    }
+
+    _initRootSet(&(func->localArrays));
+    _initRootSet(&(func->accesses));
+    _collectLocalArrays(func, func->blockNode->child);
+}
+
+int _addNameRoots(FuncAliases* func, ArrayRootSet* set, char* name, int isMod, int isRef, int isLocalKept){
+    /* arrays the name may refer to in function, local arrays are invisible to callers unless kept */
+    int index = _paramIndex(func, name);
+    int isLocal = _findRoot(&(func->localArrays), func->name, name) != NULL;
+    int isChanged = 0;
+    if(index != -1 && set == &(func->accesses))
+        isChanged |= _addRoot(set, func->name, name, isMod, isRef);
+    else if(index != -1){
+        int i;
+        for(i = 0; i < func->paramRoots[index].numOfRoot; i++){
+            ArrayRoot* root = &(func->paramRoots[index].roots[i]);
+            isChanged |= _addRoot(set, root->funcName, root->name, isMod, isRef);
+        }
+    }
+    if(isLocal && isLocalKept)
+        isChanged |= _addRoot(set, func->name, name, isMod, isRef);
+    if(index == -1 || isLocal)
+        isChanged |= _addRoot(set, NULL, name, isMod, isRef);
+    return isChanged;
+}
+
+int _scanAliases(AliasAnalysis* pThis, FuncAliases* func, AST_NODE* node){
+    /* bind arguments to parameters of callees, collect arrays accessed by function,
+     * return 1 if anything grows */
+    int isChanged = 0;
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == VARIABLE_DECL_LIST_NODE)
+            continue;
+
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT){
+            FuncAliases* callee = _findFuncAliases(pThis, node->child->semantic_value.identifierSemanticValue.identifierName);
+            AST_NODE* argNode = node->child->rightSibling->child;
+            int i;
+            for(i = 0; callee && argNode && i < callee->numOfParam; i++, argNode = argNode->rightSibling){
+                if(argNode->nodeType != IDENTIFIER_NODE)
+                    continue;
+                char* argName = argNode->semantic_value.identifierSemanticValue.identifierName;
+                isChanged |= _addNameRoots(func, &(callee->paramRoots[i]), argName, 0, 0, 1);
+                ArrayRoot* access = _findRoot(&(callee->accesses), callee->name, callee->paramNames[i]);
+                if(access)
+                    isChanged |= _addNameRoots(func, &(func->accesses), argName, access->isMod, access->isRef, 0);
+            }
+            for(i = 0; callee && i < callee->accesses.numOfRoot; i++){
+                ArrayRoot* access = &(callee->accesses.roots[i]);
+                if(!access->funcName)
+                    isChanged |= _addRoot(&(func->accesses), NULL, access->name, access->isMod, access->isRef);
+            }
+        }
+        else if(node->nodeType == IDENTIFIER_NODE && node->child){
+            /* indexed array */
+            int isMod = _isDefinedId(node);
+            isChanged |= _addNameRoots(func, &(func->accesses),
+              node->semantic_value.identifierSemanticValue.identifierName, isMod, !isMod, 0);
+        }
+        isChanged |= _scanAliases(pThis, func, node->child);
+    }
+    return isChanged;
+}
+
+void analyzeArrayAliases(AliasAnalysis* pThis, AST_NODE* programNode){
+    AST_NODE* node;
+    for(node = programNode->child; node; node = node->rightSibling)
+        if(node->nodeType == DECLARATION_NODE &&
+          node->semantic_value.declSemanticValue.kind == FUNCTION_DECL)
+            _addFuncAliases(pThis, node);
+
+    int isChanged = 1;
+    while(isChanged){
+        int i;
+        isChanged = 0;
+        for(i = 0; i < pThis->numOfFunc; i++)
+            isChanged |= _scanAliases(pThis, &(pThis->funcs[i]), pThis->funcs[i].blockNode->child);
+    }
+}
+
+void setAliasFunc(AliasAnalysis* pThis, char* funcName){
+    pThis->current = _findFuncAliases(pThis, funcName);
+}
+
+int isArrayElement(AST_NODE* idNode){
+    SymbolTableEntry* entry = idNode->symbolEntry;
+    if(idNode->nodeType != IDENTIFIER_NODE || !entry || entry->kind == FUNC_ENTRY || entry->kind == TYPE_ENTRY ||
+      entry->type->dimension == 0 || idNode->parent->nodeType == DECLARATION_NODE)
+        return 0;
+    return countRightSibling(idNode->child) == entry->type->dimension;
+}
+
+ArrayRootSet* _paramRootsOf(AliasAnalysis* pThis, SymbolTableEntry* entry){
+    /* NULL if unknown */
+    int index = pThis->current ? _paramIndex(pThis->current, entry->name) : -1;
+    return index == -1 ? NULL : &(pThis->current->paramRoots[index]);
+}
+
+int _mayAliasGlobal(AliasAnalysis* pThis, SymbolTableEntry* entry, char* name){
+    /* entry may refer to global array of name */
+    if(entry->place.kind == GLOBAL_TYPE)
+        return strcmp(entry->name, name) == 0;
+    if(entry->place.kind != INDIRECT_ADDRESS)
+        return 0; /* local array */
+    ArrayRootSet* roots = _paramRootsOf(pThis, entry);
+    return !roots || _findRoot(roots, NULL, name);
+}
+
+int mayAliasArray(AliasAnalysis* pThis, SymbolTableEntry* entry1, SymbolTableEntry* entry2){
+    if(entry1 == entry2)
+        return 1;
+    if(entry1->place.kind != INDIRECT_ADDRESS && entry2->place.kind != INDIRECT_ADDRESS)
+        return 0; /* distinct local or global arrays */
+    if(entry1->place.kind != INDIRECT_ADDRESS)
+        return _mayAliasGlobal(pThis, entry2, entry1->name) && entry1->place.kind == GLOBAL_TYPE;
+    if(entry2->place.kind != INDIRECT_ADDRESS)
+        return _mayAliasGlobal(pThis, entry1, entry2->name) && entry2->place.kind == GLOBAL_TYPE;
+
+    /* parameters share an array passed to both */
+    ArrayRootSet* roots1 = _paramRootsOf(pThis, entry1);
+    ArrayRootSet* roots2 = _paramRootsOf(pThis, entry2);
+    if(!roots1 || !roots2)
+        return 1;
+    int i;
+    for(i = 0; i < roots1->numOfRoot; i++)
+        if(_findRoot(roots2, roots1->roots[i].funcName, roots1->roots[i].name))
+            return 1;
+    return 0;
+}
+
+void _splitIndex(AST_NODE* indexNode, AST_NODE** base, int* constant){
+    /* index = base + constant, base is NULL for constant index */
+    *base = indexNode;
+    *constant = 0;
+    if(indexNode->nodeType == CONST_VALUE_NODE){
+        *base = NULL;
+        *constant = indexNode->semantic_value.const1->const_u.intval;
+    }
+    else if(indexNode->nodeType == EXPR_NODE &&
+      indexNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+      indexNode->child->rightSibling->nodeType == CONST_VALUE_NODE &&
+      indexNode->child->rightSibling->semantic_value.const1->const_type == INTEGERC){
+        BINARY_OPERATOR op = indexNode->semantic_value.exprSemanticValue.op.binaryOp;
+        int value = indexNode->child->rightSibling->semantic_value.const1->const_u.intval;
+        if(op == BINARY_OP_ADD || op == BINARY_OP_SUB){
+            *base = indexNode->child;
+            *constant = op == BINARY_OP_ADD ? value : -value;
+        }
+    }
+}
+
+int mayAliasElement(AliasAnalysis* pThis, SymbolTableEntry* entry1, AST_NODE* index1,
+  SymbolTableEntry* entry2, AST_NODE* index2){
+    if(!mayAliasArray(pThis, entry1, entry2))
+        return 0;
+    if(entry1 != entry2 || !index1 || !index2 || !isPureIndex(index1) || !isPureIndex(index2))
+        return 1;
+
+    /* elements differ if indices of a dimension differ by a constant */
+    for(; index1 && index2; index1 = index1->rightSibling, index2 = index2->rightSibling){
+        AST_NODE *base1, *base2;
+        int constant1, constant2;
+        _splitIndex(index1, &base1, &constant1);
+        _splitIndex(index2, &base2, &constant2);
+        if(constant1 != constant2 &&
+          (base1 == base2 || (base1 && base2 && _isSameIndexNode(base1, base2))))
+            return 0;
+    }
+    return 1;
+}
+
+int callMayTouchArray(AliasAnalysis* pThis, AST_NODE* funcCallNode, SymbolTableEntry* entry, int isModOnly){
+    /* callee may write (or read, unless isModOnly) array of entry */
+    FuncAliases* callee = _findFuncAliases(pThis,
+      funcCallNode->child->semantic_value.identifierSemanticValue.identifierName);
+    int i;
+    for(i = 0; callee && i < callee->accesses.numOfRoot; i++){
+        ArrayRoot* access = &(callee->accesses.roots[i]);
+        if(isModOnly && !access->isMod)
+            continue;
+        if(!access->funcName){
+            if(_mayAliasGlobal(pThis, entry, access->name))
+                return 1;
+            continue;
+        }
+
+        /* parameter of callee, refers to argument */
+        AST_NODE* argNode = funcCallNode->child->rightSibling->child;
+        int index = _paramIndex(callee, access->name);
+        for(; argNode && index > 0; index--)
+            argNode = argNode->rightSibling;
+        if(!argNode || argNode->nodeType != IDENTIFIER_NODE || !argNode->symbolEntry ||
+          mayAliasArray(pThis, entry, argNode->symbolEntry))
+            return 1;
+    }
+    return 0;
+}
+
+int _readsAliasedElement(AST_NODE* node, AST_NODE* elementNode){
+    /* expression reads array element which may be elementNode, or calls a function */
+    if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT)
+        return 1;
+    if(node->nodeType == IDENTIFIER_NODE && isArrayElement(node) &&
+      mayAliasElement(GR.aliasAnalysis, node->symbolEntry, node->child, elementNode->symbolEntry, elementNode->child))
+        return 1;
+
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        if(_readsAliasedElement(child, elementNode))
+            return 1;
+    return 0;
+}
+
+int _isOverwrittenStore(AST_NODE* stmtNode){
+    /* array store overwritten by a following assignment of the same list before the element is read */
+    if(stmtNode->nodeType != STMT_NODE || stmtNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT)
+        return 0;
+    AST_NODE* lvalueNode = stmtNode->child;
+    if(!isArrayElement(lvalueNode) || !isPureIndex(lvalueNode->child) || hasFuncCall(lvalueNode->rightSibling))
+        return 0;
+
+    AST_NODE* nextNode;
+    for(nextNode = stmtNode->rightSibling; nextNode; nextNode = nextNode->rightSibling){
+        if(nextNode->nodeType != STMT_NODE || nextNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT)
+            return 0;
+        AST_NODE* nextLvalueNode = nextNode->child;
+        if(_readsAliasedElement(nextLvalueNode->rightSibling, lvalueNode))
+            return 0;
+
+        AST_NODE* indexNode;
+        for(indexNode = nextLvalueNode->child; indexNode; indexNode = indexNode->rightSibling)
+            if(_readsAliasedElement(indexNode, lvalueNode))
+                return 0;
+
+        if(nextLvalueNode->symbolEntry == lvalueNode->symbolEntry &&
+          _isSameIndex(nextLvalueNode->child, lvalueNode->child))
+            return 1;
+        if(_indexUsesVar(lvalueNode->child, nextLvalueNode->symbolEntry, 0))
+            return 0; /* index of the same expression refers to another element now */
+    }
+    return 0;
+}
+
+void _markDeadArrayStores(AST_NODE* node){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_LIST_NODE){
+            AST_NODE* stmtNode;
+            for(stmtNode = node->child; stmtNode; stmtNode = stmtNode->rightSibling)
+                if(_isOverwrittenStore(stmtNode))
+                    stmtNode->isDeadStore = 1;
+        }
+        _markDeadArrayStores(node->child);
+    }
+}
+
+/*** Loop Unrolling ***/
+int _countNodes(AST_NODE* node){
+    int numOfNode = 0;
+    for(; node; node = node->rightSibling)
+        numOfNode += 1 + _countNodes(node->child);
+    return numOfNode;
+}
+
+int _isUnrollableBody(AST_NODE* node, SymbolTableEntry* indexEntry, SymbolTableEntry* boundEntry){
+    /* no nested loop or declaration, and neither the index nor the bound is assigned */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == VARIABLE_DECL_LIST_NODE)
+            return 0;
+        if(node->nodeType == STMT_NODE){
+            STMT_KIND kind = node->semantic_value.stmtSemanticValue.kind;
+            if(kind == WHILE_STMT || kind == FOR_STMT)
+                return 0;
+            if(kind == ASSIGN_STMT &&
+              (node->child->symbolEntry == indexEntry || node->child->symbolEntry == boundEntry))
+                return 0;
+        }
+        if(!_isUnrollableBody(node->child, indexEntry, boundEntry))
+            return 0;
+    }
+    return 1;
+}
+
+int _isIntConst(AST_NODE* node){
+    return node->nodeType == CONST_VALUE_NODE && node->semantic_value.const1->const_type == INTEGERC;
+}
+
+int _isLocalIntScalar(LocalVarSet* pThis, AST_NODE* node){
+    return node->nodeType == IDENTIFIER_NODE && !node->child && _findLocalVar(pThis, node->symbolEntry) != -1 &&
+      node->symbolEntry->type->primitiveType == INT_TYPE;
+}
+
+int _matchCountedHeader(LocalVarSet* pThis, AST_NODE* forStmtNode, CountedLoop* loop){
+    /* for(i = init; i < bound; i = i + step), return 0 if it doesn't match */
+    AST_NODE* assignNode = forStmtNode->child->child;
+    AST_NODE* condNode   = forStmtNode->child->rightSibling->child;
+    AST_NODE* incNode    = forStmtNode->child->rightSibling->rightSibling->child;
+
+    /* i < bound, or i <= bound */
+    if(!condNode || condNode->rightSibling || condNode->nodeType != EXPR_NODE ||
+      condNode->semantic_value.exprSemanticValue.kind != BINARY_OPERATION)
+        return 0;
+    BINARY_OPERATOR op = condNode->semantic_value.exprSemanticValue.op.binaryOp;
+    AST_NODE* indexNode = condNode->child;
+    AST_NODE* boundNode = indexNode->rightSibling;
+    if((op != BINARY_OP_LT && op != BINARY_OP_LE) || !_isLocalIntScalar(pThis, indexNode) ||
+      (!_isIntConst(boundNode) && !_isLocalIntScalar(pThis, boundNode)) ||
+      boundNode->symbolEntry == indexNode->symbolEntry)
+        return 0;
+    loop->indexNode = indexNode;
+    loop->boundNode = boundNode;
+    loop->isInclusive = op == BINARY_OP_LE;
+
+    /* i = i + step */
+    if(!incNode || incNode->rightSibling || incNode->nodeType != STMT_NODE ||
+      incNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT ||
+      incNode->child->symbolEntry != indexNode->symbolEntry || incNode->child->child)
+        return 0;
+    AST_NODE* stepNode = incNode->child->rightSibling;
+    if(stepNode->nodeType != EXPR_NODE || stepNode->semantic_value.exprSemanticValue.kind != BINARY_OPERATION ||
+      stepNode->semantic_value.exprSemanticValue.op.binaryOp != BINARY_OP_ADD ||
+      stepNode->child->symbolEntry != indexNode->symbolEntry || stepNode->child->child ||
+      !_isIntConst(stepNode->child->rightSibling))
+        return 0;
+    loop->step = stepNode->child->rightSibling->semantic_value.const1->const_u.intval;
+    if(loop->step <= 0 || loop->step > MAX_UNROLL_STEP)
+        return 0;
+
+    /* i = init */
+    loop->initNode = NULL;
+    if(assignNode && !assignNode->rightSibling && assignNode->nodeType == STMT_NODE &&
+      assignNode->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT &&
+      assignNode->child->symbolEntry == indexNode->symbolEntry && !assignNode->child->child)
+        loop->initNode = assignNode->child->rightSibling;
+
+    /* trip count is known if i starts from a constant */
+    loop->tripCount = -1;
+    if(loop->initNode && _isIntConst(loop->initNode) && _isIntConst(boundNode)){
+        long long first = loop->initNode->semantic_value.const1->const_u.intval;
+        long long bound = boundNode->semantic_value.const1->const_u.intval + loop->isInclusive;
+        long long tripCount = bound > first ? (bound - first + loop->step - 1) / loop->step : 0;
+        if(first + tripCount * loop->step > 0x7fffffffLL)
+            return 0;
+        loop->first = first;
+        loop->tripCount = tripCount;
+    }
+    return 1;
+}
+
+int _isSumReduction(AST_NODE* stmtNode){
+    /* int s = s + e - f ..., s is the leftmost operand of a chain of + and - and isn't used by e, f */
+    if(stmtNode->nodeType != STMT_NODE || stmtNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT)
+        return 0;
+    AST_NODE* lvalueNode = stmtNode->child;
+    AST_NODE* rvalueNode = lvalueNode->rightSibling;
+    SymbolTableEntry* entry = lvalueNode->symbolEntry;
+    if(!entry || entry->kind == FUNC_ENTRY || entry->type->dimension != 0 ||
+      entry->type->primitiveType != INT_TYPE || _countMentions(rvalueNode, entry) != 1 || _usesFloat(rvalueNode))
+        return 0;
+
+    AST_NODE* operandNode = rvalueNode;
+    while(operandNode->nodeType == EXPR_NODE &&
+      operandNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+      (operandNode->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_ADD ||
+       operandNode->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_SUB))
+        operandNode = operandNode->child;
+    return operandNode != rvalueNode && operandNode->symbolEntry == entry && !operandNode->child;
+}
+
+AST_NODE* _findReduction(AST_NODE* forStmtNode){
+    /* lvalue of the first top level sum reduction of body whose variable has no other use in loop */
+    AST_NODE* blockNode = forStmtNode->child->rightSibling->rightSibling->rightSibling;
+    AST_NODE* stmtNode = blockNode;
+    if(blockNode->nodeType == BLOCK_NODE)
+        stmtNode = blockNode->child && blockNode->child->nodeType == STMT_LIST_NODE ? blockNode->child->child : NULL;
+    for(; stmtNode; stmtNode = stmtNode->rightSibling){
+        if(!_isSumReduction(stmtNode))
+            continue;
+        SymbolTableEntry* entry = stmtNode->child->symbolEntry;
+        if(_countMentions(forStmtNode->child, entry) == 2 && !isDeadAssignment(stmtNode) &&
+          (entry->place.kind != GLOBAL_TYPE || !hasFuncCall(blockNode)))
+            return stmtNode->child;
+    }
+    return NULL;
+}
+
+int analyzeCountedLoop(LocalVarSet* pThis, AST_NODE* forStmtNode, CountedLoop* loop){
+    AST_NODE* incNode    = forStmtNode->child->rightSibling->rightSibling->child;
+    AST_NODE* blockNode  = forStmtNode->child->rightSibling->rightSibling->rightSibling;
+    loop->factor = 1;
+    if(!_matchCountedHeader(pThis, forStmtNode, loop) || loop->tripCount == 0 ||
+      !_isUnrollableBody(blockNode, loop->indexNode->symbolEntry, loop->boundNode->symbolEntry))
+        return 1;
+
+    /* copies of body and increment within code size budget */
+    int size = _countNodes(blockNode) + _countNodes(incNode);
+    if(loop->tripCount != -1 && loop->tripCount <= MAX_FULL_UNROLL && loop->tripCount * size <= UNROLL_BUDGET)
+        loop->factor = loop->tripCount;
+    else{
+        loop->factor = MAX_UNROLL_FACTOR;
+        while(loop->factor > 1 && loop->factor * size > UNROLL_BUDGET)
+            loop->factor /= 2;
+        if(loop->tripCount != -1 && loop->factor > loop->tripCount)
+            loop->factor = loop->tripCount;
+    }
+    loop->reductionNode = loop->factor > 1 ? _findReduction(forStmtNode) : NULL;
+    return loop->factor;
+}
+
+/*** Loop Nest Optimization ***/
+AST_NODE* _innerLoopOf(AST_NODE* forStmtNode){
+    /* loop which is the only statement of body, NULL if nest isn't perfect */
+    AST_NODE* bodyNode = forStmtNode->child->rightSibling->rightSibling->rightSibling;
+    if(bodyNode->nodeType == BLOCK_NODE){
+        if(!bodyNode->child || bodyNode->child->nodeType != STMT_LIST_NODE || bodyNode->child->rightSibling)
+            return NULL;
+        bodyNode = bodyNode->child->child;
+        if(!bodyNode || bodyNode->rightSibling)
+            return NULL;
+    }
+    if(bodyNode->nodeType == STMT_NODE && bodyNode->semantic_value.stmtSemanticValue.kind == FOR_STMT)
+        return bodyNode;
+    return NULL;
+}
+
+int _countMentions(AST_NODE* node, SymbolTableEntry* entry){
+    int numOfMention = 0;
+    for(; node; node = node->rightSibling)
+        numOfMention += (node->nodeType == IDENTIFIER_NODE && node->symbolEntry == entry) +
+          _countMentions(node->child, entry);
+    return numOfMention;
+}
+
+int _containsNode(AST_NODE* node, AST_NODE* target){
+    /* target is node or its descendant */
+    AST_NODE* child;
+    if(node == target)
+        return 1;
+    for(child = node->child; child; child = child->rightSibling)
+        if(_containsNode(child, target))
+            return 1;
+    return 0;
+}
+
+int _usesFloat(AST_NODE* node){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == CONST_VALUE_NODE && node->semantic_value.const1->const_type == FLOATC)
+            return 1;
+        if(node->nodeType == IDENTIFIER_NODE && node->symbolEntry && node->symbolEntry->kind != FUNC_ENTRY &&
+          node->symbolEntry->type->primitiveType == FLOAT_TYPE)
+            return 1;
+        if(_usesFloat(node->child))
+            return 1;
+    }
+    return 0;
+}
+
+int _isWrittenInNest(LoopNest* nest, SymbolTableEntry* entry){
+    int i;
+    for(i = 0; i < nest->numOfWritten; i++)
+        if(nest->written[i] == entry)
+            return 1;
+    return 0;
+}
+
+int _scanNestExpr(LoopNest* nest, AST_NODE* node){
+    /* collect array elements read, return 0 for call or array not fully indexed */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT)
+            return 0;
+        if(node->nodeType == IDENTIFIER_NODE && isArrayElement(node)){
+            if(nest->numOfAccess == MAX_NEST_ACCESS)
+                return 0;
+            nest->accesses[nest->numOfAccess++] = node;
+        }
+        else if(node->nodeType == IDENTIFIER_NODE && (!node->symbolEntry || node->symbolEntry->type->dimension > 0))
+            return 0;
+        if(!_scanNestExpr(nest, node->child))
+            return 0;
+    }
+    return 1;
+}
+
+int _scanNestBody(LocalVarSet* pThis, LoopNest* nest, AST_NODE* node){
+    /* inner body has only assignments, return 0 otherwise */
+    if(node->nodeType == BLOCK_NODE){
+        AST_NODE* child;
+        for(child = node->child; child; child = child->rightSibling){
+            if(child->nodeType != STMT_LIST_NODE)
+                return 0; /* declaration */
+            AST_NODE* stmtNode;
+            for(stmtNode = child->child; stmtNode; stmtNode = stmtNode->rightSibling)
+                if(!_scanNestBody(pThis, nest, stmtNode))
+                    return 0;
+        }
+        return 1;
+    }
+    if(node->nodeType != STMT_NODE || node->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT ||
+      nest->numOfStmt == MAX_NEST_ACCESS)
+        return 0;
+    nest->stmts[nest->numOfStmt++] = node;
+
+    AST_NODE* lvalueNode = node->child;
+    if(lvalueNode->symbolEntry && lvalueNode->symbolEntry->type->dimension == 0){
+        /* local scalar other than the indices */
+        SymbolTableEntry* entry = lvalueNode->symbolEntry;
+        if(_findLocalVar(pThis, entry) == -1 || entry == nest->outer.indexNode->symbolEntry ||
+          entry == nest->inner.indexNode->symbolEntry)
+            return 0;
+        if(!_isWrittenInNest(nest, entry)){
+            if(nest->numOfWritten == MAX_NEST_ACCESS)
+                return 0;
+            nest->written[nest->numOfWritten++] = entry;
+        }
+        return _scanNestExpr(nest, lvalueNode->rightSibling);
+    }
+    return _scanNestExpr(nest, lvalueNode);
+}
+
+int _isReadOutsideNest(AST_NODE* node, AST_NODE* nestNode, SymbolTableEntry* entry){
+    /* entry may be read outside nest, unless the init of a for loop assigns it again first */
+    for(; node; node = node->rightSibling){
+        if(node == nestNode)
+            continue;
+        if(node->nodeType == IDENTIFIER_NODE && node->symbolEntry == entry && !_isDefinedId(node))
+            return 1;
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FOR_STMT &&
+          !_containsNode(node, nestNode)){
+            AST_NODE* assignNode = node->child->child;
+            if(assignNode && assignNode->nodeType == STMT_NODE &&
+              assignNode->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT &&
+              assignNode->child->symbolEntry == entry && !assignNode->child->child &&
+              !_countMentions(assignNode->child->rightSibling, entry))
+                continue;
+        }
+        if(_isReadOutsideNest(node->child, nestNode, entry))
+            return 1;
+    }
+    return 0;
+}
+
+int _writtenScalarKind(LoopNest* nest, SymbolTableEntry* entry){
+    /* 1 for a temporary assigned by the first statement using it in each iteration,
+     * 2 for an int reduction s = s + e - f ... which is the only use of s in the nest,
+     * its sum doesn't depend on the order of iterations, 0 otherwise */
+    AST_NODE* innerBodyNode = nest->innerNode->child->rightSibling->rightSibling->rightSibling;
+    int i;
+    for(i = 0; i < nest->numOfStmt; i++){
+        AST_NODE* stmtNode = nest->stmts[i];
+        if(!_countMentions(stmtNode->child, entry))
+            continue;
+        AST_NODE* lvalueNode = stmtNode->child;
+        AST_NODE* rvalueNode = lvalueNode->rightSibling;
+        if(lvalueNode->symbolEntry != entry)
+            return 0;
+        if(!_countMentions(rvalueNode, entry))
+            return 1;
+
+        return _countMentions(innerBodyNode, entry) == 2 && _isSumReduction(stmtNode) ? 2 : 0;
+    }
+    return 0;
+}
+
+int _isNestInvariant(LoopNest* nest, AST_NODE* node){
+    /* pure index expression whose variables the nest doesn't change */
+    if(node->nodeType == IDENTIFIER_NODE)
+        return node->symbolEntry && node->symbolEntry->type->dimension == 0 && !node->child &&
+          node->symbolEntry != nest->outer.indexNode->symbolEntry &&
+          node->symbolEntry != nest->inner.indexNode->symbolEntry && !_isWrittenInNest(nest, node->symbolEntry);
+    if(node->nodeType == CONST_VALUE_NODE)
+        return node->semantic_value.const1->const_type == INTEGERC;
+    if(node->nodeType != EXPR_NODE)
+        return 0;
+    if(node->semantic_value.exprSemanticValue.kind == BINARY_OPERATION){
+        BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+        if(op != BINARY_OP_ADD && op != BINARY_OP_SUB && op != BINARY_OP_MUL)
+            return 0;
+        return _isNestInvariant(nest, node->child) && _isNestInvariant(nest, node->child->rightSibling);
+    }
+    return node->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_NEGATIVE &&
+      _isNestInvariant(nest, node->child);
+}
+
+int _subscriptKind(LoopNest* nest, AST_NODE* indexNode, int* constant){
+    AST_NODE* base;
+    _splitIndex(indexNode, &base, constant);
+    if(!base)
+        return SUBSCRIPT_NONE;
+    if(base->nodeType == IDENTIFIER_NODE && !base->child && base->symbolEntry == nest->outer.indexNode->symbolEntry)
+        return SUBSCRIPT_OUTER;
+    if(base->nodeType == IDENTIFIER_NODE && !base->child && base->symbolEntry == nest->inner.indexNode->symbolEntry)
+        return SUBSCRIPT_INNER;
+    return _isNestInvariant(nest, indexNode) ? SUBSCRIPT_INVARIANT : SUBSCRIPT_UNKNOWN;
+}
+
+int _isPermutable(LoopNest* nest, AST_NODE* writeNode, AST_NODE* accessNode){
+    /* no dependence between the accesses has distance (+, -) or (-, +) */
+    if(writeNode->symbolEntry != accessNode->symbolEntry)
+        return !mayAliasArray(GR.aliasAnalysis, writeNode->symbolEntry, accessNode->symbolEntry);
+
+    int isFixed[2] = {0, 0}, distance[2] = {0, 0};
+    AST_NODE *index1, *index2;
+    for(index1 = writeNode->child, index2 = accessNode->child; index1 && index2;
+      index1 = index1->rightSibling, index2 = index2->rightSibling){
+        int constant1, constant2;
+        int kind1 = _subscriptKind(nest, index1, &constant1);
+        int kind2 = _subscriptKind(nest, index2, &constant2);
+        if(kind1 == SUBSCRIPT_NONE && kind2 == SUBSCRIPT_NONE && constant1 != constant2)
+            return 1; /* elements never meet */
+        if(kind1 != kind2 || (kind1 != SUBSCRIPT_OUTER && kind1 != SUBSCRIPT_INNER))
+            continue; /* no constraint on distance */
+        int loop = kind1 == SUBSCRIPT_INNER;
+        if(isFixed[loop] && distance[loop] != constant1 - constant2)
+            return 1;
+        isFixed[loop] = 1;
+        distance[loop] = constant1 - constant2;
+    }
+
+    int canOuterPos = !isFixed[0] || distance[0] > 0, canOuterNeg = !isFixed[0] || distance[0] < 0;
+    int canInnerPos = !isFixed[1] || distance[1] > 0, canInnerNeg = !isFixed[1] || distance[1] < 0;
+    return !(canOuterPos && canInnerNeg) && !(canOuterNeg && canInnerPos);
+}
+
+int _isHeaderOperand(LoopNest* nest, AST_NODE* node){
+    /* init or bound the nest doesn't change */
+    if(_isIntConst(node))
+        return 1;
+    return node->nodeType == IDENTIFIER_NODE && !node->child && node->symbolEntry &&
+      node->symbolEntry->type->dimension == 0 && node->symbolEntry != nest->outer.indexNode->symbolEntry &&
+      node->symbolEntry != nest->inner.indexNode->symbolEntry && !_isWrittenInNest(nest, node->symbolEntry);
+}
+
+int _analyzeLoopNest(LocalVarSet* pThis, LoopNest* nest, AST_NODE* funcBodyNode){
+    /* return 1 if the loops of nest can be interchanged or tiled */
+    nest->numOfStmt = nest->numOfAccess = nest->numOfWritten = 0;
+    if(!_matchCountedHeader(pThis, nest->outerNode, &(nest->outer)) || !nest->outer.initNode ||
+      !_matchCountedHeader(pThis, nest->innerNode, &(nest->inner)) || !nest->inner.initNode ||
+      nest->outer.indexNode->symbolEntry == nest->inner.indexNode->symbolEntry ||
+      !_scanNestBody(pThis, nest, nest->innerNode->child->rightSibling->rightSibling->rightSibling))
+        return 0;
+    if(!_isHeaderOperand(nest, nest->outer.initNode) || !_isHeaderOperand(nest, nest->outer.boundNode) ||
+      !_isHeaderOperand(nest, nest->inner.initNode) || !_isHeaderOperand(nest, nest->inner.boundNode))
+        return 0;
+
+    /* scalars written in an iteration don't carry values to the next one, but a sum */
+    int i, j;
+    for(i = 0; i < nest->numOfWritten; i++){
+        int kind = _writtenScalarKind(nest, nest->written[i]);
+        if(kind == 0 || (kind == 1 && _isReadOutsideNest(funcBodyNode, nest->outerNode, nest->written[i])))
+            return 0;
+    }
+
+    /* indices end with different values if some loop doesn't run */
+    if((nest->outer.tripCount <= 0 || nest->inner.tripCount <= 0) &&
+      (_isReadOutsideNest(funcBodyNode, nest->outerNode, nest->outer.indexNode->symbolEntry) ||
+       _isReadOutsideNest(funcBodyNode, nest->outerNode, nest->inner.indexNode->symbolEntry)))
+        return 0;
+
+    for(i = 0; i < nest->numOfAccess; i++){
+        AST_NODE* indexNode;
+        int constant;
+        for(indexNode = nest->accesses[i]->child; indexNode; indexNode = indexNode->rightSibling)
+            if(_subscriptKind(nest, indexNode, &constant) == SUBSCRIPT_UNKNOWN)
+                return 0;
+    }
+    for(i = 0; i < nest->numOfAccess; i++){
+        if(!_isDefinedId(nest->accesses[i]))
+            continue;
+        for(j = 0; j < nest->numOfAccess; j++)
+            if(!_isPermutable(nest, nest->accesses[i], nest->accesses[j]))
+                return 0;
+    }
+    return 1;
+}
+
+void _countStrides(LoopNest* nest, int* numOfColumnWise, int* numOfRowWise){
+    /* accesses whose last subscript follows the outer index, or the inner index */
+    int i, constant;
+    *numOfColumnWise = *numOfRowWise = 0;
+    for(i = 0; i < nest->numOfAccess; i++){
+        AST_NODE* lastIndexNode = nest->accesses[i]->child;
+        while(lastIndexNode->rightSibling)
+            lastIndexNode = lastIndexNode->rightSibling;
+        int kind = _subscriptKind(nest, lastIndexNode, &constant);
+        *numOfColumnWise += kind == SUBSCRIPT_OUTER;
+        *numOfRowWise += kind == SUBSCRIPT_INNER;
+    }
+}
+
+void _swapLoopHeaders(LoopNest* nest){
+    /* init, condition and increment lists move to the other loop */
+    AST_NODE* outerListNode = nest->outerNode->child;
+    AST_NODE* innerListNode = nest->innerNode->child;
+    int i;
+    for(i = 0; i < 3; i++, outerListNode = outerListNode->rightSibling, innerListNode = innerListNode->rightSibling){
+        AST_NODE* child = outerListNode->child;
+        outerListNode->child = innerListNode->child;
+        innerListNode->child = child;
+        for(child = outerListNode->child; child; child = child->rightSibling)
+            child->parent = outerListNode;
+        for(child = innerListNode->child; child; child = child->rightSibling)
+            child->parent = innerListNode;
+    }
+    CountedLoop loop = nest->outer;
+    nest->outer = nest->inner;
+    nest->inner = loop;
+}
+
+void _optimizeLoopNest(LocalVarSet* pThis, AST_NODE* outerNode, AST_NODE* funcBodyNode){
+    LoopNest nest;
+    nest.outerNode = outerNode;
+    nest.innerNode = _innerLoopOf(outerNode);
+    if(!nest.innerNode || !_analyzeLoopNest(pThis, &nest, funcBodyNode))
+        return;
+
+    int numOfColumnWise, numOfRowWise;
+    _countStrides(&nest, &numOfColumnWise, &numOfRowWise);
+    if(numOfColumnWise > numOfRowWise){
+        _swapLoopHeaders(&nest);
+        _countStrides(&nest, &numOfColumnWise, &numOfRowWise);
+    }
+
+    /* a walk down columns, as in a transpose, reuses the rows of a tile */
+    if(numOfColumnWise == 0 || pThis->numOfTiled == MAX_TILED_LOOP ||
+      nest.outer.tripCount <= 0 || nest.inner.tripCount <= TILE_SIZE || nest.inner.step != 1 ||
+      (long long)nest.outer.tripCount * nest.inner.tripCount < MIN_TILED_ITERATIONS)
+        return;
+    TiledLoop* tile = &(pThis->tiled[pThis->numOfTiled++]);
+    tile->outerNode = nest.outerNode;
+    tile->innerNode = nest.innerNode;
+    tile->first = nest.inner.first;
+    tile->last = nest.inner.first + nest.inner.tripCount;
+    tile->tileRegNum = -1;
+    tile->limitRegNum = -1;
+    tile->isActive = 0;
+}
+
+void _optimizeLoopNests(LocalVarSet* pThis, AST_NODE* node, AST_NODE* funcBodyNode){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FOR_STMT)
+            _optimizeLoopNest(pThis, node, funcBodyNode);
+        _optimizeLoopNests(pThis, node->child, funcBodyNode);
+    }
+}
+
+TiledLoop* findTiledLoop(LocalVarSet* pThis, AST_NODE* forStmtNode){
+    int i;
+    for(i = 0; i < pThis->numOfTiled; i++){
+        TiledLoop* tile = &(pThis->tiled[i]);
+        if((tile->outerNode == forStmtNode || tile->innerNode == forStmtNode) && tile->tileRegNum != -1)
+            return tile;
+    }
+    return NULL;
+}
+
+/*** Loop Fusion ***/
+/* adjacent counted loops with the same header run as one loop, the body of the second after
+ * the first in each iteration. their bodies have only assignments, and no element is accessed
+ * by the second loop in an earlier iteration than the first loop writes or reads it */
+int _isPrivateScalar(LoopNest* nest, int firstStmt, int lastStmt, SymbolTableEntry* entry){
+    /* the first statement using entry assigns it without reading it */
+    int i;
+    for(i = firstStmt; i < lastStmt; i++){
+        AST_NODE* stmtNode = nest->stmts[i];
+        if(!_countMentions(stmtNode->child, entry))
+            continue;
+        return stmtNode->child->symbolEntry == entry && !stmtNode->child->child &&
+          !_countMentions(stmtNode->child->rightSibling, entry);
+    }
+    return 1;
+}
+
+int _isFusable(LoopNest* nest, AST_NODE* node1, AST_NODE* node2){
+    /* element accessed by node1 of the first loop at i1 and by node2 of the second loop at i2 has i1 <= i2 */
+    if(!_isDefinedId(node1) && !_isDefinedId(node2))
+        return 1;
+    if(node1->symbolEntry != node2->symbolEntry)
+        return !mayAliasArray(GR.aliasAnalysis, node1->symbolEntry, node2->symbolEntry);
+
+    int isFixed = 0, distance = 0;
+    AST_NODE *index1, *index2;
+    for(index1 = node1->child, index2 = node2->child; index1 && index2;
+      index1 = index1->rightSibling, index2 = index2->rightSibling){
+        int constant1, constant2;
+        int kind1 = _subscriptKind(nest, index1, &constant1);
+        int kind2 = _subscriptKind(nest, index2, &constant2);
+        if(kind1 == SUBSCRIPT_NONE && kind2 == SUBSCRIPT_NONE && constant1 != constant2)
+            return 1; /* elements never meet */
+        if(kind1 != SUBSCRIPT_OUTER && kind2 != SUBSCRIPT_OUTER)
+            continue;
+        if(kind1 != kind2)
+            return 0;
+        if(isFixed && distance != constant1 - constant2)
+            return 1;
+        isFixed = 1;
+        distance = constant1 - constant2;
+    }
+    return isFixed && distance >= 0;
+}
+
+int _canFuseLoops(LocalVarSet* pThis, AST_NODE* forStmtNode1, AST_NODE* forStmtNode2){
+    LoopNest nest;
+    CountedLoop loop;
+    nest.outerNode = nest.innerNode = forStmtNode1;
+    nest.numOfStmt = nest.numOfAccess = nest.numOfWritten = 0;
+    if(!_matchCountedHeader(pThis, forStmtNode1, &(nest.outer)) || !nest.outer.initNode ||
+      !_matchCountedHeader(pThis, forStmtNode2, &loop) || !loop.initNode)
+        return 0;
+    nest.inner = nest.outer;
+    if(loop.indexNode->symbolEntry != nest.outer.indexNode->symbolEntry || loop.step != nest.outer.step ||
+      loop.isInclusive != nest.outer.isInclusive || !_isSameIndexNode(loop.initNode, nest.outer.initNode) ||
+      !_isSameIndexNode(loop.boundNode, nest.outer.boundNode))
+        return 0;
+
+    AST_NODE* bodyNode1 = forStmtNode1->child->rightSibling->rightSibling->rightSibling;
+    AST_NODE* bodyNode2 = forStmtNode2->child->rightSibling->rightSibling->rightSibling;
+    if(!_scanNestBody(pThis, &nest, bodyNode1))
+        return 0;
+    int numOfStmt1 = nest.numOfStmt, numOfAccess1 = nest.numOfAccess;
+    if(!_scanNestBody(pThis, &nest, bodyNode2) ||
+      !_isHeaderOperand(&nest, nest.outer.initNode) || !_isHeaderOperand(&nest, nest.outer.boundNode))
+        return 0;
+
+    /* a scalar used by both loops is assigned before use in each iteration of both */
+    int i, j;
+    for(i = 0; i < nest.numOfWritten; i++){
+        SymbolTableEntry* entry = nest.written[i];
+        if(_countMentions(bodyNode1, entry) && _countMentions(bodyNode2, entry) &&
+          (!_isPrivateScalar(&nest, 0, numOfStmt1, entry) || !_isPrivateScalar(&nest, numOfStmt1, nest.numOfStmt, entry)))
+            return 0;
+    }
+
+    for(i = 0; i < nest.numOfAccess; i++){
+        AST_NODE* indexNode;
+        int constant;
+        for(indexNode = nest.accesses[i]->child; indexNode; indexNode = indexNode->rightSibling)
+            if(_subscriptKind(&nest, indexNode, &constant) == SUBSCRIPT_UNKNOWN)
+                return 0;
+    }
+    for(i = 0; i < numOfAccess1; i++)
+        for(j = numOfAccess1; j < nest.numOfAccess; j++)
+            if(!_isFusable(&nest, nest.accesses[i], nest.accesses[j]))
+                return 0;
+    return 1;
+}
+
+int _countInnerScopes(AST_NODE* node){
+    /* blocks under node which aren't inside another one */
+    AST_NODE* child;
+    int numOfScope = 0;
+    for(child = node->child; child; child = child->rightSibling)
+        numOfScope += _countScopes(child);
+    return numOfScope;
+}
+
+int _countScopes(AST_NODE* node){
+    return node->nodeType == BLOCK_NODE ? 1 : _countInnerScopes(node);
+}
+
+SymbolTableNode* _moveScopes(SymbolTableNode* scope, SymbolTableNode* firstScope, int numOfScope){
+    /* append numOfScope siblings from firstScope to children of scope, return the sibling after them */
+    SymbolTableNode** link = &(scope->child);
+    while(*link)
+        link = &((*link)->rightSibling);
+    for(; numOfScope > 0; numOfScope--){
+        *link = firstScope;
+        firstScope->parent = scope;
+        link = &(firstScope->rightSibling);
+        firstScope = firstScope->rightSibling;
+    }
+    *link = NULL;
+    return firstScope;
+}
+
+void _appendStmt(AST_NODE* listNode, AST_NODE* stmtNode){
+    AST_NODE** link = &(listNode->child);
+    while(*link)
+        link = &((*link)->rightSibling);
+    *link = stmtNode;
+    stmtNode->parent = listNode;
+    stmtNode->leftmostSibling = listNode->child;
+    stmtNode->rightSibling = NULL;
+}
+
+void _fuseLoops(STT* symbolTable, AST_NODE* forStmtNode1, AST_NODE* forStmtNode2){
+    /* body of the second loop moves to the end of the block of the first, and the scopes of
+     * both move into the scope of that block. the scopes are entered in code generation order */
+    AST_NODE* incListNode = forStmtNode1->child->rightSibling->rightSibling;
+    AST_NODE* bodyNode1 = incListNode->rightSibling;
+    AST_NODE* bodyNode2 = forStmtNode2->child->rightSibling->rightSibling->rightSibling;
+    SymbolTableNode* parentScope = symbolTable->currentInnerScope;
+    SymbolTableNode* prevScope = symbolTable->lastChildScope;
+    SymbolTableNode* nextScope = prevScope ? prevScope->rightSibling : parentScope->child;
+    SymbolTableNode* scope;
+
+    AST_NODE* blockNode = bodyNode1;
+    if(bodyNode1->nodeType == BLOCK_NODE){
+        scope = nextScope;
+        nextScope = scope->rightSibling;
+    }
+    else{
+        blockNode = Allocate(BLOCK_NODE);
+        blockNode->parent = forStmtNode1;
+        blockNode->leftmostSibling = forStmtNode1->child;
+        incListNode->rightSibling = blockNode;
+        scope = createSymbolTableNode(0, NULL);
+        scope->parent = parentScope;
+        nextScope = _moveScopes(scope, nextScope, _countScopes(bodyNode1));
+    }
+    AST_NODE* listNode = blockNode->child;
+    if(!listNode){
+        listNode = Allocate(STMT_LIST_NODE);
+        listNode->parent = blockNode;
+        blockNode->child = listNode;
+    }
+    if(bodyNode1 != blockNode)
+        _appendStmt(listNode, bodyNode1);
+
+    if(bodyNode2->nodeType == BLOCK_NODE){
+        AST_NODE* stmtNode = bodyNode2->child ? bodyNode2->child->child : NULL;
+        while(stmtNode){
+            AST_NODE* nextNode = stmtNode->rightSibling;
+            _appendStmt(listNode, stmtNode);
+            stmtNode = nextNode;
+        }
+        _moveScopes(scope, nextScope->child, _countInnerScopes(bodyNode2));
+        nextScope = nextScope->rightSibling;
+    }
+    else{
+        _appendStmt(listNode, bodyNode2);
+        nextScope = _moveScopes(scope, nextScope, _countScopes(bodyNode2));
+    }
+
+    scope->rightSibling = nextScope;
+    if(prevScope)
+        prevScope->rightSibling = scope;
+    else
+        parentScope->child = scope;
+    forStmtNode1->rightSibling = forStmtNode2->rightSibling;
+}
+
+void _fuseAdjacentLoops(LocalVarSet* pThis, STT* symbolTable, AST_NODE* node){
+    /* scopes are entered as in code generation */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == BLOCK_NODE){
+            openScope(symbolTable, USE, NULL);
+            _fuseAdjacentLoops(pThis, symbolTable, node->child);
+            closeScope(symbolTable);
+            continue;
+        }
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FOR_STMT)
+            while(node->rightSibling && node->rightSibling->nodeType == STMT_NODE &&
+              node->rightSibling->semantic_value.stmtSemanticValue.kind == FOR_STMT &&
+              _canFuseLoops(pThis, node, node->rightSibling))
+                _fuseLoops(symbolTable, node, node->rightSibling);
+        _fuseAdjacentLoops(pThis, symbolTable, node->child);
+    }
+}
+
+/*** Loop Unswitching ***/
+int _isAssignedIn(AST_NODE* node, SymbolTableEntry* entry){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == IDENTIFIER_NODE && node->symbolEntry == entry && _isDefinedId(node))
+            return 1;
+        if(_isAssignedIn(node->child, entry))
+            return 1;
+    }
+    return 0;
+}
+
+int _isUnswitchCondition(LocalVarSet* pThis, AST_NODE* loopNode, AST_NODE* node){
+    /* comparison or logic of constants and scalars the loop doesn't change */
+    if(node->nodeType == CONST_VALUE_NODE)
+        return node->semantic_value.const1->const_type != STRINGC;
+    if(node->nodeType == IDENTIFIER_NODE){
+        SymbolTableEntry* entry = node->symbolEntry;
+        if(!entry || entry->kind != VAR_ENTRY || entry->type->dimension != 0 || node->child ||
+          _isAssignedIn(loopNode->child, entry))
+            return 0;
+        return _findLocalVar(pThis, entry) != -1 || !hasFuncCall(loopNode);
+    }
+    if(node->nodeType != EXPR_NODE)
+        return 0;
+    if(node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return node->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_LOGICAL_NEGATION &&
+          _isUnswitchCondition(pThis, loopNode, node->child);
+    BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+    if(op == BINARY_OP_ADD || op == BINARY_OP_SUB || op == BINARY_OP_MUL || op == BINARY_OP_DIV)
+        return 0;
+    return _isUnswitchCondition(pThis, loopNode, node->child) &&
+      _isUnswitchCondition(pThis, loopNode, node->child->rightSibling);
+}
+
+int _isUnswitchedIf(LocalVarSet* pThis, AST_NODE* ifStmtNode){
+    int i;
+    for(i = 0; i < pThis->numOfUnswitched; i++)
+        if(pThis->unswitched[i].ifNode == ifStmtNode)
+            return 1;
+    return 0;
+}
+
+AST_NODE* _findUnswitchCondition(LocalVarSet* pThis, AST_NODE* loopNode, AST_NODE* node){
+    /* first if statement in loop whose condition is invariant */
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == IF_STMT &&
+          !_isUnswitchedIf(pThis, node) && _isUnswitchCondition(pThis, loopNode, node->child))
+            return node;
+        AST_NODE* ifStmtNode = _findUnswitchCondition(pThis, loopNode, node->child);
+        if(ifStmtNode)
+            return ifStmtNode;
+    }
+    return NULL;
+}
+
+void _unswitchLoops(LocalVarSet* pThis, AST_NODE* node){
+    int i;
+    for(; node; node = node->rightSibling){
+        int isLoop = node->nodeType == STMT_NODE && (node->semantic_value.stmtSemanticValue.kind == WHILE_STMT ||
+          node->semantic_value.stmtSemanticValue.kind == FOR_STMT);
+        for(i = 0; isLoop && i < pThis->numOfTiled; i++)
+            if(pThis->tiled[i].outerNode == node || pThis->tiled[i].innerNode == node)
+                isLoop = 0;
+        if(isLoop && pThis->numOfUnswitched < MAX_UNSWITCHED_LOOP && _countNodes(node->child) <= MAX_UNSWITCHED_SIZE){
+            AST_NODE* ifStmtNode = _findUnswitchCondition(pThis, node, node->child);
+            if(ifStmtNode){
+                UnswitchedLoop* unswitched = &(pThis->unswitched[pThis->numOfUnswitched++]);
+                unswitched->loopNode = node;
+                unswitched->ifNode = ifStmtNode;
+                unswitched->outcome = -1;
+            }
+        }
+        _unswitchLoops(pThis, node->child);
+    }
+}
+
+UnswitchedLoop* findUnswitchedLoop(LocalVarSet* pThis, AST_NODE* loopNode){
+    int i;
+    for(i = 0; i < pThis->numOfUnswitched; i++)
+        if(pThis->unswitched[i].loopNode == loopNode)
+            return &(pThis->unswitched[i]);
+    return NULL;
+}
+
+int findUnswitchedOutcome(LocalVarSet* pThis, AST_NODE* ifStmtNode){
+    int i;
+    for(i = 0; i < pThis->numOfUnswitched; i++)
+        if(pThis->unswitched[i].ifNode == ifStmtNode)
+            return pThis->unswitched[i].outcome;
+    return -1;
+}
+
+/*** Idiom Recognition ***/
+int _isConsecutiveElement(LoopNest* nest, AST_NODE* idNode, int rowLength){
+    /* last index is i + c, or [i + c][j] for whole rows of length rowLength, other indices don't change */
+    if(!isArrayElement(idNode))
+        return 0;
+    int dimension = idNode->symbolEntry->type->dimension;
+    int d, constant;
+    AST_NODE* indexNode = idNode->child;
+    if(rowLength > 0 && (dimension < 2 || idNode->symbolEntry->type->sizeOfEachDimension[dimension - 1] != rowLength))
+        return 0;
+    for(d = 0; indexNode; d++, indexNode = indexNode->rightSibling){
+        int kind = _subscriptKind(nest, indexNode, &constant);
+        if(rowLength > 0 && d == dimension - 1){
+            if(kind != SUBSCRIPT_INNER || constant != 0)
+                return 0;
+        }
+        else if(d == dimension - 1 - (rowLength > 0)){
+            if(kind != SUBSCRIPT_OUTER)
+                return 0;
+        }
+        else if(kind != SUBSCRIPT_NONE && kind != SUBSCRIPT_INVARIANT)
+            return 0;
+    }
+    return 1;
+}
+
+int analyzeLoopIdiom(LocalVarSet* pThis, AST_NODE* forStmtNode, LoopIdiom* idiom){
+    LoopNest nest;
+    nest.numOfWritten = 0;
+    idiom->kind = IDIOM_NONE;
+    if(!_matchCountedHeader(pThis, forStmtNode, &(nest.outer)) || nest.outer.step != 1)
+        return IDIOM_NONE;
+    nest.inner = nest.outer;
+    idiom->loop = nest.outer;
+    idiom->rowLength = 0;
+    long long numOfElement = nest.outer.tripCount;
+
+    /* inner loop from 0 over a whole row */
+    AST_NODE* bodyNode = forStmtNode->child->rightSibling->rightSibling->rightSibling;
+    idiom->rowLoopNode = _innerLoopOf(forStmtNode);
+    if(idiom->rowLoopNode){
+        if(!_matchCountedHeader(pThis, idiom->rowLoopNode, &(nest.inner)) || nest.inner.step != 1 ||
+          !nest.inner.initNode || !_isIntConst(nest.inner.initNode) || nest.inner.first != 0 ||
+          nest.inner.tripCount <= 0 || nest.inner.indexNode->symbolEntry == nest.outer.indexNode->symbolEntry)
+            return IDIOM_NONE;
+        idiom->rowLength = nest.inner.tripCount;
+        idiom->rowIndexNode = nest.inner.indexNode;
+        if(numOfElement != -1)
+            numOfElement *= idiom->rowLength;
+        bodyNode = idiom->rowLoopNode->child->rightSibling->rightSibling->rightSibling;
+    }
+    if(numOfElement != -1 && numOfElement < MIN_IDIOM_TRIP)
+        return IDIOM_NONE;
+
+    /* body is a single assignment */
+    if(bodyNode->nodeType == BLOCK_NODE){
+        if(!bodyNode->child || bodyNode->child->nodeType != STMT_LIST_NODE || bodyNode->child->rightSibling ||
+          !bodyNode->child->child || bodyNode->child->child->rightSibling)
+            return IDIOM_NONE;
+        bodyNode = bodyNode->child->child;
+    }
+    if(bodyNode->nodeType != STMT_NODE || bodyNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT ||
+      bodyNode->isDeadStore || !_isConsecutiveElement(&nest, bodyNode->child, idiom->rowLength))
+        return IDIOM_NONE;
+    idiom->destNode = bodyNode->child;
+    idiom->srcNode = bodyNode->child->rightSibling;
+
+    AST_NODE* srcNode = idiom->srcNode;
+    if(srcNode->nodeType == IDENTIFIER_NODE && srcNode->symbolEntry && srcNode->symbolEntry->type->dimension > 0){
+        if(_isConsecutiveElement(&nest, srcNode, idiom->rowLength) &&
+          srcNode->symbolEntry->type->primitiveType == idiom->destNode->symbolEntry->type->primitiveType)
+            idiom->kind = IDIOM_COPY;
+    }
+    else if(_isIntConst(srcNode) || (srcNode->nodeType == CONST_VALUE_NODE &&
+      srcNode->semantic_value.const1->const_type == FLOATC) || _isNestInvariant(&nest, srcNode))
+        idiom->kind = IDIOM_FILL;
+    return idiom->kind;
+}
+
+/*** If Conversion ***/
+AST_NODE* _getSingleAssignment(AST_NODE* stmtNode){
+    /* assignment statement, alone or in blocks without declaration */
+    while(stmtNode->nodeType == BLOCK_NODE){
+        AST_NODE* stmtListNode = stmtNode->child;
+        if(!stmtListNode || stmtListNode->nodeType != STMT_LIST_NODE || stmtListNode->rightSibling ||
+          !stmtListNode->child || stmtListNode->child->rightSibling)
+            return NULL;
+        stmtNode = stmtListNode->child;
+    }
+    if(stmtNode->nodeType != STMT_NODE || stmtNode->semantic_value.stmtSemanticValue.kind != ASSIGN_STMT)
+        return NULL;
+    return stmtNode;
+}
+
+int _readsElement(AST_NODE* node, AST_NODE* elementNode){
+    if(node->nodeType == IDENTIFIER_NODE && node->symbolEntry == elementNode->symbolEntry &&
+      _isSameIndex(node->child, elementNode->child))
+        return 1;
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        if(_readsElement(child, elementNode))
+            return 1;
+    return 0;
+}
+
+int _hasLogicOp(AST_NODE* node){
+    /* && and || branch */
+    if(node->nodeType == EXPR_NODE && node->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+      (node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_AND ||
+       node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_OR))
+        return 1;
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        if(_hasLogicOp(child))
+            return 1;
+    return 0;
+}
+
+int _isSpeculativeValue(AST_NODE* node, AST_NODE* condNode, int* numOfOps){
+    /* value computed before condition is known */
+    if(node->nodeType == CONST_VALUE_NODE)
+        return node->semantic_value.const1->const_type != STRINGC;
+    if(node->nodeType == IDENTIFIER_NODE){
+        SymbolTableEntry* entry = node->symbolEntry;
+        if(!entry || entry->kind == FUNC_ENTRY || entry->kind == TYPE_ENTRY)
+            return 0;
+        if(!node->child)
+            return entry->type->dimension == 0;
+        /* index is in bounds if condition reads the element */
+        return isPureIndex(node->child) && _readsElement(condNode, node);
+    }
+    if(node->nodeType != EXPR_NODE || ++(*numOfOps) > MAX_SELECT_OPS)
+        return 0;
+    if(node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return _isSpeculativeValue(node->child, condNode, numOfOps);
+
+    BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+    AST_NODE* rightNode = node->child->rightSibling;
+    if(op == BINARY_OP_AND || op == BINARY_OP_OR)
+        return 0;
+    if(op == BINARY_OP_DIV && (rightNode->nodeType != CONST_VALUE_NODE ||
+      (rightNode->semantic_value.const1->const_type == INTEGERC ?
+       rightNode->semantic_value.const1->const_u.intval == 0 : rightNode->semantic_value.const1->const_u.fval == 0)))
+        return 0; /* divisor may be zero */
+    return _isSpeculativeValue(node->child, condNode, numOfOps) &&
+      _isSpeculativeValue(rightNode, condNode, numOfOps);
+}
+
+int isSelectIf(AST_NODE* ifStmtNode, AST_NODE** thenAssignNode, AST_NODE** elseAssignNode){
+    AST_NODE* condNode = ifStmtNode->child;
+    AST_NODE* thenNode = condNode->rightSibling;
+    AST_NODE* elseNode = thenNode->rightSibling;
+    *thenAssignNode = _getSingleAssignment(thenNode);
+    *elseAssignNode = elseNode->nodeType == NUL_NODE ? NULL : _getSingleAssignment(elseNode);
+    if(!*thenAssignNode || (elseNode->nodeType != NUL_NODE && !*elseAssignNode) ||
+      hasFuncCall(condNode) || _hasLogicOp(condNode))
+        return 0;
+
+    /* both branches assign same scalar */
+    AST_NODE* lvalueNode = (*thenAssignNode)->child;
+    SymbolTableEntry* entry = lvalueNode->symbolEntry;
+    if(!entry || entry->type->dimension != 0 || (*thenAssignNode)->isDeadStore)
+        return 0;
+    if(*elseAssignNode &&
+      ((*elseAssignNode)->child->symbolEntry != entry || (*elseAssignNode)->isDeadStore))
+        return 0;
+
+    int numOfOps = 0;
+    if(!_isSpeculativeValue(lvalueNode->rightSibling, condNode, &numOfOps))
+        return 0;
+    return !*elseAssignNode || _isSpeculativeValue((*elseAssignNode)->child->rightSibling, condNode, &numOfOps);
+}
+
+/*** Multi-way Branch ***/
+AST_NODE* _getCaseExpr(AST_NODE* condNode, int* value){
+    /* expr of expr == constant, or constant == expr */
+    if(condNode->nodeType != EXPR_NODE || condNode->semantic_value.exprSemanticValue.kind != BINARY_OPERATION ||
+      condNode->semantic_value.exprSemanticValue.op.binaryOp != BINARY_OP_EQ)
+        return NULL;
+    AST_NODE* leftNode = condNode->child;
+    AST_NODE* rightNode = leftNode->rightSibling;
+    if(getIntConstValue(rightNode, value))
+        return leftNode;
+    if(getIntConstValue(leftNode, value))
+        return rightNode;
+    return NULL;
+}
+
+int analyzeSwitchChain(LocalVarSet* pThis, AST_NODE* ifStmtNode, SwitchChain* chain){
+    /* tests after the first one are else branches, compared expression can't change between them */
+    AST_NODE* node = ifStmtNode;
+    int i, value;
+    chain->exprNode = _getCaseExpr(ifStmtNode->child, &value);
+    if(!chain->exprNode || !isPureIndex(chain->exprNode) || _usesFloat(chain->exprNode))
+        return 0;
+
+    chain->numOfCase = 0;
+    while(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == IF_STMT){
+        AST_NODE* exprNode = _getCaseExpr(node->child, &value);
+        if(!exprNode || !_isSameIndexNode(exprNode, chain->exprNode) ||
+          findUnswitchedOutcome(pThis, node) != -1 || chain->numOfCase == MAX_SWITCH_CASES)
+            break;
+        for(i = 0; i < chain->numOfCase; i++)
+            if(chain->values[i] == value)
+                return 0; /* later test is never true */
+        chain->values[chain->numOfCase] = value;
+        chain->caseNodes[chain->numOfCase] = node->child->rightSibling;
+        chain->numOfCase++;
+        node = node->child->rightSibling->rightSibling;
+    }
+    chain->defaultNode = node;
+    return chain->numOfCase >= MIN_SWITCH_CASES;
+}
+
+/*** Value Range Analysis ***/
+void initRangeAnalysis(RangeAnalysis* pThis){
+    pThis->numOfFunc = 0;
+    pThis->capacity = 8;
+    pThis->funcs = malloc(sizeof(FuncRanges) * pThis->capacity);
+    pThis->current = NULL;
+}
+
+void finRangeAnalysis(RangeAnalysis* pThis){
+    int i;
+    for(i = 0; i < pThis->numOfFunc; i++)
+        free(pThis->funcs[i].params);
+    free(pThis->funcs);
+}
+
+FuncRanges* _findFuncRanges(RangeAnalysis* pThis, char* name){
+    /* NULL for builtin function */
+    int i;
+    for(i = 0; i < pThis->numOfFunc; i++)
+        if(strcmp(pThis->funcs[i].name, name) == 0)
+            return &(pThis->funcs[i]);
+    return NULL;
+}
+
+int _isAssignedName(AST_NODE* node, char* name){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == IDENTIFIER_NODE && _isDefinedId(node) &&
+          strcmp(node->semantic_value.identifierSemanticValue.identifierName, name) == 0)
+            return 1;
+        if(_isAssignedName(node->child, name))
+            return 1;
+    }
+    return 0;
+}
+
+void _addFuncRanges(RangeAnalysis* pThis, AST_NODE* declarationNode){
+    AST_NODE* funcNameNode = declarationNode->child->rightSibling;
+    AST_NODE* paraListNode = funcNameNode->rightSibling;
+    if(pThis->numOfFunc == pThis->capacity){
+        pThis->capacity *= 2;
+        pThis->funcs = realloc(pThis->funcs, sizeof(FuncRanges) * pThis->capacity);
+    }
+    FuncRanges* func = &(pThis->funcs[pThis->numOfFunc++]);
+    func->name = funcNameNode->semantic_value.identifierSemanticValue.identifierName;
+    func->numOfParam = countRightSibling(paraListNode->child);
+    func->params = malloc(sizeof(ParamRange) * (func->numOfParam + 1));
+
+    AST_NODE* paraNode;
+    int i = 0;
+    for(paraNode = paraListNode->child; paraNode; paraNode = paraNode->rightSibling, i++){
+        ParamRange* param = &(func->params[i]);
+        param->name = paraNode->child->rightSibling->semantic_value.identifierSemanticValue.identifierName;
+        param->entry = NULL;
+        param->isKnown = !_isAssignedName(paraListNode->rightSibling->child, param->name);
+        param->isCalled = 0;
+    }
+}
+
+int _getArgConstValue(AST_NODE* node, int* value){
+    /* symbols aren't resolved yet, only literal int or its negation */
+    int isNegative = 0;
+    if(node->nodeType == EXPR_NODE && node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION &&
+      node->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_NEGATIVE){
+        isNegative = 1;
+        node = node->child;
+    }
+    if(!_isIntConst(node))
+        return 0;
+    *value = node->semantic_value.const1->const_u.intval;
+    if(isNegative)
+        *value = (int)(0u - (unsigned int)*value);
+    return 1;
+}
+
+void _scanCallArgs(RangeAnalysis* pThis, AST_NODE* node){
+    for(; node; node = node->rightSibling){
+        if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT){
+            FuncRanges* callee = _findFuncRanges(pThis, node->child->semantic_value.identifierSemanticValue.identifierName);
+            AST_NODE* argNode = node->child->rightSibling->child;
+            int i, value;
+            for(i = 0; callee && argNode && i < callee->numOfParam; i++, argNode = argNode->rightSibling){
+                ParamRange* param = &(callee->params[i]);
+                if(!_getArgConstValue(argNode, &value))
+                    param->isKnown = 0;
+                else if(!param->isCalled){
+                    param->isCalled = 1;
+                    param->min = value;
+                    param->max = value;
+                }
+                else{
+                    param->min = value < param->min ? value : param->min;
+                    param->max = value > param->max ? value : param->max;
+                }
+            }
+        }
+        _scanCallArgs(pThis, node->child);
+    }
+}
+
+void analyzeParamRanges(RangeAnalysis* pThis, AST_NODE* programNode){
+    AST_NODE* node;
+    for(node = programNode->child; node; node = node->rightSibling)
+        if(node->nodeType == DECLARATION_NODE &&
+          node->semantic_value.declSemanticValue.kind == FUNCTION_DECL)
+            _addFuncRanges(pThis, node);
+    _scanCallArgs(pThis, programNode->child);
+}
+
+void setRangeFunc(RangeAnalysis* pThis, char* funcName, STT* symbolTable){
+    /* parameters are in the scope just opened */
+    int i;
+    pThis->current = _findFuncRanges(pThis, funcName);
+    for(i = 0; pThis->current && i < pThis->current->numOfParam; i++){
+        ParamRange* param = &(pThis->current->params[i]);
+        param->entry = lookupSymbolCurrentScope(symbolTable, param->name);
+        if(!param->entry || param->entry->kind != VAR_ENTRY || param->entry->type->dimension != 0 ||
+          param->entry->type->primitiveType != INT_TYPE || !param->isCalled)
+            param->isKnown = 0;
+    }
+}
+
+int _minDimension(int size1, int size2){
+    /* 0 is no dimension */
+    return size1 == 0 || (size2 != 0 && size2 < size1) ? size2 : size1;
+}
+
+int _indexedDimension(AST_NODE* node, SymbolTableEntry* entry){
+    /* smallest declared dimension node always indexes directly by entry, 0 if none */
+    int size = 0;
+    if(node->nodeType == EXPR_NODE && node->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+      (node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_AND ||
+       node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_OR))
+        return _indexedDimension(node->child, entry); /* right operand may not be evaluated */
+
+    if(isArrayElement(node)){
+        /* first dimension of an array parameter isn't the size of the passed array */
+        AST_NODE* indexNode = node->child;
+        int k;
+        for(k = 0; indexNode; indexNode = indexNode->rightSibling, k++)
+            if(indexNode->nodeType == IDENTIFIER_NODE && !indexNode->child && indexNode->symbolEntry == entry &&
+              node->symbolEntry->type->sizeOfEachDimension[k] > 0 &&
+              (k > 0 || node->symbolEntry->place.kind != INDIRECT_ADDRESS))
+                size = _minDimension(size, node->symbolEntry->type->sizeOfEachDimension[k]);
+    }
+    AST_NODE* child;
+    for(child = node->child; child; child = child->rightSibling)
+        size = _minDimension(size, _indexedDimension(child, entry));
+    return size;
+}
+
+int _loopIndexRange(AST_NODE* idNode, long long* min, long long* max){
+    /* index of a counted loop whose body contains idNode and doesn't assign the index */
+    AST_NODE* node;
+    for(node = idNode; node->parent; node = node->parent){
+        AST_NODE* loopNode = node->parent;
+        if(loopNode->nodeType != STMT_NODE || loopNode->semantic_value.stmtSemanticValue.kind != FOR_STMT ||
+          node != loopNode->child->rightSibling->rightSibling->rightSibling)
+            continue;
+        CountedLoop loop;
+        if(!_matchCountedHeader(GR.localVars, loopNode, &loop) ||
+          loop.indexNode->symbolEntry != idNode->symbolEntry || _isAssignedIn(node, idNode->symbolEntry))
+            continue;
+
+        /* loop runs body only while index is within bounds */
+        *min = loop.initNode && _isIntConst(loop.initNode) ?
+          loop.initNode->semantic_value.const1->const_u.intval : RANGE_MIN;
+        *max = _isIntConst(loop.boundNode) ?
+          (long long)loop.boundNode->semantic_value.const1->const_u.intval - !loop.isInclusive : RANGE_MAX;
+
+        /* assignments at the start of body index arrays in bounds on every iteration */
+        AST_NODE* stmtNode = node;
+        if(node->nodeType == BLOCK_NODE)
+            stmtNode = node->child && node->child->nodeType == STMT_LIST_NODE ? node->child->child : NULL;
+        for(; stmtNode && stmtNode->nodeType == STMT_NODE &&
+          stmtNode->semantic_value.stmtSemanticValue.kind == ASSIGN_STMT; stmtNode = stmtNode->rightSibling){
+            int dimension = _indexedDimension(stmtNode, idNode->symbolEntry);
+            if(dimension > 0){
+                *min = *min > 0 ? *min : 0;
+                *max = *max < dimension - 1 ? *max : dimension - 1;
+            }
+            if(node->nodeType != BLOCK_NODE)
+                break;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int _exprRange(AST_NODE* node, long long* min, long long* max);
+
+int _relationOutcome(BINARY_OPERATOR op, long long min1, long long max1, long long min2, long long max2){
+    /* 1 or 0 if every pair of values gives it, -1 otherwise */
+    switch(op){
+        case BINARY_OP_LT:
+            return max1 < min2 ? 1 : (min1 >= max2 ? 0 : -1);
+        case BINARY_OP_GE:
+            return max1 < min2 ? 0 : (min1 >= max2 ? 1 : -1);
+        case BINARY_OP_GT:
+            return min1 > max2 ? 1 : (max1 <= min2 ? 0 : -1);
+        case BINARY_OP_LE:
+            return min1 > max2 ? 0 : (max1 <= min2 ? 1 : -1);
+        case BINARY_OP_EQ: case BINARY_OP_NE:{
+            int outcome = -1;
+            if(max1 < min2 || max2 < min1)
+                outcome = 0;
+            else if(min1 == max1 && min2 == max2)
+                outcome = 1;
+            return outcome == -1 || op == BINARY_OP_EQ ? outcome : !outcome;
+        }
+        default:
+            return -1;
+    }
+}
+
+int _truthOutcome(long long min, long long max){
+    /* 1 or 0 if every value in range is true or false, -1 otherwise */
+    if(min == 0 && max == 0)
+        return 0;
+    return min > 0 || max < 0 ? 1 : -1;
+}
+
+int _binaryRange(AST_NODE* node, long long* min, long long* max){
+    BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+    long long min1, max1, min2, max2;
+    if(!_exprRange(node->child, &min1, &max1) || !_exprRange(node->child->rightSibling, &min2, &max2))
+        return 0;
+
+    int outcome = -1;
+    switch(op){
+        case BINARY_OP_ADD:
+            *min = min1 + min2;
+            *max = max1 + max2;
+            break;
+        case BINARY_OP_SUB:
+            *min = min1 - max2;
+            *max = max1 - min2;
+            break;
+        case BINARY_OP_MUL:{
+            long long products[4] = {min1 * min2, min1 * max2, max1 * min2, max1 * max2};
+            int i;
+            *min = *max = products[0];
+            for(i = 1; i < 4; i++){
+                *min = products[i] < *min ? products[i] : *min;
+                *max = products[i] > *max ? products[i] : *max;
+            }
+            break;
+        }
+        case BINARY_OP_DIV:
+            /* quotient by a known nonzero divisor is monotonic in dividend */
+            if(min2 != max2 || min2 == 0 || (min2 == -1 && min1 == RANGE_MIN)){
+                *min = RANGE_MIN;
+                *max = RANGE_MAX;
+                return 1;
+            }
+            *min = min2 > 0 ? min1 / min2 : max1 / min2;
+            *max = min2 > 0 ? max1 / min2 : min1 / min2;
+            break;
+        case BINARY_OP_AND: case BINARY_OP_OR:{
+            int outcome1 = _truthOutcome(min1, max1);
+            int outcome2 = _truthOutcome(min2, max2);
+            if(op == BINARY_OP_AND)
+                outcome = outcome1 == 0 || outcome2 == 0 ? 0 : (outcome1 == 1 && outcome2 == 1 ? 1 : -1);
+            else
+                outcome = outcome1 == 1 || outcome2 == 1 ? 1 : (outcome1 == 0 && outcome2 == 0 ? 0 : -1);
+            *min = outcome == 1 ? 1 : 0;
+            *max = outcome == 0 ? 0 : 1;
+            return 1;
+        }
+        default:
+            outcome = _relationOutcome(op, min1, max1, min2, max2);
+            *min = outcome == 1 ? 1 : 0;
+            *max = outcome == 0 ? 0 : 1;
+            return 1;
+    }
+
+    /* wrapped result may be anything */
+    if(*min < RANGE_MIN || *max > RANGE_MAX){
+        *min = RANGE_MIN;
+        *max = RANGE_MAX;
+    }
+    return 1;
+}
+
+int _exprRange(AST_NODE* node, long long* min, long long* max){
+    if(node->nodeType == CONST_VALUE_NODE){
+        if(node->semantic_value.const1->const_type != INTEGERC)
+            return 0;
+        *min = *max = node->semantic_value.const1->const_u.intval;
+        return 1;
+    }
+
+    if(node->nodeType == IDENTIFIER_NODE){
+        SymbolTableEntry* entry = node->symbolEntry;
+        if(!entry || entry->kind == FUNC_ENTRY || entry->kind == TYPE_ENTRY ||
+          entry->type->primitiveType != INT_TYPE || countRightSibling(node->child) != entry->type->dimension ||
+          hasFuncCall(node))
+            return 0;
+        *min = RANGE_MIN;
+        *max = RANGE_MAX;
+        if(entry->type->dimension == 0 && !_loopIndexRange(node, min, max) && GR.rangeAnalysis->current){
+            FuncRanges* func = GR.rangeAnalysis->current;
+            int i;
+            for(i = 0; i < func->numOfParam; i++)
+                if(func->params[i].entry == entry && func->params[i].isKnown){
+                    *min = func->params[i].min;
+                    *max = func->params[i].max;
+                }
+        }
+        return 1;
+    }
+
+    if(node->nodeType != EXPR_NODE)
+        return 0;
+    if(node->semantic_value.exprSemanticValue.kind == BINARY_OPERATION)
+        return _binaryRange(node, min, max);
+
+    long long childMin, childMax;
+    if(!_exprRange(node->child, &childMin, &childMax))
+        return 0;
+    switch(node->semantic_value.exprSemanticValue.op.unaryOp){
+        case UNARY_OP_POSITIVE:
+            *min = childMin;
+            *max = childMax;
+            break;
+        case UNARY_OP_NEGATIVE:
+            *min = childMin == RANGE_MIN ? RANGE_MIN : -childMax;
+            *max = childMin == RANGE_MIN ? RANGE_MAX : -childMin;
+            break;
+        case UNARY_OP_LOGICAL_NEGATION:{
+            int outcome = _truthOutcome(childMin, childMax);
+            *min = outcome == 0 ? 1 : 0;
+            *max = outcome == 1 ? 0 : 1;
+            break;
+        }
+    }
+    return 1;
+}
+
+int getExprRange(AST_NODE* exprNode, int* min, int* max){
+    long long rangeMin, rangeMax;
+    if(!_exprRange(exprNode, &rangeMin, &rangeMax))
+        return 0;
+    *min = (int)rangeMin;
+    *max = (int)rangeMax;
+    return 1;
+}
+
+int getKnownCondition(AST_NODE* condNode, int* outcome){
+    int min, max;
+    if(!getExprRange(condNode, &min, &max))
+        return 0;
+    *outcome = _truthOutcome(min, max);
+    return *outcome != -1;
+}
+
+/*** Expression Simplification ***/
+DATA_TYPE _exprType(AST_NODE* node){
+    if(node->nodeType == CONST_VALUE_NODE){
+        if(node->semantic_value.const1->const_type == INTEGERC)
+            return INT_TYPE;
+        return node->semantic_value.const1->const_type == FLOATC ? FLOAT_TYPE : NONE_TYPE;
+    }
+    if(node->nodeType == STMT_NODE && node->semantic_value.stmtSemanticValue.kind == FUNCTION_CALL_STMT)
+        return node->child->symbolEntry ? node->child->symbolEntry->type->primitiveType : NONE_TYPE;
+    if(node->nodeType == IDENTIFIER_NODE){
+        SymbolTableEntry* entry = node->symbolEntry;
+        if(!entry || entry->kind == FUNC_ENTRY || entry->kind == TYPE_ENTRY ||
+          countRightSibling(node->child) != entry->type->dimension)
+            return NONE_TYPE;
+        return entry->type->primitiveType;
+    }
+    if(node->nodeType != EXPR_NODE)
+        return NONE_TYPE;
+
+    if(node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return node->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_LOGICAL_NEGATION ?
+          INT_TYPE : _exprType(node->child);
+    BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+    if(op != BINARY_OP_ADD && op != BINARY_OP_SUB && op != BINARY_OP_MUL && op != BINARY_OP_DIV)
+        return INT_TYPE;
+    DATA_TYPE type1 = _exprType(node->child);
+    DATA_TYPE type2 = _exprType(node->child->rightSibling);
+    if(type1 == NONE_TYPE || type2 == NONE_TYPE)
+        return NONE_TYPE;
+    return type1 == FLOAT_TYPE || type2 == FLOAT_TYPE ? FLOAT_TYPE : INT_TYPE;
+}
+
+int _isConstOf(AST_NODE* node, int value){
+    /* int or float constant equal to value */
+    if(node->nodeType != CONST_VALUE_NODE)
+        return 0;
+    if(node->semantic_value.const1->const_type == INTEGERC)
+        return node->semantic_value.const1->const_u.intval == value;
+    return node->semantic_value.const1->const_type == FLOATC && node->semantic_value.const1->const_u.fval == value;
+}
+
+AST_NODE* _newIntConst(int value){
+    AST_NODE* node = Allocate(CONST_VALUE_NODE);
+    node->semantic_value.const1 = malloc(sizeof(CON_Type));
+    node->semantic_value.const1->const_type = INTEGERC;
+    node->semantic_value.const1->const_u.intval = value;
+    node->dataType = INT_TYPE;
+    return node;
+}
+
+AST_NODE* _newFloatConst(float value){
+    AST_NODE* node = Allocate(CONST_VALUE_NODE);
+    node->semantic_value.const1 = malloc(sizeof(CON_Type));
+    node->semantic_value.const1->const_type = FLOATC;
+    node->semantic_value.const1->const_u.fval = value;
+    node->dataType = FLOAT_TYPE;
+    return node;
+}
+
+AST_NODE* _newExpr(EXPR_KIND kind, int op, DATA_TYPE type, AST_NODE* child1, AST_NODE* child2){
+    /* child2 is NULL for unary operation */
+    AST_NODE* node = Allocate(EXPR_NODE);
+    node->semantic_value.exprSemanticValue.kind = kind;
+    node->semantic_value.exprSemanticValue.isConstEval = 0;
+    if(kind == BINARY_OPERATION)
+        node->semantic_value.exprSemanticValue.op.binaryOp = op;
+    else
+        node->semantic_value.exprSemanticValue.op.unaryOp = op;
+    node->dataType = type;
+    node->linenumber = child1->linenumber;
+    node->child = child1;
+    child1->parent = node;
+    child1->leftmostSibling = child1;
+    child1->rightSibling = child2;
+    if(child2){
+        child2->parent = node;
+        child2->leftmostSibling = child1;
+        child2->rightSibling = NULL;
+    }
+    return node;
+}
+
+void _replaceNode(AST_NODE* oldNode, AST_NODE* newNode){
+    /* newNode takes the place of oldNode among its siblings */
+    AST_NODE* parent = oldNode->parent;
+    AST_NODE** link = &(parent->child);
+    while(*link != oldNode)
+        link = &((*link)->rightSibling);
+    *link = newNode;
+    newNode->parent = parent;
+    newNode->rightSibling = oldNode->rightSibling;
+    AST_NODE* sibling;
+    for(sibling = parent->child; sibling; sibling = sibling->rightSibling)
+        sibling->leftmostSibling = parent->child;
+}
+
+AST_NODE* _simplifyExpr(AST_NODE* node);
+
+int _isChainOp(ExprChain* chain, AST_NODE* node){
+    if(node->nodeType != EXPR_NODE || _exprType(node) != chain->type)
+        return 0;
+    if(node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return chain->op == BINARY_OP_ADD && node->semantic_value.exprSemanticValue.op.unaryOp != UNARY_OP_LOGICAL_NEGATION;
+    BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+    return op == chain->op || (chain->op == BINARY_OP_ADD && op == BINARY_OP_SUB);
+}
+
+int _collectChain(ExprChain* chain, AST_NODE* node, int isNegative){
+    /* terms of chain in evaluation order, return 0 if there are too many or a float chain mixes int terms */
+    if(_isChainOp(chain, node)){
+        if(node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+            return _collectChain(chain, node->child,
+              isNegative ^ (node->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_NEGATIVE));
+        return _collectChain(chain, node->child, isNegative) &&
+          _collectChain(chain, node->child->rightSibling,
+            isNegative ^ (node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_SUB));
+    }
+    if(chain->numOfTerm == MAX_CHAIN_TERMS ||
+      (node->nodeType != CONST_VALUE_NODE && _exprType(node) != chain->type))
+        return 0;
+    chain->terms[chain->numOfTerm] = node;
+    chain->isNegative[chain->numOfTerm] = isNegative;
+    chain->numOfTerm++;
+    return 1;
+}
+
+void _foldChainConst(ExprChain* chain, AST_NODE* constNode, int isNegative){
+    CON_Type* value = constNode->semantic_value.const1;
+    if(chain->type == INT_TYPE){
+        unsigned int intValue = (unsigned int)value->const_u.intval;
+        if(chain->op == BINARY_OP_MUL)
+            chain->intConst = (int)((unsigned int)chain->intConst * intValue);
+        else
+            chain->intConst = (int)((unsigned int)chain->intConst + (isNegative ? 0u - intValue : intValue));
+    }
+    else{
+        float floatValue = value->const_type == INTEGERC ? (float)value->const_u.intval : value->const_u.fval;
+        if(chain->op == BINARY_OP_MUL)
+            chain->floatConst *= floatValue;
+        else
+            chain->floatConst += isNegative ? -floatValue : floatValue;
+    }
+    chain->numOfConst++;
+}
+
+int _separateChainConsts(ExprChain* chain){
+    /* simplify terms and fold constants out of them, return 1 if any term changes */
+    int isChanged = 0;
+    int i, numOfTerm = 0;
+    chain->numOfConst = 0;
+    chain->intConst = chain->op == BINARY_OP_MUL;
+    chain->floatConst = chain->op == BINARY_OP_MUL;
+    chain->isConstLast = chain->terms[chain->numOfTerm - 1]->nodeType == CONST_VALUE_NODE;
+    for(i = 0; i < chain->numOfTerm; i++){
+        AST_NODE* termNode = _simplifyExpr(chain->terms[i]);
+        isChanged |= termNode != chain->terms[i];
+        if(termNode->nodeType == CONST_VALUE_NODE &&
+          (chain->type == FLOAT_TYPE || termNode->semantic_value.const1->const_type == INTEGERC)){
+            _foldChainConst(chain, termNode, chain->isNegative[i]);
+            continue;
+        }
+        chain->terms[numOfTerm] = termNode;
+        chain->isNegative[numOfTerm] = chain->isNegative[i];
+        numOfTerm++;
+    }
+    chain->numOfTerm = numOfTerm;
+    return isChanged;
+}
+
+int _cancelChainTerms(ExprChain* chain){
+    /* pure int term both added and subtracted, return 1 if any cancels */
+    int i, j, k;
+    for(i = 0; i < chain->numOfTerm; i++){
+        if(!chain->isNegative[i] || !_isPureIndexNode(chain->terms[i]))
+            continue;
+        for(j = 0; j < chain->numOfTerm; j++)
+            if(!chain->isNegative[j] && _isSameIndexNode(chain->terms[i], chain->terms[j]))
+                break;
+        if(j == chain->numOfTerm)
+            continue;
+        for(k = 0; k < chain->numOfTerm; k++)
+            if(k != i && k != j){
+                int index = k - (k > i) - (k > j);
+                chain->terms[index] = chain->terms[k];
+                chain->isNegative[index] = chain->isNegative[k];
+            }
+        chain->numOfTerm -= 2;
+        return 1;
+    }
+    return 0;
+}
+
+AST_NODE* _chainTermNode(ExprChain* chain, int index){
+    if(!chain->isNegative[index])
+        return chain->terms[index];
+    return _newExpr(UNARY_OPERATION, UNARY_OP_NEGATIVE, chain->type, chain->terms[index], NULL);
+}
+
+AST_NODE* _balanceTerms(ExprChain* chain, AST_NODE** terms, int numOfTerm){
+    /* terms of the same sign */
+    if(numOfTerm == 1)
+        return terms[0];
+    int half = numOfTerm / 2;
+    return _newExpr(BINARY_OPERATION, chain->op, chain->type,
+      _balanceTerms(chain, terms, half), _balanceTerms(chain, terms + half, numOfTerm - half));
+}
+
+AST_NODE* _buildChain(ExprChain* chain){
+    /* terms, then constant as immediate operand */
+    AST_NODE* resultNode = NULL;
+    int i, isPure = 1;
+    for(i = 0; i < chain->numOfTerm; i++)
+        isPure &= !hasFuncCall(chain->terms[i]);
+
+    if(isPure && chain->numOfTerm >= MIN_BALANCED_TERMS){
+        /* order of terms without call doesn't matter, int add/sub wrap (addu/subu) */
+        AST_NODE* groups[2][MAX_CHAIN_TERMS];
+        int numOfGroup[2] = {0, 0};
+        for(i = 0; i < chain->numOfTerm; i++)
+            groups[chain->isNegative[i]][numOfGroup[chain->isNegative[i]]++] = chain->terms[i];
+        if(numOfGroup[0] > 0)
+            resultNode = _balanceTerms(chain, groups[0], numOfGroup[0]);
+        if(numOfGroup[1] > 0 && resultNode)
+            resultNode = _newExpr(BINARY_OPERATION, BINARY_OP_SUB, chain->type,
+              resultNode, _balanceTerms(chain, groups[1], numOfGroup[1]));
+        else if(numOfGroup[1] > 0)
+            resultNode = _newExpr(UNARY_OPERATION, UNARY_OP_NEGATIVE, chain->type,
+              _balanceTerms(chain, groups[1], numOfGroup[1]), NULL);
+    }
+    else if(chain->numOfTerm > 0){
+        resultNode = _chainTermNode(chain, 0);
+        for(i = 1; i < chain->numOfTerm; i++)
+            resultNode = chain->isNegative[i] ?
+              _newExpr(BINARY_OPERATION, BINARY_OP_SUB, chain->type, resultNode, chain->terms[i]) :
+              _newExpr(BINARY_OPERATION, chain->op, chain->type, resultNode, chain->terms[i]);
+    }
+
+    /* identity constant is dropped */
+    int isIdentity = chain->type == INT_TYPE ? chain->intConst == (chain->op == BINARY_OP_MUL) :
+      chain->floatConst == (chain->op == BINARY_OP_MUL);
+    if(!resultNode)
+        return chain->type == INT_TYPE ? _newIntConst(chain->intConst) : _newFloatConst(chain->floatConst);
+    if(chain->numOfConst == 0 || isIdentity)
+        return resultNode;
+    if(chain->type == INT_TYPE && chain->op == BINARY_OP_MUL && chain->intConst == -1)
+        return _newExpr(UNARY_OPERATION, UNARY_OP_NEGATIVE, INT_TYPE, resultNode, NULL);
+
+    if(chain->op == BINARY_OP_ADD && chain->type == INT_TYPE && chain->intConst < 0 && chain->intConst != (int)RANGE_MIN)
+        return _newExpr(BINARY_OPERATION, BINARY_OP_SUB, INT_TYPE, resultNode, _newIntConst(-chain->intConst));
+    if(chain->op == BINARY_OP_ADD && chain->type == FLOAT_TYPE && chain->floatConst < 0)
+        return _newExpr(BINARY_OPERATION, BINARY_OP_SUB, FLOAT_TYPE, resultNode, _newFloatConst(-chain->floatConst));
+    return _newExpr(BINARY_OPERATION, chain->op, chain->type, resultNode,
+      chain->type == INT_TYPE ? _newIntConst(chain->intConst) : _newFloatConst(chain->floatConst));
+}
+
+AST_NODE* _simplifyChain(AST_NODE* node){
+    /* NULL if node isn't root of a chain which can be reassociated */
+    ExprChain chain;
+    chain.type = _exprType(node);
+    chain.op = node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_MUL ? BINARY_OP_MUL : BINARY_OP_ADD;
+    chain.numOfTerm = 0;
+    if((chain.type != INT_TYPE && (chain.type != FLOAT_TYPE || !GR.isFastMath)) ||
+      !_collectChain(&chain, node, 0))
+        return NULL;
+
+    int isChanged = _separateChainConsts(&chain);
+    if(chain.type == INT_TYPE)
+        while(_cancelChainTerms(&chain))
+            isChanged = 1;
+    if(chain.type == INT_TYPE && chain.op == BINARY_OP_MUL && chain.intConst == 0 && chain.numOfConst > 0){
+        /* product is zero unless a term calls */
+        int i;
+        for(i = 0; i < chain.numOfTerm && !hasFuncCall(chain.terms[i]); i++)
+            ;
+        if(i == chain.numOfTerm)
+            return _newIntConst(0);
+    }
+
+    int isIdentity = chain.type == INT_TYPE ? chain.intConst == (chain.op == BINARY_OP_MUL) :
+      chain.floatConst == (chain.op == BINARY_OP_MUL);
+    if(!isChanged && chain.numOfTerm < MIN_BALANCED_TERMS && chain.numOfTerm > 0 &&
+      (chain.numOfConst == 0 || (chain.numOfConst == 1 && chain.isConstLast && !isIdentity)))
+        return node; /* already canonical */
+    return _buildChain(&chain);
+}
+
+AST_NODE* _simplifyUnary(AST_NODE* node){
+    AST_NODE* childNode = node->child;
+    UNARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.unaryOp;
+    int isChildUnary = childNode->nodeType == EXPR_NODE &&
+      childNode->semantic_value.exprSemanticValue.kind == UNARY_OPERATION;
+    if(op == UNARY_OP_POSITIVE)
+        return childNode;
+    if(op == UNARY_OP_NEGATIVE && isChildUnary &&
+      childNode->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_NEGATIVE)
+        return childNode->child;
+    if(op != UNARY_OP_LOGICAL_NEGATION)
+        return node;
+
+    if(isChildUnary && childNode->semantic_value.exprSemanticValue.op.unaryOp == UNARY_OP_LOGICAL_NEGATION &&
+      _exprType(childNode->child) == INT_TYPE)
+        /* !!x is x != 0 */
+        return _newExpr(BINARY_OPERATION, BINARY_OP_NE, INT_TYPE, childNode->child, _newIntConst(0));
+    if(childNode->nodeType == EXPR_NODE && childNode->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+      _exprType(childNode->child) == INT_TYPE && _exprType(childNode->child->rightSibling) == INT_TYPE){
+        /* inverse of int comparison, float one differs for NaN */
+        BINARY_OPERATOR inverse;
+        switch(childNode->semantic_value.exprSemanticValue.op.binaryOp){
+            case BINARY_OP_EQ: inverse = BINARY_OP_NE; break;
+            case BINARY_OP_NE: inverse = BINARY_OP_EQ; break;
+            case BINARY_OP_LT: inverse = BINARY_OP_GE; break;
+            case BINARY_OP_GE: inverse = BINARY_OP_LT; break;
+            case BINARY_OP_GT: inverse = BINARY_OP_LE; break;
+            case BINARY_OP_LE: inverse = BINARY_OP_GT; break;
+            default: return node;
+        }
+        childNode->semantic_value.exprSemanticValue.op.binaryOp = inverse;
+        return childNode;
+    }
+    return node;
+}
+
+AST_NODE* _simplifyBinary(AST_NODE* node){
+    /* identities exact for float too */
+    AST_NODE* child1 = node->child;
+    AST_NODE* child2 = child1->rightSibling;
+    BINARY_OPERATOR op = node->semantic_value.exprSemanticValue.op.binaryOp;
+    DATA_TYPE type = _exprType(node);
+    if(type == NONE_TYPE)
+        return node;
+    if((op == BINARY_OP_MUL || op == BINARY_OP_DIV) && _isConstOf(child2, 1) && _exprType(child1) == type)
+        return child1;
+    if(op == BINARY_OP_MUL && _isConstOf(child1, 1) && _exprType(child2) == type)
+        return child2;
+    if(op == BINARY_OP_SUB && _isConstOf(child2, 0) && _exprType(child1) == type)
+        return child1;
+    return node;
+}
+
+AST_NODE* _simplifyExpr(AST_NODE* node){
+    /* simplified node, which may be a new one or a descendant. caller links it in place of node */
+    if(node->nodeType != EXPR_NODE){
+        _simplifyExprs(node->child);
+        return node;
+    }
+
+    if(node->semantic_value.exprSemanticValue.kind == BINARY_OPERATION &&
+      (node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_ADD ||
+       node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_SUB ||
+       node->semantic_value.exprSemanticValue.op.binaryOp == BINARY_OP_MUL)){
+        AST_NODE* chainNode = _simplifyChain(node);
+        if(chainNode)
+            return chainNode;
+    }
+
+    _simplifyExprs(node->child);
+    if(node->semantic_value.exprSemanticValue.kind == UNARY_OPERATION)
+        return _simplifyUnary(node);
+    return _simplifyBinary(node);
+}
+
+void _simplifyExprs(AST_NODE* node){
+    while(node){
+        AST_NODE* newNode = node;
+        if(node->nodeType == EXPR_NODE){
+            newNode = _simplifyExpr(node);
+            if(newNode != node)
+                _replaceNode(node, newNode);
+        }
+        else
+            _simplifyExprs(node->child);
+        node = newNode->rightSibling;
+    }
+}
@@ -770,7 +770,14 @@ int main(int argc, char *argv[]){
 
     GRinit(&GR);
 
-    yyin = fopen(argv[1], "r");
+    int argIndex = 1;
+    for(; argIndex < argc - 1 && argv[argIndex][0] == '-'; argIndex++){
+        if(strcmp(argv[argIndex], "-ffast-math") == 0)
+            GR.isFastMath = 1;
+        else if(strcmp(argv[argIndex], "-fdelay-slots") == 0)
+            GR.isDelaySlot = 1;
+    }
+    yyin = fopen(argv[argIndex], "r");
     yyparse();
     printGV(prog, NULL);
 
@@ -785,10 +792,13 @@ int main(int argc, char *argv[]){
     FILE* targetFile = fopen("output.s", "w");
     codeGen(targetFile, prog, symTable);
     genConstStrings(GR.constStrings, targetFile);
+    genConstPool(GR.constPool, targetFile);
+    genRuntime(targetFile);
     GRfin(&GR);
     closeGlobalScope(symTable);
     
     fclose(targetFile);
+    scheduleAsmFile("output.s", GR.isDelaySlot);
 } /* main */
 
 int yyerror (mesg)
@@ -0,0 +1,535 @@
+#include <stdio.h>
+#include "header.h"
+#include "codeGen.h"
+
+extern GlobalResource GR;
+
+/*** Runtime Library ***/
+/* MIPS routines called by generated code, emitted once after the program.
+ * Routines only use $v0, $v1, $a0 ~ $a3, $t8, $t9, $f0 ~ $f3 and $ra,
+ * registers of RegisterManager are preserved across the call.
+ */
+
+/* all output goes through _outbuf, it is printed with one print_string
+ * when a written string ends a line, when it is full, before reading input
+ * and at the end of main */
+static const char* outputRuntime[] = {
+    "# output buffer, flushed by _write_flush",
+    ".data",
+    "_outbuf: .space 260",
+    "_outlen: .word 0",
+    "_numbuf: .space 12",
+    ".text",
+    "# _write_flush: print buffered output",
+    "_write_flush:",
+    "    lw   $v1, _outlen",
+    "    beq  $v1, $0, _write_flush_end",
+    "    la   $a0, _outbuf",
+    "    addu $v1, $a0, $v1",
+    "    sb   $0, 0($v1)",
+    "    li   $v0, 4",
+    "    syscall",
+    "    sw   $0, _outlen",
+    "_write_flush_end:",
+    "    jr   $ra",
+    "# _write_str: append string at $a0, flush if it contains a newline",
+    "_write_str:",
+    "    move $a1, $a0",
+    "    la   $a3, _outbuf+256",
+    "_write_str_restart:",
+    "    move $v1, $0",
+    "    la   $a2, _outbuf",
+    "    lw   $t8, _outlen",
+    "    addu $a2, $a2, $t8",
+    "_write_str_loop:",
+    "    lb   $v0, 0($a1)",
+    "    beq  $v0, $0, _write_str_end",
+    "    beq  $a2, $a3, _write_str_full",
+    "    sb   $v0, 0($a2)",
+    "    addiu $a1, $a1, 1",
+    "    addiu $a2, $a2, 1",
+    "    xori $t8, $v0, 10",
+    "    bne  $t8, $0, _write_str_loop",
+    "    li   $v1, 1",
+    "    j    _write_str_loop",
+    "_write_str_full:",
+    "    la   $t8, _outbuf",
+    "    subu $t8, $a2, $t8",
+    "    sw   $t8, _outlen",
+    "    move $t9, $ra",
+    "    jal  _write_flush",
+    "    move $ra, $t9",
+    "    j    _write_str_restart",
+    "_write_str_end:",
+    "    la   $t8, _outbuf",
+    "    subu $t8, $a2, $t8",
+    "    sw   $t8, _outlen",
+    "    bne  $v1, $0, _write_flush",
+    "    jr   $ra",
+    "# _write_uint: append unsigned decimal of $a1 at $a2, $a2 is moved after it",
+    "_write_uint:",
+    "    la   $a3, _numbuf+11",
+    "    li   $t8, 10",
+    "_write_uint_digit:",
+    "    divu $a1, $t8",
+    "    mfhi $v0",
+    "    mflo $a1",
+    "    addiu $v0, $v0, 48",
+    "    addiu $a3, $a3, -1",
+    "    sb   $v0, 0($a3)",
+    "    bne  $a1, $0, _write_uint_digit",
+    "    la   $t8, _numbuf+11",
+    "_write_uint_copy:",
+    "    lb   $v0, 0($a3)",
+    "    sb   $v0, 0($a2)",
+    "    addiu $a3, $a3, 1",
+    "    addiu $a2, $a2, 1",
+    "    bne  $a3, $t8, _write_uint_copy",
+    "    jr   $ra",
+    "# _write_set_len: buffered text ends at $a2",
+    "_write_set_len:",
+    "    la   $v1, _outbuf",
+    "    subu $v1, $a2, $v1",
+    "    sw   $v1, _outlen",
+    "    jr   $ra",
+    "# _write_int: append decimal of $a0",
+    "_write_int:",
+    "    move $a1, $a0",
+    "    move $t9, $ra",
+    "    lw   $v1, _outlen",
+    "    slti $t8, $v1, 246",
+    "    bne  $t8, $0, _write_int_room",
+    "    jal  _write_flush",
+    "    move $v1, $0",
+    "_write_int_room:",
+    "    la   $a2, _outbuf",
+    "    addu $a2, $a2, $v1",
+    "    bgez $a1, _write_int_digits",
+    "    li   $v0, 45",
+    "    sb   $v0, 0($a2)",
+    "    addiu $a2, $a2, 1",
+    "    subu $a1, $0, $a1",
+    "_write_int_digits:",
+    "    jal  _write_uint",
+    "    move $ra, $t9",
+    "    j    _write_set_len",
+    "# _write_float: append $f12 as print_float does (%.8f, round half to even)",
+    "_write_float:",
+    "    move $t9, $ra",
+    "    lw   $v1, _outlen",
+    "    slti $t8, $v1, 237",
+    "    bne  $t8, $0, _write_float_room",
+    "    jal  _write_flush",
+    "_write_float_room:",
+    "    mfc1 $a0, $f12",
+    "    srl  $v0, $a0, 23",
+    "    andi $v0, $v0, 255",
+    "    sltiu $t8, $v0, 158",
+    "    bne  $t8, $0, _write_float_fmt",
+    "    # |x| >= 2^31, inf or nan, print it by syscall",
+    "    jal  _write_flush",
+    "    move $ra, $t9",
+    "    li   $v0, 2",
+    "    syscall",
+    "    jr   $ra",
+    "_write_float_fmt:",
+    "    move $ra, $t9",
+    "    lw   $v1, _outlen",
+    "    la   $a2, _outbuf",
+    "    addu $a2, $a2, $v1",
+    "    bgez $a0, _write_float_abs",
+    "    li   $t8, 45",
+    "    sb   $t8, 0($a2)",
+    "    addiu $a2, $a2, 1",
+    "_write_float_abs:",
+    "    # |x| = $a1 * 2^($v0 - 150)",
+    "    sll  $a1, $a0, 9",
+    "    srl  $a1, $a1, 9",
+    "    bne  $v0, $0, _write_float_normal",
+    "    li   $v0, 1",
+    "    j    _write_float_split",
+    "_write_float_normal:",
+    "    lui  $t8, 128",
+    "    or   $a1, $a1, $t8",
+    "_write_float_split:",
+    "    addiu $v0, $v0, -150",
+    "    bltz $v0, _write_float_frac",
+    "    sllv $a3, $a1, $v0",
+    "    move $a0, $0",
+    "    j    _write_float_digits",
+    "_write_float_frac:",
+    "    # integer part to $a3, fraction is $a1 / 2^s, s = $v0",
+    "    subu $v0, $0, $v0",
+    "    move $a3, $0",
+    "    sltiu $t8, $v0, 32",
+    "    beq  $t8, $0, _write_float_scale",
+    "    srlv $a3, $a1, $v0",
+    "    sllv $t8, $a3, $v0",
+    "    subu $a1, $a1, $t8",
+    "_write_float_scale:",
+    "    # $a0 = fraction * 10^8 / 2^(s-1), $v1 != 0 if bits are shifted out",
+    "    lui  $t8, 1525",
+    "    ori  $t8, $t8, 57600",
+    "    multu $a1, $t8",
+    "    mfhi $a1",
+    "    mflo $t8",
+    "    addiu $v0, $v0, -1",
+    "    sltiu $v1, $v0, 32",
+    "    beq  $v1, $0, _write_float_shift_hi",
+    "    move $a0, $t8",
+    "    move $v1, $0",
+    "    beq  $v0, $0, _write_float_round",
+    "    srlv $a0, $t8, $v0",
+    "    subu $v1, $0, $v0",
+    "    sllv $t9, $a1, $v1",
+    "    or   $a0, $a0, $t9",
+    "    sllv $v1, $t8, $v1",
+    "    j    _write_float_round",
+    "_write_float_shift_hi:",
+    "    move $a0, $0",
+    "    move $v1, $0",
+    "    sltiu $t9, $v0, 51",
+    "    beq  $t9, $0, _write_float_round",
+    "    addiu $v0, $v0, -32",
+    "    srlv $a0, $a1, $v0",
+    "    move $v1, $t8",
+    "    beq  $v0, $0, _write_float_round",
+    "    subu $t9, $0, $v0",
+    "    sllv $t9, $a1, $t9",
+    "    or   $v1, $v1, $t9",
+    "_write_float_round:",
+    "    andi $t9, $a0, 1",
+    "    srl  $a0, $a0, 1",
+    "    beq  $t9, $0, _write_float_carry",
+    "    bne  $v1, $0, _write_float_up",
+    "    andi $t9, $a0, 1",
+    "    beq  $t9, $0, _write_float_carry",
+    "_write_float_up:",
+    "    addiu $a0, $a0, 1",
+    "_write_float_carry:",
+    "    lui  $t8, 1525",
+    "    ori  $t8, $t8, 57600",
+    "    bne  $a0, $t8, _write_float_digits",
+    "    move $a0, $0",
+    "    addiu $a3, $a3, 1",
+    "_write_float_digits:",
+    "    # integer part $a3, 8 fraction digits $a0",
+    "    move $a1, $a3",
+    "    move $t9, $ra",
+    "    jal  _write_uint",
+    "    move $ra, $t9",
+    "    li   $t8, 46",
+    "    sb   $t8, 0($a2)",
+    "    addiu $a2, $a2, 9",
+    "    addiu $v1, $a2, -8",
+    "    move $a3, $a2",
+    "    li   $t8, 10",
+    "_write_float_frac_digit:",
+    "    divu $a0, $t8",
+    "    mfhi $v0",
+    "    mflo $a0",
+    "    addiu $v0, $v0, 48",
+    "    addiu $a3, $a3, -1",
+    "    sb   $v0, 0($a3)",
+    "    bne  $a3, $v1, _write_float_frac_digit",
+    "    j    _write_set_len",
+    NULL
+};
+
+/* main always flushes at exit, nothing to flush if the program never writes */
+static const char* flushStubRuntime[] = {
+    ".text",
+    "_write_flush:",
+    "    jr   $ra",
+    NULL
+};
+
+/* input is read a line at a time with read_string and parsed token by token.
+ * each value takes a whole line like read_int/read_float, rest of it is dropped
+ * and empty line gives 0 */
+static const char* inputRuntime[] = {
+    "# input buffer, refilled by _read_char",
+    ".data",
+    "_inbuf: .space 1024",
+    "_inptr: .word _inbuf",
+    ".align 3",
+    "_read_mant: .space 8",
+    "_read_sign: .word 0",
+    "_read_exp10: .word 0",
+    ".text",
+    "# _read_char: $v0 = next input character, 0 at the end of input",
+    "_read_char:",
+    "    lw   $v1, _inptr",
+    "    lbu  $v0, 0($v1)",
+    "    bne  $v0, $0, _read_char_next",
+    "    la   $a0, _inbuf",
+    "    sb   $0, 0($a0)",
+    "    li   $a1, 1024",
+    "    li   $v0, 8",
+    "    syscall",
+    "    la   $v1, _inbuf",
+    "    sw   $v1, _inptr",
+    "    lbu  $v0, 0($v1)",
+    "    beq  $v0, $0, _read_char_end",
+    "_read_char_next:",
+    "    addiu $v1, $v1, 1",
+    "    sw   $v1, _inptr",
+    "_read_char_end:",
+    "    jr   $ra",
+    "# _read_int: $v0 = next integer of input, 0 at the end of input",
+    "_read_int:",
+    "    move $t9, $ra",
+    "    jal  _write_flush",
+    "    move $a2, $0",
+    "    move $a3, $0",
+    "_read_int_skip:",
+    "    jal  _read_char",
+    "    beq  $v0, $0, _read_int_end",
+    "    xori $t8, $v0, 10",
+    "    beq  $t8, $0, _read_int_end",
+    "    slti $t8, $v0, 33",
+    "    bne  $t8, $0, _read_int_skip",
+    "    xori $t8, $v0, 45",
+    "    bne  $t8, $0, _read_int_plus",
+    "    li   $a3, 1",
+    "    j    _read_int_next",
+    "_read_int_plus:",
+    "    xori $t8, $v0, 43",
+    "    bne  $t8, $0, _read_int_digit",
+    "_read_int_next:",
+    "    jal  _read_char",
+    "_read_int_digit:",
+    "    addiu $v0, $v0, -48",
+    "    sltiu $t8, $v0, 10",
+    "    beq  $t8, $0, _read_int_rest",
+    "    sll  $t8, $a2, 3",
+    "    sll  $a2, $a2, 1",
+    "    addu $a2, $a2, $t8",
+    "    addu $a2, $a2, $v0",
+    "    j    _read_int_next",
+    "_read_int_rest:",
+    "    addiu $v0, $v0, 48",
+    "_read_int_line:",
+    "    xori $t8, $v0, 10",
+    "    beq  $t8, $0, _read_int_end",
+    "    beq  $v0, $0, _read_int_end",
+    "    jal  _read_char",
+    "    j    _read_int_line",
+    "_read_int_end:",
+    "    move $v0, $a2",
+    "    beq  $a3, $0, _read_int_ret",
+    "    subu $v0, $0, $a2",
+    "_read_int_ret:",
+    "    jr   $t9",
+    "# _read_float: $f0 = next float of input, 0.0 at the end of input",
+    "# digits are accumulated in double and scaled once by an exact power of ten",
+    "_read_float:",
+    "    move $t9, $ra",
+    "    jal  _write_flush",
+    "    mtc1 $0, $f0",
+    "    mtc1 $0, $f1",
+    "    sw   $0, _read_sign",
+    "    move $a2, $0",
+    "    move $a3, $0",
+    "_read_float_skip:",
+    "    jal  _read_char",
+    "    beq  $v0, $0, _read_float_sign",
+    "    xori $t8, $v0, 10",
+    "    beq  $t8, $0, _read_float_sign",
+    "    slti $t8, $v0, 33",
+    "    bne  $t8, $0, _read_float_skip",
+    "    xori $t8, $v0, 45",
+    "    bne  $t8, $0, _read_float_plus",
+    "    li   $t8, 1",
+    "    sw   $t8, _read_sign",
+    "    j    _read_float_next",
+    "_read_float_plus:",
+    "    xori $t8, $v0, 43",
+    "    bne  $t8, $0, _read_float_digit",
+    "_read_float_next:",
+    "    jal  _read_char",
+    "_read_float_digit:",
+    "    # $a2 = decimal exponent, $a3 = 1 after '.'",
+    "    xori $t8, $v0, 46",
+    "    bne  $t8, $0, _read_float_not_dot",
+    "    bne  $a3, $0, _read_float_line",
+    "    li   $a3, 1",
+    "    j    _read_float_next",
+    "_read_float_not_dot:",
+    "    addiu $v0, $v0, -48",
+    "    sltiu $t8, $v0, 10",
+    "    beq  $t8, $0, _read_float_exp",
+    "    li   $t8, 10",
+    "    mtc1 $t8, $f2",
+    "    cvt.d.w $f2, $f2",
+    "    mul.d $f0, $f0, $f2",
+    "    mtc1 $v0, $f2",
+    "    cvt.d.w $f2, $f2",
+    "    add.d $f0, $f0, $f2",
+    "    subu $a2, $a2, $a3",
+    "    j    _read_float_next",
+    "_read_float_exp:",
+    "    addiu $v0, $v0, 48",
+    "    ori  $t8, $v0, 32",
+    "    xori $t8, $t8, 101",
+    "    bne  $t8, $0, _read_float_line",
+    "    sw   $a2, _read_exp10",
+    "    move $a2, $0",
+    "    move $a3, $0",
+    "    jal  _read_char",
+    "    xori $t8, $v0, 45",
+    "    bne  $t8, $0, _read_float_exp_plus",
+    "    li   $a3, 1",
+    "    j    _read_float_exp_next",
+    "_read_float_exp_plus:",
+    "    xori $t8, $v0, 43",
+    "    bne  $t8, $0, _read_float_exp_digit",
+    "_read_float_exp_next:",
+    "    jal  _read_char",
+    "_read_float_exp_digit:",
+    "    addiu $v0, $v0, -48",
+    "    sltiu $t8, $v0, 10",
+    "    beq  $t8, $0, _read_float_exp_end",
+    "    sll  $t8, $a2, 3",
+    "    sll  $a2, $a2, 1",
+    "    addu $a2, $a2, $t8",
+    "    addu $a2, $a2, $v0",
+    "    j    _read_float_exp_next",
+    "_read_float_exp_end:",
+    "    beq  $a3, $0, _read_float_exp_pos",
+    "    subu $a2, $0, $a2",
+    "_read_float_exp_pos:",
+    "    lw   $t8, _read_exp10",
+    "    addu $a2, $a2, $t8",
+    "    addiu $v0, $v0, 48",
+    "_read_float_line:",
+    "    xori $t8, $v0, 10",
+    "    beq  $t8, $0, _read_float_scale",
+    "    beq  $v0, $0, _read_float_scale",
+    "    jal  _read_char",
+    "    j    _read_float_line",
+    "_read_float_scale:",
+    "    # $f0 = $f0 * 10^$a2, 10^k is exact in double for k <= 22",
+    "    beq  $a2, $0, _read_float_sign",
+    "    mtc1 $0, $f2",
+    "    mtc1 $0, $f3",
+    "    c.eq.d $f0, $f2",
+    "    bc1t _read_float_sign",
+    "    s.d  $f0, _read_mant",
+    "    move $a3, $a2",
+    "    bgez $a3, _read_float_abs_exp",
+    "    subu $a3, $0, $a3",
+    "_read_float_abs_exp:",
+    "    slti $t8, $a3, 400",
+    "    bne  $t8, $0, _read_float_pow",
+    "    li   $a3, 400",
+    "_read_float_pow:",
+    "    li   $t8, 1",
+    "    mtc1 $t8, $f0",
+    "    cvt.d.w $f0, $f0",
+    "    li   $t8, 10",
+    "    mtc1 $t8, $f2",
+    "    cvt.d.w $f2, $f2",
+    "_read_float_pow_loop:",
+    "    mul.d $f0, $f0, $f2",
+    "    addiu $a3, $a3, -1",
+    "    bne  $a3, $0, _read_float_pow_loop",
+    "    l.d  $f2, _read_mant",
+    "    bltz $a2, _read_float_div",
+    "    mul.d $f0, $f2, $f0",
+    "    j    _read_float_sign",
+    "_read_float_div:",
+    "    div.d $f0, $f2, $f0",
+    "_read_float_sign:",
+    "    cvt.s.d $f0, $f0",
+    "    lw   $t8, _read_sign",
+    "    beq  $t8, $0, _read_float_ret",
+    "    neg.s $f0, $f0",
+    "_read_float_ret:",
+    "    jr   $t9",
+    NULL
+};
+
+/* block routines of loops which fill or copy consecutive words,
+ * elements are stored in the order of the loop so overlapping copies behave the same */
+static const char* fillRuntime[] = {
+    ".text",
+    "# _array_fill: store $a2 to $a1 words from address $a0",
+    "_array_fill:",
+    "    slti $t8, $a1, 8",
+    "    bne  $t8, $0, _array_fill_rest",
+    "_array_fill_loop:",
+    "    sw   $a2, 0($a0)",
+    "    sw   $a2, 4($a0)",
+    "    sw   $a2, 8($a0)",
+    "    sw   $a2, 12($a0)",
+    "    sw   $a2, 16($a0)",
+    "    sw   $a2, 20($a0)",
+    "    sw   $a2, 24($a0)",
+    "    sw   $a2, 28($a0)",
+    "    addiu $a0, $a0, 32",
+    "    addiu $a1, $a1, -8",
+    "    slti $t8, $a1, 8",
+    "    beq  $t8, $0, _array_fill_loop",
+    "_array_fill_rest:",
+    "    blez $a1, _array_fill_end",
+    "    sw   $a2, 0($a0)",
+    "    addiu $a0, $a0, 4",
+    "    addiu $a1, $a1, -1",
+    "    j    _array_fill_rest",
+    "_array_fill_end:",
+    "    jr   $ra",
+    NULL
+};
+
+static const char* copyRuntime[] = {
+    ".text",
+    "# _array_copy: copy $a2 words from address $a1 to address $a0",
+    "_array_copy:",
+    "    slti $t8, $a2, 4",
+    "    bne  $t8, $0, _array_copy_rest",
+    "_array_copy_loop:",
+    "    lw   $t8, 0($a1)",
+    "    sw   $t8, 0($a0)",
+    "    lw   $t9, 4($a1)",
+    "    sw   $t9, 4($a0)",
+    "    lw   $t8, 8($a1)",
+    "    sw   $t8, 8($a0)",
+    "    lw   $t9, 12($a1)",
+    "    sw   $t9, 12($a0)",
+    "    addiu $a0, $a0, 16",
+    "    addiu $a1, $a1, 16",
+    "    addiu $a2, $a2, -4",
+    "    slti $t8, $a2, 4",
+    "    beq  $t8, $0, _array_copy_loop",
+    "_array_copy_rest:",
+    "    blez $a2, _array_copy_end",
+    "    lw   $t8, 0($a1)",
+    "    sw   $t8, 0($a0)",
+    "    addiu $a0, $a0, 4",
+    "    addiu $a1, $a1, 4",
+    "    addiu $a2, $a2, -1",
+    "    j    _array_copy_rest",
+    "_array_copy_end:",
+    "    jr   $ra",
+    NULL
+};
+
+void _genRuntimeLines(FILE* targetFile, const char** lines){
+    for(; *lines; lines++)
+        fprintf(targetFile, "%s\n", *lines);
+}
+
+void genRuntime(FILE* targetFile){
+    /* emit only the routines which are called by generated code */
+    if(GR.runtimeUsed & RUNTIME_OUTPUT)
+        _genRuntimeLines(targetFile, outputRuntime);
+    else
+        _genRuntimeLines(targetFile, flushStubRuntime);
+    if(GR.runtimeUsed & RUNTIME_INPUT)
+        _genRuntimeLines(targetFile, inputRuntime);
+    if(GR.runtimeUsed & RUNTIME_FILL)
+        _genRuntimeLines(targetFile, fillRuntime);
+    if(GR.runtimeUsed & RUNTIME_COPY)
+        _genRuntimeLines(targetFile, copyRuntime);
+}
@@ -0,0 +1,517 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "header.h"
+#include "codeGen.h"
+
+/*** Instruction Scheduling ***/
+/* inner function prototype */
+char* _readAsmFile(char* fileName, int* numOfLine);
+int _isLabelLine(char* line);
+int _isBlankLine(char* line);
+int _parseSchedInstr(char* line, SchedInstr* instr);
+const InstrFormat* _findInstrFormat(char* mnemonic, int numOfOperand);
+int _parseRegister(char* operand);
+int _parseAddress(char* operand, SchedInstr* instr);
+int _isImmOperand(char* operand);
+void _markResource(SchedInstr* instr, int resource, int isDouble, int isDef);
+int _mayAliasMemory(SchedInstr* instr1, SchedInstr* instr2);
+int _getDependLatency(SchedInstr* former, SchedInstr* latter);
+void _genSchedInstr(AsmScheduler* scheduler, SchedInstr* instr);
+void _genUnscheduledLine(AsmScheduler* scheduler, char* line);
+void _scheduleBlock(AsmScheduler* scheduler, SchedInstr* block, int numOfInstr);
+
+/* R2000/R3000 and R2010/R3010 result latencies */
+static const InstrFormat INSTR_FORMATS[] = {
+    {"add", "duu", 1, 0, 0}, {"addu", "duu", 1, 0, 0}, {"sub", "duu", 1, 0, 0}, {"subu", "duu", 1, 0, 0},
+    {"and", "duu", 1, 0, 0}, {"or", "duu", 1, 0, 0}, {"xor", "duu", 1, 0, 0}, {"nor", "duu", 1, 0, 0},
+    {"slt", "duu", 1, 0, 0}, {"sltu", "duu", 1, 0, 0},
+    {"sllv", "duu", 1, 0, 0}, {"srlv", "duu", 1, 0, 0}, {"srav", "duu", 1, 0, 0},
+    {"addi", "dui", 1, 0, 0}, {"addiu", "dui", 1, 0, 0}, {"andi", "dui", 1, 0, 0}, {"ori", "dui", 1, 0, 0},
+    {"xori", "dui", 1, 0, 0}, {"slti", "dui", 1, 0, 0}, {"sltiu", "dui", 1, 0, 0},
+    {"sll", "dui", 1, 0, 0}, {"srl", "dui", 1, 0, 0}, {"sra", "dui", 1, 0, 0},
+    {"lui", "di", 1, 0, 0}, {"move", "du", 1, 0, 0},
+    {"li", "di", 1, SCHED_PSEUDO, 0}, {"la", "dm", 1, SCHED_PSEUDO, 0},
+    {"neg", "du", 1, SCHED_PSEUDO, 0}, {"not", "du", 1, SCHED_PSEUDO, 0},
+    {"mul", "duu", 12, SCHED_PSEUDO | SCHED_DEF_HILO, 0},
+    {"movn", "buu", 1, 0, 0}, {"movz", "buu", 1, 0, 0},
+    {"movf", "bui", 1, SCHED_USE_FCC, 0}, {"movt", "bui", 1, SCHED_USE_FCC, 0},
+
+    {"mult", "uu", 12, SCHED_DEF_HILO, 0}, {"multu", "uu", 12, SCHED_DEF_HILO, 0},
+    {"div", "uu", 35, SCHED_DEF_HILO, 0}, {"divu", "uu", 35, SCHED_DEF_HILO, 0},
+    {"div", "duu", 35, SCHED_PSEUDO | SCHED_DEF_HILO, 0}, {"divu", "duu", 35, SCHED_PSEUDO | SCHED_DEF_HILO, 0},
+    {"mfhi", "d", 1, SCHED_USE_HI, 0}, {"mflo", "d", 1, SCHED_USE_LO, 0},
+
+    {"lw", "dm", 2, SCHED_LOAD, 4}, {"lb", "dm", 2, SCHED_LOAD, 1}, {"lbu", "dm", 2, SCHED_LOAD, 1},
+    {"lh", "dm", 2, SCHED_LOAD, 2}, {"lhu", "dm", 2, SCHED_LOAD, 2},
+    {"l.s", "dm", 2, SCHED_LOAD, 4}, {"lwc1", "dm", 2, SCHED_LOAD, 4},
+    {"l.d", "dm", 2, SCHED_LOAD | SCHED_DOUBLE, 8}, {"ldc1", "dm", 2, SCHED_LOAD | SCHED_DOUBLE, 8},
+    {"sw", "um", 1, SCHED_STORE, 4}, {"sb", "um", 1, SCHED_STORE, 1}, {"sh", "um", 1, SCHED_STORE, 2},
+    {"s.s", "um", 1, SCHED_STORE, 4}, {"swc1", "um", 1, SCHED_STORE, 4},
+    {"s.d", "um", 1, SCHED_STORE | SCHED_DOUBLE, 8}, {"sdc1", "um", 1, SCHED_STORE | SCHED_DOUBLE, 8},
+
+    {"mtc1", "ud", 2, 0, 0}, {"mfc1", "du", 2, 0, 0},
+    {"add.s", "duu", 2, 0, 0}, {"sub.s", "duu", 2, 0, 0}, {"mul.s", "duu", 4, 0, 0}, {"div.s", "duu", 12, 0, 0},
+    {"add.d", "duu", 2, SCHED_DOUBLE, 0}, {"sub.d", "duu", 2, SCHED_DOUBLE, 0},
+    {"mul.d", "duu", 5, SCHED_DOUBLE, 0}, {"div.d", "duu", 19, SCHED_DOUBLE, 0},
+    {"mov.s", "du", 1, 0, 0}, {"neg.s", "du", 1, 0, 0}, {"abs.s", "du", 1, 0, 0},
+    {"mov.d", "du", 1, SCHED_DOUBLE, 0}, {"neg.d", "du", 1, SCHED_DOUBLE, 0}, {"abs.d", "du", 1, SCHED_DOUBLE, 0},
+    {"cvt.s.w", "du", 3, 0, 0}, {"cvt.w.s", "du", 3, 0, 0}, {"trunc.w.s", "du", 3, 0, 0},
+    {"cvt.d.w", "du", 3, SCHED_DOUBLE, 0}, {"cvt.d.s", "du", 3, SCHED_DOUBLE, 0},
+    {"cvt.s.d", "du", 3, SCHED_DOUBLE, 0},
+    {"c.eq.s", "uu", 1, SCHED_DEF_FCC, 0}, {"c.lt.s", "uu", 1, SCHED_DEF_FCC, 0},
+    {"c.le.s", "uu", 1, SCHED_DEF_FCC, 0},
+    {"c.eq.d", "uu", 1, SCHED_DEF_FCC | SCHED_DOUBLE, 0}, {"c.lt.d", "uu", 1, SCHED_DEF_FCC | SCHED_DOUBLE, 0},
+    {"c.le.d", "uu", 1, SCHED_DEF_FCC | SCHED_DOUBLE, 0},
+    {"movn.s", "buu", 1, 0, 0}, {"movz.s", "buu", 1, 0, 0},
+    {"movf.s", "bui", 1, SCHED_USE_FCC, 0}, {"movt.s", "bui", 1, SCHED_USE_FCC, 0},
+    {"nop", "", 1, 0, 0},
+
+    {"beq", "uui", 1, SCHED_BRANCH, 0}, {"bne", "uui", 1, SCHED_BRANCH, 0},
+    {"blt", "uui", 1, SCHED_BRANCH, 0}, {"bgt", "uui", 1, SCHED_BRANCH, 0},
+    {"ble", "uui", 1, SCHED_BRANCH, 0}, {"bge", "uui", 1, SCHED_BRANCH, 0},
+    {"bltu", "uui", 1, SCHED_BRANCH, 0}, {"bgeu", "uui", 1, SCHED_BRANCH, 0},
+    {"beqz", "ui", 1, SCHED_BRANCH, 0}, {"bnez", "ui", 1, SCHED_BRANCH, 0},
+    {"bgez", "ui", 1, SCHED_BRANCH, 0}, {"bltz", "ui", 1, SCHED_BRANCH, 0},
+    {"bgtz", "ui", 1, SCHED_BRANCH, 0}, {"blez", "ui", 1, SCHED_BRANCH, 0},
+    {"bc1t", "i", 1, SCHED_BRANCH | SCHED_USE_FCC, 0}, {"bc1f", "i", 1, SCHED_BRANCH | SCHED_USE_FCC, 0},
+    {"j", "i", 1, SCHED_BRANCH, 0}, {"b", "i", 1, SCHED_BRANCH, 0}, {"jr", "u", 1, SCHED_BRANCH, 0},
+    {"jal", "i", 1, SCHED_BRANCH | SCHED_LINK, 0}, {"jalr", "u", 1, SCHED_BRANCH | SCHED_LINK, 0},
+    {"syscall", "", 1, SCHED_BARRIER, 0}
+};
+
+static const char* REG_NAMES[] = {
+    "zero", "at", "v0", "v1", "a0", "a1", "a2", "a3",
+    "t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7",
+    "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+    "t8", "t9", "k0", "k1", "gp", "sp", "fp", "ra"
+};
+
+void scheduleAsmFile(char* fileName, int isDelaySlot){
+    int numOfLine, i;
+    char* text = _readAsmFile(fileName, &numOfLine);
+    if(!text)
+        return;
+    char** lines = malloc(sizeof(char*) * (numOfLine + 1));
+    char* line = text;
+    for(i = 0; i < numOfLine; i++){
+        lines[i] = line;
+        line += strlen(line) + 1;
+    }
+
+    AsmScheduler scheduler;
+    scheduler.targetFile = fopen(fileName, "w");
+    scheduler.lines = lines;
+    scheduler.isDelaySlot = isDelaySlot;
+    scheduler.isLoadPending = 0;
+    SchedInstr block[MAX_SCHED_BLOCK];
+    int numOfInstr = 0, firstLine = 0, isText = 1;
+    for(i = 0; i < numOfLine; i++){
+        char* start = lines[i];
+        while(isspace((unsigned char)*start))
+            start++;
+        if(_isBlankLine(lines[i]))
+            continue; /* kept with the instruction after it */
+
+        SchedInstr* instr = &(block[numOfInstr]);
+        int isInstr = isText && !_isLabelLine(lines[i]) && *start != '.' && _parseSchedInstr(lines[i], instr);
+        if(isInstr && !(instr->format->flags & SCHED_BARRIER)){
+            instr->firstLine = firstLine;
+            instr->lastLine = i;
+            firstLine = i + 1;
+            numOfInstr++;
+            if((instr->format->flags & SCHED_BRANCH) || numOfInstr == MAX_SCHED_BLOCK){
+                _scheduleBlock(&scheduler, block, numOfInstr);
+                numOfInstr = 0;
+            }
+            continue;
+        }
+
+        /* label, directive or barrier stays in place */
+        _scheduleBlock(&scheduler, block, numOfInstr);
+        numOfInstr = 0;
+        for(; firstLine < i; firstLine++)
+            fprintf(scheduler.targetFile, "%s\n", lines[firstLine]);
+        firstLine = i + 1;
+        if(isText && *start != '.')
+            _genUnscheduledLine(&scheduler, lines[i]);
+        else
+            fprintf(scheduler.targetFile, "%s\n", lines[i]);
+        if(strncmp(start, ".data", 5) == 0)
+            isText = 0;
+        else if(strncmp(start, ".text", 5) == 0)
+            isText = 1;
+    }
+    _scheduleBlock(&scheduler, block, numOfInstr);
+    for(; firstLine < numOfLine; firstLine++)
+        fprintf(scheduler.targetFile, "%s\n", lines[firstLine]);
+
+    fclose(scheduler.targetFile);
+    free(lines);
+    free(text);
+}
+
+char* _readAsmFile(char* fileName, int* numOfLine){
+    /* whole file, each line terminated by '\0' instead of '\n' */
+    FILE* sourceFile = fopen(fileName, "r");
+    if(!sourceFile)
+        return NULL;
+    fseek(sourceFile, 0, SEEK_END);
+    long size = ftell(sourceFile);
+    fseek(sourceFile, 0, SEEK_SET);
+    char* text = malloc(size + 2);
+    size = fread(text, 1, size, sourceFile);
+    fclose(sourceFile);
+
+    if(size > 0 && text[size - 1] != '\n')
+        text[size++] = '\n';
+    text[size] = '\0';
+    long i;
+    *numOfLine = 0;
+    for(i = 0; i < size; i++){
+        if(text[i] == '\n'){
+            text[i] = '\0';
+            (*numOfLine)++;
+        }
+    }
+    return text;
+}
+
+int _isLabelLine(char* line){
+    /* identifier followed by ':' */
+    while(isspace((unsigned char)*line))
+        line++;
+    if(!isalpha((unsigned char)*line) && *line != '_' && *line != '.' && *line != '$')
+        return 0;
+    while(isalnum((unsigned char)*line) || *line == '_' || *line == '.' || *line == '$')
+        line++;
+    return *line == ':';
+}
+
+int _isBlankLine(char* line){
+    /* empty, or comment only */
+    while(isspace((unsigned char)*line))
+        line++;
+    return *line == '\0' || *line == '#';
+}
+
+int _parseSchedInstr(char* line, SchedInstr* instr){
+    /* return 0 if line isn't an instruction in INSTR_FORMATS */
+    char buffer[MAX_ASM_LINE];
+    char* operands[MAX_SCHED_OPERAND];
+    int numOfOperand = 0, i;
+    if(strlen(line) >= MAX_ASM_LINE)
+        return 0;
+    strcpy(buffer, line);
+    char* comment = strchr(buffer, '#');
+    if(comment)
+        *comment = '\0';
+
+    char* mnemonic = strtok(buffer, " \t");
+    if(!mnemonic)
+        return 0;
+    char* operand;
+    while((operand = strtok(NULL, ", \t"))){ /* SPIM takes operands without comma */
+        if(numOfOperand == MAX_SCHED_OPERAND)
+            return 0;
+        operands[numOfOperand++] = operand;
+    }
+    instr->format = _findInstrFormat(mnemonic, numOfOperand);
+    if(!instr->format)
+        return 0;
+
+    const InstrFormat* format = instr->format;
+    int isDouble = (format->flags & SCHED_DOUBLE) != 0;
+    memset(instr->isDef, 0, sizeof(instr->isDef));
+    memset(instr->isUse, 0, sizeof(instr->isUse));
+    instr->memBase = -1;
+    instr->memLabel[0] = '\0';
+    instr->memOffset = 0;
+    instr->isSlotSafe = !(format->flags & (SCHED_PSEUDO | SCHED_BRANCH));
+    for(i = 0; i < numOfOperand; i++){
+        char role = format->roles[i];
+        int regNum = _parseRegister(operands[i]);
+        if(role == 'm'){
+            if(!_parseAddress(operands[i], instr))
+                return 0;
+            if(instr->memLabel[0] != '\0')
+                instr->isSlotSafe = 0; /* assembler expands label address with $at */
+            if(instr->memBase != -1)
+                _markResource(instr, instr->memBase, 0, 0);
+        }
+        else if(regNum != -1){
+            if(role == 'd' || role == 'b')
+                _markResource(instr, regNum, isDouble, 1);
+            if(role == 'u' || role == 'b')
+                _markResource(instr, regNum, isDouble, 0);
+        }
+        else if(!_isImmOperand(operands[i]))
+            instr->isSlotSafe = 0;
+        else if(role != 'i')
+            instr->isSlotSafe = 0; /* immediate in register field, expanded by assembler */
+    }
+
+    if(format->flags & SCHED_DEF_HILO){
+        instr->isDef[HI_RESOURCE] = 1;
+        instr->isDef[LO_RESOURCE] = 1;
+    }
+    if(format->flags & SCHED_USE_HI)
+        instr->isUse[HI_RESOURCE] = 1;
+    if(format->flags & SCHED_USE_LO)
+        instr->isUse[LO_RESOURCE] = 1;
+    if(format->flags & SCHED_DEF_FCC)
+        instr->isDef[FCC_RESOURCE] = 1;
+    if(format->flags & SCHED_USE_FCC)
+        instr->isUse[FCC_RESOURCE] = 1;
+    if(format->flags & SCHED_LINK)
+        instr->isDef[31] = 1;
+    return 1;
+}
+
+const InstrFormat* _findInstrFormat(char* mnemonic, int numOfOperand){
+    unsigned int i;
+    for(i = 0; i < sizeof(INSTR_FORMATS) / sizeof(INSTR_FORMATS[0]); i++){
+        if(strcmp(INSTR_FORMATS[i].mnemonic, mnemonic) == 0 &&
+          (int)strlen(INSTR_FORMATS[i].roles) == numOfOperand)
+            return &(INSTR_FORMATS[i]);
+    }
+    return NULL;
+}
+
+int _parseRegister(char* operand){
+    /* resource number of $n, $fn or $name, -1 if operand isn't register */
+    int i;
+    if(operand[0] != '$')
+        return -1;
+    if(isdigit((unsigned char)operand[1])){
+        i = atoi(operand + 1);
+        return i < 32 ? i : -1;
+    }
+    if(operand[1] == 'f' && isdigit((unsigned char)operand[2])){
+        i = atoi(operand + 2);
+        return i < 32 ? FIRST_FP_RESOURCE + i : -1;
+    }
+    for(i = 0; i < 32; i++){
+        if(strcmp(operand + 1, REG_NAMES[i]) == 0)
+            return i;
+    }
+    if(strcmp(operand + 1, "s8") == 0)
+        return 30;
+    return -1;
+}
+
+int _parseAddress(char* operand, SchedInstr* instr){
+    /* offset($base), label, label+offset or label($base). return 0 if unknown form */
+    char buffer[MAX_ASM_LINE];
+    strcpy(buffer, operand);
+    char* paren = strchr(buffer, '(');
+    if(paren){
+        char* close = strchr(paren, ')');
+        if(!close)
+            return 0;
+        *close = '\0';
+        instr->memBase = _parseRegister(paren + 1);
+        if(instr->memBase == -1)
+            return 0;
+        *paren = '\0';
+    }
+
+    if(buffer[0] == '\0')
+        return 1;
+    if(_isImmOperand(buffer)){
+        instr->memOffset = atoi(buffer);
+        /* absolute address without base can't be told apart from others */
+        return instr->memBase != -1;
+    }
+    char* plus = strchr(buffer, '+');
+    if(plus){
+        if(!_isImmOperand(plus + 1))
+            return 0;
+        instr->memOffset = atoi(plus + 1);
+        *plus = '\0';
+    }
+    if(strlen(buffer) >= MAX_SCHED_LABEL)
+        return 0;
+    strcpy(instr->memLabel, buffer);
+    return 1;
+}
+
+int _isImmOperand(char* operand){
+    /* decimal fitting 16-bit field, signed or unsigned */
+    char* digit = operand;
+    if(*digit == '-' || *digit == '+')
+        digit++;
+    if(!isdigit((unsigned char)*digit))
+        return 0;
+    while(isdigit((unsigned char)*digit))
+        digit++;
+    if(*digit != '\0')
+        return 0;
+    long value = atol(operand);
+    return value >= -32768 && value <= 65535;
+}
+
+void _markResource(SchedInstr* instr, int resource, int isDouble, int isDef){
+    char* marks = isDef ? instr->isDef : instr->isUse;
+    if(resource == 0)
+        return; /* $0 is constant */
+    marks[resource] = 1;
+    if(isDouble && resource >= FIRST_FP_RESOURCE && resource + 1 < FIRST_FP_RESOURCE + 32)
+        marks[resource + 1] = 1;
+}
+
+int _mayAliasMemory(SchedInstr* instr1, SchedInstr* instr2){
+    /* same base register or same label, accessed bytes don't overlap, or distinct labels */
+    int isSameBase = instr1->memBase == instr2->memBase;
+    int isSameLabel = strcmp(instr1->memLabel, instr2->memLabel) == 0;
+    if(instr1->memLabel[0] != '\0' && instr2->memLabel[0] != '\0' && !isSameLabel)
+        return 0;
+    if(isSameBase && isSameLabel){
+        return instr1->memOffset < instr2->memOffset + instr2->format->memWidth &&
+          instr2->memOffset < instr1->memOffset + instr1->format->memWidth;
+    }
+    return 1;
+}
+
+int _getDependLatency(SchedInstr* former, SchedInstr* latter){
+    /* cycles from issue of former to issue of latter, -1 if they may be reordered */
+    int resource, latency = -1;
+    for(resource = 1; resource < NUM_OF_RESOURCE; resource++){
+        if(former->isDef[resource] && latter->isUse[resource]){
+            if(former->format->latency > latency)
+                latency = former->format->latency;
+        }
+        else if((former->isUse[resource] || former->isDef[resource]) && latter->isDef[resource]){
+            if(latency < 1)
+                latency = 1;
+        }
+    }
+
+    int flags1 = former->format->flags, flags2 = latter->format->flags;
+    if(((flags1 & SCHED_STORE) && (flags2 & (SCHED_LOAD | SCHED_STORE))) ||
+      ((flags1 & SCHED_LOAD) && (flags2 & SCHED_STORE))){
+        if(latency < 1 && _mayAliasMemory(former, latter))
+            latency = 1;
+    }
+    return latency;
+}
+
+void _genSchedInstr(AsmScheduler* scheduler, SchedInstr* instr){
+    int i;
+    if(scheduler->isDelaySlot && scheduler->isLoadPending){
+        for(i = 0; i < NUM_OF_RESOURCE; i++){
+            if(scheduler->loadDef[i] && instr->isUse[i]){
+                fprintf(scheduler->targetFile, "nop\n");
+                break;
+            }
+        }
+    }
+    for(i = instr->firstLine; i <= instr->lastLine; i++)
+        fprintf(scheduler->targetFile, "%s\n", scheduler->lines[i]);
+
+    scheduler->isLoadPending = (instr->format->flags & SCHED_LOAD) != 0;
+    if(scheduler->isLoadPending)
+        memcpy(scheduler->loadDef, instr->isDef, sizeof(instr->isDef));
+}
+
+void _genUnscheduledLine(AsmScheduler* scheduler, char* line){
+    /* label or instruction of .text not moved, "label: instr" included */
+    SchedInstr instr;
+    char* code = line;
+    if(_isLabelLine(line)){
+        code = strchr(line, ':') + 1;
+        if(_isBlankLine(code)){
+            fprintf(scheduler->targetFile, "%s\n", line);
+            return;
+        }
+    }
+
+    if(scheduler->isDelaySlot && scheduler->isLoadPending)
+        fprintf(scheduler->targetFile, "nop\n");
+    fprintf(scheduler->targetFile, "%s\n", line);
+    scheduler->isLoadPending = 0;
+    if(scheduler->isDelaySlot && _parseSchedInstr(code, &instr) && (instr.format->flags & SCHED_BRANCH))
+        fprintf(scheduler->targetFile, "nop\n");
+}
+
+void _scheduleBlock(AsmScheduler* scheduler, SchedInstr* block, int numOfInstr){
+    /* list scheduling, among instructions whose operands are ready the one on the longest
+     * latency path to block end goes first, otherwise the one ready soonest.
+     * branch ends block, its delay slot takes instruction nothing after depends on */
+    int latency[MAX_SCHED_BLOCK][MAX_SCHED_BLOCK];
+    int priority[MAX_SCHED_BLOCK], issue[MAX_SCHED_BLOCK], order[MAX_SCHED_BLOCK];
+    int isScheduled[MAX_SCHED_BLOCK];
+    int i, j, k;
+    if(numOfInstr == 0)
+        return;
+
+    for(i = 0; i < numOfInstr; i++){
+        for(j = i + 1; j < numOfInstr; j++)
+            latency[i][j] = _getDependLatency(&(block[i]), &(block[j]));
+    }
+    for(i = numOfInstr - 1; i >= 0; i--){
+        priority[i] = block[i].format->latency;
+        for(j = i + 1; j < numOfInstr; j++){
+            if(latency[i][j] >= 0 && latency[i][j] + priority[j] > priority[i])
+                priority[i] = latency[i][j] + priority[j];
+        }
+        isScheduled[i] = 0;
+    }
+
+    int hasBranch = (block[numOfInstr - 1].format->flags & SCHED_BRANCH) != 0;
+    int numOfBody = hasBranch ? numOfInstr - 1 : numOfInstr;
+    int cycle = 0;
+    for(k = 0; k < numOfBody; k++){
+        int best = -1, bestReady = 0;
+        for(i = 0; i < numOfBody; i++){
+            int ready = cycle, isFree = 1;
+            if(isScheduled[i])
+                continue;
+            for(j = 0; j < i && isFree; j++){
+                if(latency[j][i] < 0)
+                    continue;
+                if(!isScheduled[j])
+                    isFree = 0;
+                else if(issue[j] + latency[j][i] > ready)
+                    ready = issue[j] + latency[j][i];
+            }
+            if(!isFree)
+                continue;
+            if(best == -1 || ready < bestReady || (ready == bestReady && priority[i] > priority[best])){
+                best = i;
+                bestReady = ready;
+            }
+        }
+        isScheduled[best] = 1;
+        issue[best] = bestReady;
+        order[k] = best;
+        cycle = bestReady + 1;
+    }
+
+    int slot = -1;
+    if(hasBranch && scheduler->isDelaySlot){
+        for(k = numOfBody - 1; k >= 0 && slot == -1; k--){
+            /* load in slot would leave its delay to unknown branch target */
+            int isFree = block[order[k]].isSlotSafe && !(block[order[k]].format->flags & SCHED_LOAD);
+            for(j = order[k] + 1; j < numOfInstr && isFree; j++){
+                if(latency[order[k]][j] >= 0)
+                    isFree = 0;
+            }
+            if(isFree)
+                slot = order[k];
+        }
+    }
+
+    for(k = 0; k < numOfBody; k++){
+        if(order[k] != slot)
+            _genSchedInstr(scheduler, &(block[order[k]]));
+    }
+    if(hasBranch){
+        _genSchedInstr(scheduler, &(block[numOfInstr - 1]));
+        if(slot != -1)
+            _genSchedInstr(scheduler, &(block[slot]));
+        else if(scheduler->isDelaySlot)
+            fprintf(scheduler->targetFile, "nop\n");
+    }
+}
@@ -815,7 +815,8 @@ DATA_TYPE getTypeOfExpr(STT* symbolTable, AST_NODE* exprNode){
         else if(opKind == BINARY_OPERATION ){
             BINARY_OPERATOR op = exprNode->semantic_value.exprSemanticValue.op.binaryOp;
             if(op == BINARY_OP_EQ || op == BINARY_OP_GE || op == BINARY_OP_LE ||
-              op == BINARY_OP_NE || op == BINARY_OP_GT || op == BINARY_OP_LT){
+              op == BINARY_OP_NE || op == BINARY_OP_GT || op == BINARY_OP_LT ||
+              op == BINARY_OP_AND || op == BINARY_OP_OR){
                 return INT_TYPE;
             }
             DATA_TYPE child1type = getTypeOfExpr(symbolTable, child);
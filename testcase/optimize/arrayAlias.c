@@ -0,0 +1,78 @@
+int ga[8], gb[8];
+float gw[4];
+
+int twice(int n){
+    return n + n;
+}
+
+void fill(int a[], int v){
+    int i;
+    for(i = 0; i < 8; i = i + 1)
+        a[i] = v + i;
+}
+
+int copy(int dst[], int src[]){
+    int i, t[8];
+    for(i = 0; i < 8; i = i + 1){
+        t[i] = src[i];
+        dst[i] = t[i] + dst[i];
+    }
+    return dst[7] + src[7];
+}
+
+int forward(int a[], int b[]){
+    return copy(a, b);
+}
+
+int count(int a[], int n){
+    int i;
+    for(i = 0; i < n; i = i + 1)
+        a[0] = a[0] + a[i + 1];
+    return a[0];
+}
+
+void relax(float w[], int n){
+    int i;
+    for(i = 0; i < n; i = i + 1){
+        w[1] = w[1] * 0.5 + w[0];
+        w[2] = w[1] + w[2];
+    }
+}
+
+int main(){
+    int i, x, y, la[8];
+
+    fill(ga, 1);
+    fill(gb, 10);
+    for(i = 0; i < 8; i = i + 1)
+        la[i] = i * i;
+    x = forward(ga, gb);
+    y = copy(la, la);
+    write(x); write(" "); write(y); write(" "); write(ga[3]); write(" "); write(la[5]); write("\n");
+
+    ga[2] = 5;
+    ga[3] = ga[2] + 1;
+    ga[2] = ga[3] * 2;
+    gb[2] = ga[2] + twice(ga[4]);
+    gb[2] = gb[2] + twice(gb[1]);
+    gb[5] = 100;
+    ga[6] = gb[6] + ga[5];
+    gb[5] = ga[6] - gb[2];
+    write(ga[2]); write(" "); write(ga[3]); write(" "); write(gb[2]); write(" "); write(gb[5]); write("\n");
+
+    for(i = 0; i < 6; i = i + 1){
+        la[1] = la[1] + i;
+        la[2] = la[2] * 2 + la[1];
+        x = x + ga[5];
+    }
+    write(la[1]); write(" "); write(la[2]); write(" "); write(x); write("\n");
+
+    write(count(gb, 4)); write(" "); write(count(la, 7)); write("\n");
+
+    gw[0] = 1.0;
+    gw[1] = 2.0;
+    gw[2] = 0.25;
+    relax(gw, 5);
+    write(gw[1]); write(" "); write(gw[2]); write("\n");
+    return 0;
+}
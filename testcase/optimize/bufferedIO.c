@@ -0,0 +1,35 @@
+float scale(float x, int n){
+    int i;
+    for(i = 0; i < n; i = i + 1){
+        x = x * 0.1;
+    }
+    return x;
+}
+int main(){
+    int n, i, sum;
+    float f, total;
+    write("n? ");
+    n = read();
+    sum = 0;
+    total = 0.0;
+    for(i = 0; i < n; i = i + 1){
+        write("int and float? ");
+        sum = sum + read();
+        f = fread();
+        total = total + f;
+        write(f);
+        write("\n");
+    }
+    write(sum);
+    write("\n");
+    write(total);
+    write("\n");
+    f = -2.5;
+    for(i = 0; i < 12; i = i + 1){
+        write(scale(f, i));
+        write(" ");
+        f = f * -3.0;
+    }
+    write("\n");
+    return 0;
+}
@@ -0,0 +1,17 @@
+float pi = 3.14159265;
+int big = 123456789;
+int main(){
+    int i, k;
+    float s, t = 0.1;
+    s = 0.0;
+    k = 0;
+    for(i = 0; i < 10; i = i + 1){
+        s = s * 0.5 + 1.25;
+        k = k + 100000;
+    }
+    write(s); write("\n");
+    write(k); write("\n");
+    write(pi); write(" "); write(3.14159265); write(" "); write(t * 0.1); write("\n");
+    write(big); write(" "); write(-123456789); write(" "); write(65536); write(" "); write(65535); write("\n");
+    return 0;
+}
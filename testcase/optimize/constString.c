@@ -0,0 +1,22 @@
+void log(int level){
+    if(level > 1)
+        write("error: disk full\n");
+    else
+        write("warning: disk full\n");
+    write("disk full\n");
+    write("full\n");
+}
+int main(){
+    int i;
+    for(i = 0; i < 3; i = i + 1){
+        log(i);
+        write("\n");
+        write("");
+        write("i = ");
+        write(i);
+        write("\n");
+    }
+    write("error: disk full\n");
+    write("a\\n");
+    return 0;
+}
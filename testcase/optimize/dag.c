@@ -0,0 +1,27 @@
+int a[10][10];
+int g;
+float fx, fy;
+int f(int x){ g = g + x; return g; }
+int main(){
+    int i, j, x, y, s, t;
+    float p, q, r;
+    i = 3; j = 4; x = 5; y = 6; g = 2;
+    a[i * 2 + 1][j - 1] = 9;
+    s = (x * y + i) * (x * y + i) + a[i * 2 + 1][j - 1] + a[i * 2 + 1][j - 1];
+    t = x * y + i;
+    x = x + 1;
+    t = t + (x * y + i) + (g * y) + f(1) + (g * y);
+    write(s); write(" "); write(t); write("\n");
+    p = 1.5; q = 2.5;
+    r = (p * q - p) / (p * q - p + 1.0);
+    fx = p * q; fy = p * q;
+    write(r); write(" "); write(fx + fy); write("\n");
+    s = 0;
+    for(i = 0; i < 10; i = i + 1)
+        for(j = 0; j < 10; j = j + 1){
+            a[i][j] = i * j + (i - j) * (i - j);
+            s = s + a[i][j] + i * j;
+        }
+    write(s); write(" "); write(a[7][3]); write("\n");
+    return 0;
+}
@@ -0,0 +1,70 @@
+int counter;
+
+int tick(int n){
+    counter = counter + n;
+    return counter;
+}
+
+int fact(int n){
+    int unused = 7;
+    int r;
+    r = 1;
+    if(n > 1)
+        r = n * fact(n - 1);
+    return r;
+}
+
+float scale(float x, int k){
+    float y = 0.5;
+    y = x * k;
+    x = 1.0;
+    return y + x;
+}
+
+int sum(int a[], int n){
+    int i, s, t = 3;
+    s = 0;
+    t = 4;
+    for(i = 0, t = 5; i < n; i = i + 1){
+        s = s + a[i];
+        t = i;
+    }
+    return s;
+}
+
+int main(){
+    int a, b, c, d, e, f, g, h, i, j, k;
+    float x = 1.5, y, z;
+    int arr[10];
+
+    a = 1; b = 2; c = 3; d = 4; e = 5; f = 6; g = 7; h = 8; i = 9; j = 10; k = 11;
+    a = tick(1);
+    b = tick(2);
+    c = 100;
+    for(j = 0; j < 10; j = j + 1){
+        arr[j] = j * j;
+        h = h + j;
+        c = j;
+    }
+    write(a); write(" "); write(b); write(" "); write(h); write("\n");
+    write(sum(arr, 10)); write(" "); write(fact(6)); write("\n");
+
+    {
+        int a = 40;
+        float x = 2.5;
+        a = a + 2;
+        write(a); write(" "); write(x); write("\n");
+    }
+
+    y = scale(x, 3);
+    z = y;
+    y = 0.0;
+    write(z); write(" "); write(counter); write("\n");
+
+    i = 0;
+    while(k = 8 - i * 2){
+        i = i + 1;
+    }
+    write(i); write(" "); write(k); write(" "); write(d + e + f + g); write("\n");
+    return 0;
+}
@@ -0,0 +1,68 @@
+int code[32];
+int acc;
+
+int step(int op, int arg){
+    if(op == 0) acc = acc + arg;
+    else if(op == 1) acc = acc - arg;
+    else if(op == 2) acc = acc * arg;
+    else if(op == 3){
+        int t;
+        t = acc / 2;
+        acc = t + arg;
+    }
+    else if(op == 5) acc = -acc;
+    else if(op == 6) return 0;
+    else acc = acc + 1000;
+    return 1;
+}
+
+int sparse(int key){
+    int r;
+    r = 0;
+    if(key == 100) r = 1;
+    else if(-7 == key) r = 2;
+    else if(key == 4096) r = 3;
+    else if(key == 0) r = 4;
+    else if(key == 70000) r = 5;
+    else if(key == -40000) r = 6;
+    else if(key == 33) r = 7;
+    return r;
+}
+
+float scale(int k, float x){
+    if(k + 1 == 11) x = x * 2.0;
+    else if(k + 1 == 12) x = x * 3.0;
+    else if(k + 1 == 13) x = x + 0.5;
+    else if(11 + 3 == k + 1){
+        if(x > 1.0) x = 1.0;
+    }
+    return x;
+}
+
+int main(){
+    int i, s, pc;
+
+    for(i = 0; i < 32; i = i + 1)
+        code[i] = (i * 5 + 3) - (i * 5 + 3) / 8 * 8;
+    acc = 1;
+    pc = 0;
+    while(pc < 32 && step(code[pc], pc)){
+        pc = pc + 1;
+    }
+    write(acc); write(" "); write(pc); write("\n");
+    write(step(-3, 1)); write(" "); write(step(9, 1)); write(" "); write(acc); write("\n");
+
+    s = 0;
+    for(i = -8; i < 110; i = i + 1){
+        s = s * 2 + sparse(i) - s / 3;
+        s = s - s / 10007 * 10007;
+    }
+    write(s); write(" ");
+    write(sparse(4096) + sparse(70000) * 10 + sparse(-40000) * 100 + sparse(65536 + 4464)); write("\n");
+
+    for(i = 8; i < 16; i = i + 1){
+        write(scale(i, 0.75)); write(" ");
+    }
+    write("\n");
+    return 0;
+}
@@ -0,0 +1,15 @@
+float v[6];
+int main(){
+    int i, j, s;
+    v[0] = 1.5; v[1] = 0.0 - 2.0; v[2] = 1.5; v[3] = 3.25; v[4] = 0.0; v[5] = 0.0 - 0.0;
+    s = 0;
+    for(i = 0; i < 6; i = i + 1)
+        for(j = 0; j < 6; j = j + 1){
+            s = s * 3 + (v[i] < v[j]) + (v[i] > v[j]) * 2 + (v[i] == v[j]) * 5;
+            s = s - (v[i] != v[j]) + (v[i] <= v[j]) * 7 - (v[i] >= v[j]) * 11;
+            if(v[i] < v[j]) s = s + 1;
+            s = s - s / 1000 * 1000;
+        }
+    write(s); write("\n");
+    return 0;
+}
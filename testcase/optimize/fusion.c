@@ -0,0 +1,52 @@
+float v[50], w[50];
+int a[50], b[50];
+
+void normalize(float u[], float norm, float scale, int n){
+    int i;
+    for(i = 0; i < n; i = i + 1)
+        u[i] = u[i] / norm;
+    for(i = 0; i < n; i = i + 1)
+        u[i] = u[i] * scale;
+}
+
+int shift(int x[], int y[], int n){
+    int i, t, s;
+    s = 0;
+    for(i = 1; i < n; i = i + 1){
+        t = x[i] + 1;
+        y[i] = t;
+    }
+    for(i = 1; i < n; i = i + 1){
+        t = y[i - 1] * 2;
+        x[i] = t - x[i];
+        s = s + t;
+    }
+    return s + t;
+}
+
+int main(){
+    int i, n;
+
+    n = 50;
+    for(i = 0; i < n; i = i + 1){
+        v[i] = i;
+        w[i] = 50 - i;
+    }
+    for(i = 0; i < n; i = i + 1)
+        a[i] = i * 3;
+    for(i = 0; i < n; i = i + 1)
+        b[i] = a[i] + a[49 - i];
+    normalize(v, 10.0, 4.0, n);
+    normalize(w, 5.0, 0.5, 20);
+    write(v[49]); write(" "); write(w[3]); write(" "); write(w[30]); write("\n");
+
+    for(i = 0; i < 49; i = i + 1)
+        a[i] = b[i] + 1;
+    for(i = 0; i < 49; i = i + 1)
+        b[i] = a[i + 1];
+    write(a[10]); write(" "); write(b[10]); write(" "); write(b[48]); write(" "); write(i); write("\n");
+
+    write(shift(a, b, 40)); write(" "); write(a[7]); write(" "); write(b[39]); write("\n");
+    write(shift(b, b, 12)); write(" "); write(b[11]); write("\n");
+    return 0;
+}
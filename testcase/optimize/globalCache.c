@@ -0,0 +1,65 @@
+int count, total, limit = 10;
+float acc;
+int hist[4];
+
+int peek(){
+    return total;
+}
+
+void bump(){
+    count = count + 1;
+}
+
+int square(int n){
+    return n * n;
+}
+
+int find(int key){
+    int i;
+    for(i = 0; i < limit; i = i + 1){
+        total = total + i;
+        if(i == key)
+            return i;
+    }
+    return -1;
+}
+
+int depth(int n){
+    int r;
+    r = 0;
+    while(n > 0){
+        total = total + 1;
+        r = r + depth(n - 1);
+        n = n - 1;
+    }
+    return r + 1;
+}
+
+int main(){
+    int i, s;
+
+    count = 0;
+    total = 0;
+    acc = 0.5;
+    for(i = 0; i < limit; i = i + 1){
+        total = total + square(i);
+        acc = acc * 1.5;
+        hist[i / 3] = hist[i / 3] + 1;
+    }
+    write(total); write(" "); write(acc); write("\n");
+
+    s = 0;
+    i = 0;
+    while(i < limit){
+        total = total + i;
+        s = s + peek();
+        bump();
+        i = i + 1;
+    }
+    write(s); write(" "); write(count); write(" "); write(total); write("\n");
+
+    write(find(4)); write(" "); write(total); write("\n");
+    write(depth(3)); write(" "); write(total); write("\n");
+    write(hist[0]); write(" "); write(hist[3]); write("\n");
+    return 0;
+}
@@ -0,0 +1,66 @@
+int g[64];
+float h[40];
+int m[12][10];
+
+int sum(int a[], int n){
+    int i, s;
+    s = 0;
+    for(i = 0; i < n; i = i + 1)
+        s = s + a[i];
+    return s;
+}
+
+void shift(int a[], int n){
+    int i;
+    for(i = 0; i < n - 1; i = i + 1)
+        a[i] = a[i + 1];
+}
+
+int main(){
+    int i, j, n, s, b[64];
+    float x;
+
+    for(i = 0; i < 64; i = i + 1)
+        g[i] = 7;
+    for(i = 0; i < 64; i = i + 1)
+        b[i] = g[i];
+    write(sum(b, 64)); write(" "); write(i); write("\n");
+
+    for(i = 0; i < 64; i = i + 1)
+        g[i] = i;
+    for(i = 0; i < 63; i = i + 1)
+        g[i + 1] = g[i];
+    write(sum(g, 64)); write(" ");
+    shift(b, 64);
+    n = 30;
+    for(i = 5; i <= n; i = i + 1)
+        b[i] = b[i - 5];
+    write(sum(b, 64)); write(" "); write(i); write("\n");
+
+    x = 1.5;
+    for(i = 3; i < 40; i = i + 1)
+        h[i] = x;
+    for(i = 0; i < 3; i = i + 1)
+        h[i] = 2;
+    write(h[0] + h[39]); write("\n");
+
+    for(i = 0; i < 12; i = i + 1)
+        for(j = 0; j < 10; j = j + 1)
+            m[i][j] = 3;
+    for(i = 2; i < 5; i = i + 1)
+        for(j = 0; j < 10; j = j + 1)
+            m[i + 1][j] = 0;
+    s = 0;
+    for(i = 0; i < 12; i = i + 1)
+        s = s + sum(m[i], 10);
+    write(s); write(" "); write(i); write(" "); write(j); write("\n");
+
+    n = 0;
+    for(i = 0; i < n; i = i + 1)
+        g[i] = 1;
+    s = 0;
+    for(i = 0; i < 100; i = i + 1)
+        s = s + i - 3;
+    write(s); write(" "); write(i); write(" "); write(sum(g, 64)); write("\n");
+    return 0;
+}
@@ -0,0 +1,30 @@
+int a[20];
+
+int clamp(int x){
+    if(x < 0 - 100)
+        return 0 - 100;
+    if(100 <= x)
+        return 100;
+    return x;
+}
+
+int main(){
+    int i, n, s, t;
+
+    n = 0;
+    s = 0;
+    for(i = 0; i < 20; i = i + 1){
+        a[i] = i * 37 - 300;
+        t = a[i] + 1000 - 50;
+        s = s + (a[i] > 0) + (a[i] >= 70) * 2 + (5 == i) * 4 + (a[i] != 0 - 4) + (32767 > a[i]);
+        if(t - 40000 == 0 - 39054 || a[i] <= 0 - 32768)
+            n = n + 1;
+    }
+    write(s); write(" "); write(n); write("\n");
+
+    s = 0;
+    for(i = 0 - 300; i <= 300; i = i + 25)
+        s = s + clamp(i) + (i == 65535) + (i != 70000);
+    write(s); write(" "); write(i - 65535); write(" "); write(1 + i); write("\n");
+    return 0;
+}
@@ -0,0 +1,58 @@
+int cnt;
+float fg;
+int g0, g1;
+int ga[16], gb[16];
+
+int bump(int r){
+    cnt = cnt + 1;
+    return r;
+}
+
+float half(float x){
+    cnt = cnt + 10;
+    return x / 2.0;
+}
+
+int main(){
+    int a, b, c, r;
+    float x, y;
+    int la[16];
+
+    a = 3; b = 0; c = -2;
+    x = 0.0; y = 2.5;
+    cnt = 0;
+
+    r = a && b;
+    write(r); write(" ");
+    r = a || b;
+    write(r); write(" ");
+    r = (a > 2) + (b && bump(1)) * 10 + (a || bump(1)) * 100;
+    write(r); write(" "); write(cnt); write("\n");
+
+    r = b && bump(1) || c && bump(5);
+    write(r); write(" "); write(cnt); write(" ");
+    r = a * 7 + (c < 0 && (b || bump(0) || a - 3 || c)) - (a && !c);
+    write(r); write(" "); write(cnt); write("\n");
+
+    r = x && y;
+    write(r); write(" ");
+    r = x || y;
+    write(r); write(" ");
+    fg = -0.0;
+    r = fg || x;
+    write(r); write(" ");
+    r = y && half(y) > 1.0;
+    write(r); write(" "); write(cnt); write(" ");
+    y = y * 2.0 + (x || half(y));
+    write(y); write(" "); write(cnt); write("\n");
+
+    if(x || fg) write("yes\n"); else write("no\n");
+    while(y){ y = y - 1.0; r = r + 1; }
+    write(r); write("\n");
+
+    la[12] = 0; ga[13] = 4; gb[2] = 5; gb[3] = 6; g1 = -1;
+    a = 1;
+    g0 = ((gb[2] + a - (ga[13] && 2)) * (la[12] || ga[15] >= g1)) + ((gb[3] + a - (ga[13] && 2)) * (la[12] || ga[15] >= g1));
+    write(g0); write("\n");
+    return 0;
+}
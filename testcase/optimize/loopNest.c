@@ -0,0 +1,50 @@
+int a[24][24], b[24][24];
+int ma[96][96], mb[96][96];
+
+int sweep(int n){
+    int i, j, s;
+    s = 0;
+    for(j = 0; j < n; j = j + 1)
+        for(i = 1; i < n; i = i + 1){
+            a[i][j] = a[i - 1][j] + i * j;
+            s = s + a[i][j];
+        }
+    return s;
+}
+
+int skew(){
+    int i, j;
+    for(i = 1; i < 24; i = i + 1)
+        for(j = 0; j < 23; j = j + 1)
+            b[j][i] = b[j + 1][i - 1] + 1;
+    return b[0][23] + b[5][10];
+}
+
+int main(){
+    int i, j, t, s;
+
+    for(i = 0; i < 24; i = i + 1)
+        for(j = 0; j < 24; j = j + 1){
+            a[i][j] = 0;
+            b[j][i] = i - j;
+        }
+    write(sweep(24)); write(" "); write(a[23][23]); write(" "); write(sweep(5)); write("\n");
+    write(skew()); write(" "); write(b[22][1]); write("\n");
+
+    for(i = 0; i < 96; i = i + 1)
+        for(j = 0; j < 96; j = j + 1)
+            ma[i][j] = i * 100 + j;
+    for(i = 0; i < 96; i = i + 1)
+        for(j = 0; j < 96; j = j + 1){
+            t = ma[j][i] * 2;
+            mb[i][j] = t + 1;
+        }
+    write(mb[3][90]); write(" "); write(mb[95][0]); write(" "); write(i); write(" "); write(j); write("\n");
+
+    s = 0;
+    for(j = 0; j < 96; j = j + 1)
+        for(i = 0; i < 96; i = i + 1)
+            s = s + mb[i][j] - ma[j][i];
+    write(s); write("\n");
+    return 0;
+}
@@ -0,0 +1,59 @@
+int a[40], m[8][5];
+
+int scale(int x, int k){
+    if(k > 10)
+        return x * 100;
+    if(k >= 2)
+        return x * k / 2;
+    return x / k;
+}
+
+int bucket(int n){
+    int i, s;
+    s = 0;
+    for(i = 0; i < n; i = i + 1){
+        a[i] = i / 4 + i / 3;
+        if(i < 0)
+            s = s - 1000;
+        if(i >= 0 && i < 40)
+            s = s + a[i];
+        else
+            s = s + 7;
+    }
+    return s;
+}
+
+int prefix(int b[4], int n){
+    int i, s;
+    s = 0;
+    for(i = 0; i < n; i = i + 1){
+        b[i] = i;
+        if(i < 4)
+            s = s + 1;
+        else
+            s = s + 10;
+    }
+    return s;
+}
+
+int main(){
+    int i, j, s, t;
+
+    s = 0;
+    for(i = 0; i < 8; i = i + 1){
+        for(j = 0; j < 5; j = j + 1){
+            m[i][j] = i * 5 + j;
+            if(j < 5 && i <= 7)
+                s = s + m[i][j] / 8;
+            if(i * 5 + j > 39)
+                s = s + 1000;
+        }
+    }
+    write(s); write(" "); write(bucket(40)); write(" "); write(bucket(12)); write(" "); write(prefix(a, 12)); write("\n");
+
+    t = 0;
+    for(i = -6; i <= 6; i = i + 1)
+        t = t + i / 4 * 10 + (i < 7) + (i > -7) + scale(i, 3) + scale(i, 2);
+    write(t); write(" "); write(scale(-9, 2)); write(" "); write(scale(15, 3)); write("\n");
+    return 0;
+}
@@ -0,0 +1,34 @@
+int g[20];
+int calls;
+
+int next(int x){
+    calls = calls + 1;
+    return x + 1;
+}
+
+float blend(float a, float b, float c){
+    return a * 2 + 1.5 + b * 1 + 2.5 - c - 0 + a * 4 * 0.25;
+}
+
+int main(){
+    int x, y, z, w, i;
+    float p, q;
+
+    x = 7; y = 3; z = 11; w = -5;
+    write(x + 1 + y + 2); write(" ");
+    write(x * 1 + 0 - (y - y) + !(!x) + !(!(y - 3))); write(" ");
+    write(!(x < y) + !(x == 7) * 10 + -(-z) + (1 + w - 1)); write(" ");
+    write(2 * x * 3 + z * 0 + next(x) * 0 + (0 - x) + x * -1 + 5 - x); write(" ");
+    write(x + y + z + w + 1 - x + y * 2 - z + w); write(" ");
+    write(next(1) + 3 + next(2) - next(3) + 4); write(" "); write(calls); write("\n");
+
+    for(i = 0; i < 10; i = 1 + i)
+        g[2 + i + 1] = i * 2 * 2 + 1 - 1;
+    write(g[3] + g[12] + i); write("\n");
+
+    p = 1.0; q = 3.0;
+    write(blend(p, q, 0.5)); write(" "); write(p * 1 - 0 + q / 1 + 0.1 + 0.2 + 0.3); write(" ");
+    write(p + 1 + x + y); write(" "); write(!(p < q) + !(p > q) * 2); write("\n");
+    write(x * 2147483647 * 3 + 2147483647 + 2147483647); write("\n");
+    return 0;
+}
@@ -0,0 +1,30 @@
+int g[8];
+float h[4];
+
+float half(float v){
+    float t;
+    t = v * 0.5;
+    return t;
+}
+
+int main(){
+    int a, b, c, d, s;
+    float x, y;
+
+    a = 3; b = 5; c = 7; d = 2;
+    g[0] = 1; g[1] = 4; g[2] = 9; g[3] = 16; g[4] = 25; g[5] = 36; g[6] = 49; g[7] = 64;
+    s = a + (b - (c + (d - (g[a] + (g[b] - (g[c] + (g[d] - (a * b + (c - d * (g[1] + g[2] * (g[3] - g[4])))))))))));
+    write(s); write(" ");
+    s = ((g[0] + g[1]) * (g[2] - g[3])) - ((g[4] + g[5]) * (g[6] - g[7])) + ((a + b) * (c + d) - (a - b) * (c - d));
+    write(s); write(" ");
+    s = (a < (b + (c < (d + (g[a] < (g[b] + (g[c] < g[d]))))))) + (g[a + 1] - g[b - 1] * (g[c - d] + g[d * 2 - a]));
+    write(s); write("\n");
+
+    x = 1.5; y = 2.25;
+    h[0] = 0.5; h[1] = 1.25; h[2] = 2.0; h[3] = 4.0;
+    x = x + (y - (h[0] + (h[1] - (h[2] + (h[3] - half(x + y * (h[1] - h[0]))))))) + half(y);
+    write(x); write(" ");
+    x = (x * 2.0 + y) * (h[a] - h[d]) - half(h[1] * h[2] + half(h[3]));
+    write(x); write("\n");
+    return 0;
+}
@@ -0,0 +1,45 @@
+int a[16], b[16];
+float fa[8];
+int g, h;
+int mix(int x, int y){
+    int p, q;
+    p = a[x] + b[y];
+    q = a[y] * b[x];
+    a[x] = q - p;
+    b[y] = p / (y + 1);
+    return a[x] + b[y] + g;
+}
+float scale(float v, int n){
+    float s;
+    int i;
+    s = 0.0;
+    for(i = 0; i < n; i = i + 1){
+        fa[i] = v * i + fa[i] / 2.0;
+        s = s + fa[i] * fa[i];
+    }
+    return s;
+}
+int main(){
+    int i, s, t;
+    for(i = 0; i < 16; i = i + 1){
+        a[i] = i * 3 - 7;
+        b[i] = 20 - i;
+    }
+    g = 5; h = 0;
+    s = 0;
+    for(i = 1; i < 15; i = i + 1){
+        t = a[i - 1] + a[i + 1];
+        h = h + t;
+        a[i] = t / 4 + b[i] * g;
+        s = s + mix(i, 15 - i);
+    }
+    write(s); write(" "); write(h); write(" "); write(a[7]); write(" "); write(b[3]); write("\n");
+    for(i = 0; i < 8; i = i + 1)
+        fa[i] = i + 0.5;
+    write(scale(1.5, 8)); write(" "); write(fa[5]); write("\n");
+    if(s > h && a[2] != b[2])
+        write("ordered\n");
+    else
+        write("unordered\n");
+    return 0;
+}
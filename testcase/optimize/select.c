@@ -0,0 +1,53 @@
+int g, a[20];
+float h, v[20];
+
+int classify(int x, int lo, int hi){
+    int c;
+    if(x < lo) c = -1; else c = 1;
+    if(x >= lo && x <= hi) c = 0;
+    if(x == hi) { c = c + 10; }
+    return c;
+}
+
+float clamp(float x, float lo, float hi){
+    float r;
+    r = x;
+    if(r < lo) r = lo;
+    if(r > hi) r = hi * 1;
+    if(r) h = r; else h = -1.5;
+    return r;
+}
+
+int main(){
+    int i, mx, cnt, s, t;
+    float f, fm;
+
+    for(i = 0; i < 20; i = i + 1){
+        a[i] = (i * 7) - (i / 3) * 20 + 3;
+        v[i] = a[i] / 4.0;
+    }
+    mx = a[0]; cnt = 0; fm = 0.0;
+    for(i = 0; i < 20; i = i + 1){
+        if(a[i] > mx) mx = a[i];
+        if(a[i] < 0) cnt = cnt + 1; else cnt = cnt - 1;
+        if(v[i] >= fm) fm = v[i];
+        if(a[i] - 4) g = g + a[i] / 2;
+    }
+    write(mx); write(" "); write(cnt); write(" "); write(fm); write(" "); write(g); write("\n");
+
+    s = 0;
+    for(i = -3; i < 13; i = i + 1)
+        s = s * 3 + classify(i, 0, 9);
+    write(s); write("\n");
+
+    write(clamp(3.5, 0.0, 2.0)); write(" "); write(h); write(" ");
+    write(clamp(-0.0, -1.0, 2.0)); write(" "); write(h); write(" ");
+    write(clamp(-7.0, -1.0, 2.0)); write(" "); write(h); write("\n");
+
+    t = 5; f = 0.5;
+    if(f) t = 2.75 + f; else t = 0;
+    if(t == 3) f = t; 
+    if(!t) t = 9; else { t = -t; }
+    write(t); write(" "); write(f); write("\n");
+    return 0;
+}
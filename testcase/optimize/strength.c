@@ -0,0 +1,31 @@
+int m[6][10];
+
+int digits(int n){
+    int c;
+    c = 0;
+    while(n != 0){
+        n = n / 10;
+        c = c + 1;
+    }
+    return c;
+}
+
+int main(){
+    int i, j, s, t;
+
+    s = 0;
+    for(i = 0 - 20; i <= 20; i = i + 3){
+        t = i * 7 + i * 40 - i * 15 + 9 * i;
+        s = s + t / 4 + t / 3 + i / 2 - t / 7 + t / (0 - 16) + t / 1;
+    }
+    write(s); write(" "); write(digits(2147483647)); write(" "); write(digits(0 - 12345)); write("\n");
+
+    for(i = 0; i < 6; i = i + 1)
+        for(j = 0; j < 10; j = j + 1)
+            m[i][j] = i * 100 + j * 1000 / 9;
+    s = 0;
+    for(i = 0; i < 6; i = i + 1)
+        s = s + m[i][i * 3 / 2] - m[5 - i][9 - i] / 5;
+    write(s); write(" "); write(m[5][9] * 0); write(" "); write(m[3][7] * (0 - 1)); write("\n");
+    return 0;
+}
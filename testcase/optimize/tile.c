@@ -0,0 +1,52 @@
+int v[8];
+
+int classify(int x){
+    int c;
+    c = 0;
+    if(x < 0) c = c + 1;
+    if(x >= 0) c = c + 2;
+    if(x > 0) c = c + 4;
+    if(x <= 0) c = c + 8;
+    if(x == 0) c = c + 16;
+    if(x != 0) c = c + 32;
+    if(!x) c = c + 64;
+    if(x < 7) c = c + 128;
+    if(x > 32767) c = c + 256;
+    if(x <= -3) c = c + 512;
+    if(3 < x) c = c + 1024;
+    return c;
+}
+
+int relate(int a, int b){
+    return (a == b) + (a != b) * 2 + (a < b) * 4 + (a > b) * 8 + (a <= b) * 16 + (a >= b) * 32 +
+      (a == 5) * 64 + (a != 70000) * 128 + (a <= 32767) * 256 + (a > -1) * 512 + (0 < a) * 1024;
+}
+
+int frelate(float p, float q){
+    int c;
+    c = (p == q) + (p != q) * 2 + (p < q) * 4 + (p > q) * 8 + (p <= q) * 16 + (p >= q) * 32;
+    if(p < q) c = c + 64;
+    if(p >= q) c = c + 128;
+    if(p != q) c = c + 256;
+    if(p == q || p > q) c = c + 512;
+    return c;
+}
+
+int main(){
+    int i, n;
+    write(classify(-5)); write(" "); write(classify(0)); write(" "); write(classify(9)); write(" ");
+    write(classify(40000)); write("\n");
+    write(relate(5, 5)); write(" "); write(relate(-2, 7)); write(" "); write(relate(70000, 3)); write("\n");
+    write(frelate(1.5, 1.5)); write(" "); write(frelate(-1.0, 2.0)); write(" "); write(frelate(3.0, -2.0));
+    write("\n");
+    n = 0;
+    for(i = 0; i < 8; i = i + 1){
+        v[i] = i - 3;
+        while(v[i] > 0 && !(v[i] == 2))
+            v[i] = v[i] - 2;
+        if(v[i] < 0 || v[i] == 1)
+            n = n + 1;
+    }
+    write(n); write(" "); write(v[7]); write(" "); write(-v[1]); write("\n");
+    return 0;
+}
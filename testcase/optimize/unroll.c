@@ -0,0 +1,64 @@
+int g[40];
+
+int dot(int a[], int b[], int n){
+    int i, s;
+    s = 0;
+    for(i = 0; i < n; i = i + 1)
+        s = s + a[i] * b[i];
+    return s;
+}
+
+int find(int a[], int n, int key){
+    int i;
+    for(i = 0; i <= n; i = i + 1){
+        if(a[i] == key)
+            return i;
+    }
+    return -1;
+}
+
+float poly(float x){
+    int i;
+    float r;
+    r = 0.0;
+    for(i = 0; i < 5; i = i + 1)
+        r = r * x + 1.5;
+    return r;
+}
+
+int main(){
+    int i, j, n, s, b[40];
+
+    for(i = 0; i < 40; i = i + 1){
+        g[i] = i * 3 - 7;
+        b[i] = 40 - i;
+    }
+    write(dot(g, b, 40)); write(" "); write(dot(g, b, 7)); write(" ");
+    write(dot(g, b, 0)); write(" "); write(dot(g, b, -5)); write("\n");
+
+    s = 0;
+    for(i = 2; i < 37; i = i + 3){
+        s = s + g[i];
+        {
+            int t;
+            t = b[i] - 1;
+            s = s - t;
+        }
+    }
+    write(s); write(" "); write(i); write("\n");
+
+    n = 11;
+    s = 0;
+    for(i = 1; i <= n; i = i + 2)
+        s = s * 2 + i;
+    write(s); write(" "); write(i); write("\n");
+
+    write(find(g, 39, 50)); write(" "); write(find(g, 2, 50)); write(" "); write(find(g, 39, 51)); write("\n");
+    write(poly(2.0)); write("\n");
+
+    j = 0;
+    for(i = 0; i < 3; i = i + 1)
+        j = j + i;
+    write(j); write(" "); write(i); write("\n");
+    return 0;
+}
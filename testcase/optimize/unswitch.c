@@ -0,0 +1,72 @@
+int gm;
+int a[40];
+float f[40];
+
+int scan(int n, int mode){
+    int i, s;
+    s = 0;
+    for(i = 0; i < n; i = i + 1){
+        if(mode == 1)
+            s = s + a[i];
+        else if(mode == 2)
+            s = s + a[i] * a[i];
+        else
+            s = s - a[i];
+    }
+    return s;
+}
+
+void scale(float k, int flip){
+    int i;
+    i = 0;
+    while(i < 40){
+        if(flip){
+            float t;
+            t = f[i];
+            f[i] = k - t;
+        }
+        else{
+            int d;
+            d = i / 2;
+            f[i] = f[i] * k + d;
+        }
+        i = i + 1;
+    }
+}
+
+int main(){
+    int i, j, s, lim;
+
+    for(i = 0; i < 40; i = i + 1){
+        a[i] = i - 7;
+        f[i] = i;
+    }
+    write(scan(40, 1)); write(" "); write(scan(40, 2)); write(" "); write(scan(20, 0)); write("\n");
+
+    scale(2.0, 0);
+    scale(100.0, 1);
+    write(f[0]); write(" "); write(f[39]); write("\n");
+
+    gm = 3;
+    s = 0;
+    lim = 5;
+    for(i = 0; i < 10; i = i + 1){
+        for(j = 0; j < 10; j = j + 1){
+            if(gm > 2 && j < lim)
+                s = s + i * j;
+            else
+                s = s - 1;
+        }
+    }
+    write(s); write(" "); write(i); write(" "); write(j); write("\n");
+
+    gm = 0;
+    i = 0;
+    while(i < 12){
+        if(!gm)
+            a[i] = 0;
+        i = i + 1;
+    }
+    write(scan(14, 1)); write("\n");
+    return 0;
+}
@@ -0,0 +1,57 @@
+int g, garr[8];
+float gf;
+
+int next(){
+    g = g + 1;
+    return g;
+}
+
+void scale(float w[], int n){
+    int i;
+    for(i = 0; i < n; i = i + 1)
+        w[i] = w[i] * w[i] + w[i];
+}
+
+int sum(int a[][4], int i, int j){
+    a[i][j] = a[i][j] + 1;
+    a[i][j] = a[i][j] * a[i][j];
+    return a[i][j] + a[i][0] + a[1][j];
+}
+
+int main(){
+    int a[4][4], i, j, x, y;
+    float w[4], f;
+
+    for(i = 0; i < 4; i = i + 1)
+        for(j = 0; j < 4; j = j + 1)
+            a[i][j] = i * 4 + j;
+
+    i = 2;
+    j = 3;
+    a[i][j] = a[i][j] + a[i][j];
+    x = a[i][j] * a[i][j] - a[i][0];
+    a[i][0] = 7;
+    y = a[i][j] + a[i][0];
+    write(x); write(" "); write(y); write("\n");
+
+    j = 1;
+    x = a[i][j] + a[i][j];
+    write(x); write(" "); write(sum(a, 3, 2)); write(" "); write(a[3][2]); write("\n");
+
+    g = 5;
+    garr[3] = 4;
+    x = g * g + garr[3] * garr[3];
+    y = next() + g + garr[g - 3];
+    x = x + g * garr[3];
+    write(x); write(" "); write(y); write("\n");
+
+    f = 1.5;
+    gf = f * f;
+    w[0] = gf + f;
+    w[1] = w[0] * gf;
+    w[2] = w[1] - w[0];
+    w[3] = f;
+    scale(w, 4);
+    write(w[0] + w[1] + w[2] + w[3]); write(" "); write(gf * f); write("\n");
+    return 0;
+}
@@ -0,0 +1,20 @@
+int count;
+int next(){
+    write("[next]");
+    count = count + 1;
+    return count;
+}
+int main(){
+    int i;
+    float x;
+    count = 0;
+    x = 0.5;
+    write("report"); write(":"); write(" "); write(3); write(" rows, "); write(-2); write(" cols, ");
+    write(1.5); write("\n");
+    for(i = 0; i < 4; i = i + 1){
+        write("row "); write(i); write(": "); write(i * i); write(" | "); write(x * i); write("\n");
+    }
+    write("a"); write(next()); write("b"); write(next()); write("\n");
+    write(-2147483647 - 1); write(" "); write(2147483647); write("\n");
+    return 0;
+}